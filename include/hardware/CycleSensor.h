@@ -0,0 +1,49 @@
+#ifndef CYCLE_SENSOR_H
+#define CYCLE_SENSOR_H
+
+#include <Arduino.h>
+
+//* ************************************************************************
+//* ************************* PNP CYCLE SENSOR *****************************
+//* ************************************************************************
+// The PnP cycle sensor (active LOW IR) is read by a GPIO interrupt instead of
+// being polled from loop(). The ISR timestamps every edge with micros() and
+// debounces on those timestamps: the first edge that changes the level is
+// accepted immediately, further edges are ignored for
+// PNP_CYCLE_SENSOR_DEBOUNCE_MS. A level left changed by a bounce inside that
+// window is picked up on the next read once the window has passed.
+//
+// An accepted edge also wakes the loop task (see EventLoop.h), so a part
+// arrival is handled without waiting out an idle sleep.
+
+/**
+ * @brief Configures the sensor pin and attaches the edge interrupt.
+ * Call once during setup.
+ */
+void initializeCycleSensor();
+
+/**
+ * @brief Debounced sensor state.
+ * @return true while a part is present (pin LOW).
+ */
+bool cycleSensorActive();
+
+/**
+ * @brief Consumes a part arrival (debounced falling edge) seen since the last call.
+ * @return true if at least one arrival occurred.
+ */
+bool cycleSensorConsumeArrival();
+
+/**
+ * @brief micros() timestamp of the most recent arrival, 0 if none yet.
+ */
+unsigned long cycleSensorLastArrivalUs();
+
+/**
+ * @brief Number of arrivals so far (wraps), and the time of the last one read
+ * together with it. Tells whether that timestamp is newer than a count taken
+ * earlier.
+ */
+uint32_t cycleSensorArrivalCount(unsigned long* lastArrivalUs = nullptr);
+
+#endif // CYCLE_SENSOR_H
@@ -0,0 +1,58 @@
+#ifndef INPUT_SAMPLER_H
+#define INPUT_SAMPLER_H
+
+#include <Arduino.h>
+
+//* ************************************************************************
+//* ************************** INPUT SAMPLER *******************************
+//* ************************************************************************
+// The home switches are sampled by a periodic esp_timer every
+// INPUT_SAMPLE_PERIOD_US, all from one snapshot of the GPIO input registers,
+// so their state no longer depends on who polls them or how often. Each
+// input is debounced with an integrator: it counts up while the raw level is
+// active and down while it is not, and the debounced state only flips when
+// the count reaches either end. A changed state is published with the
+// micros() time of the first sample of the change and wakes the loop task.
+//
+// Latency is bounded by the integrator length (HOMING_SWITCH_DEBOUNCE_MS)
+// plus one sample period. The PnP cycle sensor keeps its own edge interrupt
+// (CycleSensor.h), which accepts a part without waiting out a debounce.
+
+enum InputId : uint8_t {
+    INPUT_X_HOME = 0,
+    INPUT_Y_LEFT_HOME,
+    INPUT_Y_RIGHT_HOME,
+    INPUT_Z_HOME,
+    INPUT_COUNT
+};
+
+/**
+ * @brief Starts sampling. Call once during setup, after the pins are configured.
+ */
+void initializeInputSampler();
+
+// Debounced state: true while the switch is triggered
+bool inputActive(InputId id);
+
+/**
+ * @brief micros() time at which the last debounced change began, 0 if none yet.
+ */
+unsigned long inputLastEdgeUs(InputId id);
+
+// Debounced changes (both directions) since startup
+uint32_t inputEdgeCount(InputId id);
+
+// Edge latch for homing: while armed, a GPIO interrupt on the input's pin
+// records the micros() time of the first edge to the active level and wakes
+// the loop task. The edge is raw (not debounced); confirm it with
+// inputActive() before trusting it.
+void inputArmEdgeLatch(InputId id);
+void inputDisarmEdgeLatch(InputId id);
+
+/**
+ * @brief Reads the latch.
+ * @return true once an edge has been latched since arming, with its time in 'edgeUs'.
+ */
+bool inputEdgeLatched(InputId id, unsigned long& edgeUs);
+
+#endif // INPUT_SAMPLER_H
@@ -2,12 +2,11 @@
 #define HOMING_H
 
 #include <Arduino.h>
-#include <Bounce2.h>
 #include <FastAccelStepper.h>
 #include "utils/settings.h"
 #include "system/machine_state.h"
 #include "motors/Rotation_Motor.h" // Include Rotation_Motor for rotationStepper access
-#include "settings/debounce_settings.h" // Added for centralized debounce intervals
+#include "hardware/InputSampler.h" // Debounced home switches
 
 class Homing {
 public:
@@ -27,14 +26,10 @@ private:
     FastAccelStepper* _stepperZ;
     // Note: rotationStepper is accessed via the extern declaration from Rotation_Motor.h
 
-    Bounce _xHomeSwitch;
-    Bounce _yLeftHomeSwitch;
-    Bounce _yRightHomeSwitch;
-    Bounce _zHomeSwitch;
-
     bool _isHoming = false; // Internal homing state flag
 
     long inchesToStepsXYZ(float inches); // Keep utility function private or move elsewhere if shared
+    bool seekSwitch(FastAccelStepper* stepper, InputId input, bool forward, unsigned long& latchedAtMs);
 };
 
 #endif // HOMING_H 
\ No newline at end of file
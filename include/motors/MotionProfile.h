@@ -0,0 +1,30 @@
+#ifndef MOTION_PROFILE_H
+#define MOTION_PROFILE_H
+
+#include <Arduino.h>
+
+//* ************************************************************************
+//* ************************* MOTION PROFILE *******************************
+//* ************************************************************************
+// Trapezoidal move model matching FastAccelStepper's symmetric ramps
+// (accelerate at 'accel' to 'maxSpeed', cruise, decelerate at 'accel').
+// Used to work out when an actuator may safely run while an axis is still
+// moving, e.g. how long the first or last N steps of a move take.
+// Units: steps, steps/s, steps/s^2, seconds.
+
+struct MotionProfile {
+    float distance;         // Absolute move length
+    float peakSpeed;        // maxSpeed, or lower for a triangular move
+    float accel;
+    float rampTime;         // Duration of each ramp (accel or decel)
+    float rampDistance;     // Distance covered by each ramp
+    float totalTime;
+};
+
+MotionProfile computeTrapezoid(long distanceSteps, float maxSpeed, float accel);
+
+// Time the profile needs to cover its first 'steps' (by symmetry also the
+// duration of its last 'steps'). Clamped to the total move time.
+float profileTimeForEdgeDistance(const MotionProfile& profile, float steps);
+
+#endif // MOTION_PROFILE_H
@@ -13,5 +13,6 @@ void paintAllSides();
 // Global variable to control the number of coats for paintAllSides
 extern int g_requestedCoats;
 extern int g_interCoatDelaySeconds;
+extern bool g_requestedTrayJob; // Paint the occupied tray cells instead of the fixtures
 
 #endif // PAINTING_SIDES_H 
\ No newline at end of file
@@ -7,7 +7,7 @@
 
 // Declare functions defined in XYZ_Movements.cpp
 void moveToXYZ(long x, unsigned int xSpeed, long y, unsigned int ySpeed, long z, unsigned int zSpeed);
-void checkMotors(); // Function to update debouncers and check limit switches
+void checkMotors(); // Function to check limit switches
 
 // New function that checks for home command - returns true if completed, false if aborted
 bool moveToXYZ_HomeCheck(long x, unsigned int xSpeed, long y, unsigned int ySpeed, long z, unsigned int zSpeed);
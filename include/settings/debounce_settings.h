@@ -5,7 +5,10 @@
 const unsigned long GENERAL_DEBOUNCE_MS = 10;
 
 // Specific debounce interval for homing switches
-const unsigned long HOMING_SWITCH_DEBOUNCE_MS = 20; // Was 3ms, then 20ms, keeping 20ms
+const unsigned long HOMING_SWITCH_DEBOUNCE_MS = 20; // Was 3ms, then 20ms, keeping 20ms. Integrator length of the input sampler
+
+// Sample period of the timer driven input sampler (home switches)
+const unsigned long INPUT_SAMPLE_PERIOD_US = 1000;
 
 // Specific debounce interval for the PNP Cycle Sensor
 const unsigned long PNP_CYCLE_SENSOR_DEBOUNCE_MS = 40;
@@ -21,5 +21,7 @@
 // --- Homing Misc ---
 #define HOMING_MOVE_AWAY_INCHES 0.2f             // Distance to move away from home switch (inches)
 #define HOMING_TIMEOUT_MS 15000                  // Homing timeout (ms)
+#define HOMING_LATCH_CONFIRM_MS 100              // Debounced switch must confirm a latched edge within this (ms)
+#define HOMING_SUPERVISOR_BUDGET_MS 25000        // Whole homing sequence: seek timeout, 5 s move-away timeout, settling
 
 #endif // SETTINGS_HOMING_H 
\ No newline at end of file
@@ -36,12 +36,18 @@
 #define DEFAULT_Z_ACCEL 13000          // Default Z axis acceleration
 #define DEFAULT_ROT_ACCEL 3000         // Default rotation axis acceleration
 
-// --- PNP Speeds ---
+// --- PNP Speeds (unloaded: empty moves to and around the pick location) ---
 #define DEFAULT_PNP_X_SPEED 20000     // Default PNP X axis speed
 #define DEFAULT_PNP_Y_SPEED 30000     // Default PNP Y axis speed
 
-// --- PNP Accelerations ---
+// --- PNP Accelerations (unloaded) ---
 #define DEFAULT_PNP_X_ACCEL 20000      // Default PNP X axis acceleration
 #define DEFAULT_PNP_Y_ACCEL 30000      // Default PNP Y axis acceleration
 
+// --- PNP Loaded Profile (part on the vacuum cup, pick to place) ---
+#define DEFAULT_PNP_LOADED_X_SPEED 20000   // Default loaded X axis speed
+#define DEFAULT_PNP_LOADED_Y_SPEED 30000   // Default loaded Y axis speed (halved for the final placement)
+#define DEFAULT_PNP_LOADED_X_ACCEL 20000   // Default loaded X axis acceleration
+#define DEFAULT_PNP_LOADED_Y_ACCEL 30000   // Default loaded Y axis acceleration
+
 #endif // SETTINGS_MOTION_H 
\ No newline at end of file
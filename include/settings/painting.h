@@ -71,4 +71,13 @@
 // Delay Between Coats
 #define DEFAULT_COAT_DELAY_MS 10000 // Milliseconds (e.g., 30 seconds)
 
+// --- Inter-coat Dry Window ---
+#define DRY_WINDOW_MARGIN_MS 1000               // Time kept free at the end of the window (ms)
+#define DRY_WINDOW_REPORT_INTERVAL_MS 1000      // Dashboard progress update interval (ms)
+#define DRY_TASK_CLEAN_ESTIMATE_MS 8000         // Initial estimate for the gun clean task (ms)
+#define DRY_TASK_DRIFT_ESTIMATE_MS 6000         // Initial estimate for the drift check task (ms)
+#define DRIFT_CHECK_SPEED 500                   // Creep speed toward the home switches (steps/sec)
+#define DRIFT_CHECK_OVERTRAVEL_INCHES 0.1f      // Extra travel past the expected switch point (inches)
+#define DRIFT_CHECK_REHOME_STEPS 200            // Larger drift is reported with a rehome recommendation (steps)
+
 #endif // SETTINGS_PAINTING_H 
\ No newline at end of file
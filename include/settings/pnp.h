@@ -33,6 +33,14 @@
 #define PNP_PLACE_DELAY_AFTER_VACUUM_OFF 100      // Delay after disengaging vacuum at place loc
 #define PNP_PLACE_DELAY_AFTER_CYLINDER_RETRACT 150// Delay after retracting cylinder at place loc (before next move)
 
+// --- Actuation / Travel Overlap ---
+// Actuators may run while the gantry is still in the slow end of a move. The
+// lead times are derived from the move profile so that the gantry moves at
+// most the given distance while the cylinder is not fully up.
+#define PNP_OVERLAP_ENABLED true                  // Overlap cylinder actuation with travel
+#define PNP_PICK_RETRACT_OVERLAP_INCHES 0.05f     // Travel allowed while the cylinder finishes retracting at pick
+#define PNP_PLACE_EXTEND_OVERLAP_INCHES 0.05f     // Travel left when the cylinder starts extending at place
+
 // Timeout between allowed cycle switch presses
 #define CYCLE_TIMEOUT 5 // milliseconds
 
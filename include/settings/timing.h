@@ -6,4 +6,50 @@
 // ==========================================================================
 #define DEBOUNCE_INTERVAL 5                    // Debounce interval for inputs (ms)
 
+// ==========================================================================
+//                               TASKS
+// ==========================================================================
+// Motion and the state machine run in the Arduino loop task on core 1;
+// WiFi, HTTP, WebSocket and OTA run in the network task on core 0 (with the
+// WiFi stack). The two exchange messages through the web queues and read
+// machine state only from the telemetry snapshot.
+#define MOTION_TASK_PRIORITY 3                 // Raised priority of the loop task (core 1)
+#define NETWORK_TASK_CORE 0                    // Core of the network task
+#define NETWORK_TASK_PRIORITY 2                // Network task priority
+#define NETWORK_TASK_STACK_SIZE 8192           // Network task stack (bytes)
+#define NETWORK_TASK_PERIOD_MS 2               // Network task poll period (ms)
+#define WEB_COMMAND_QUEUE_LENGTH 16            // Incoming commands waiting for the motion task (power of two)
+#define WEB_COMMAND_MAX_LENGTH 512             // Longest accepted command text (bytes)
+#define TELEMETRY_PERIOD_MS 50                 // Telemetry snapshot publish period
+#define TELEMETRY_BROADCAST_MS 250             // Telemetry sent to dashboard clients
+#define WEB_OUTBOUND_QUEUE_LENGTH 32           // Outgoing messages waiting for the network task
+#define WEB_RESTART_LINGER_MS 50               // Network task lets the last sends out before a RESTART
+#define EVENT_LOOP_MAX_SLEEP_MS 100            // Longest the loop task sleeps without an event
+#define EVENT_LOOP_MOTION_POLL_MS 1            // Poll period while an axis moves (no move-complete event)
+#define STATE_TRANSITION_QUEUE_LENGTH 8        // State transitions waiting for the state machine
+
+// ==========================================================================
+//                              SUPERVISOR
+// ==========================================================================
+#define SUPERVISOR_LOOP_BUDGET_MS 20           // Loop pass (excluding its sleep) longer than this is an overrun
+#define SUPERVISOR_HISTOGRAM_BUCKETS 12        // Loop pass histogram: <1, <2, <4 ... ms, last bucket open-ended
+#define SUPERVISOR_SEGMENT_DEPTH 4             // Nested motion segments tracked (homing -> rotation)
+#define SUPERVISOR_MOVE_BUDGET_FACTOR 2        // Move budget: factor x cruise time of the longest axis...
+#define SUPERVISOR_MOVE_MARGIN_MS 2000         // ...plus this for ramps and switch checks
+#define SUPERVISOR_STALL_MS 5000               // No progress (or a segment this far past budget) is a stall
+#define SUPERVISOR_WDT_TIMEOUT_S 5             // Task watchdog timeout; the network task feeds it
+#define ROTATION_MOVE_TIMEOUT_MS 15000         // Longest a single rotation may take before it is force stopped
+
+// ==========================================================================
+//                               LOGGING
+// ==========================================================================
+#define LOG_RING_LENGTH 128                    // Log records buffered per core (power of two)
+#define LOG_LINE_LENGTH 160                    // Longest formatted log line (chars)
+#define LOG_TASK_CORE 0                        // Log task formats and writes records on this core
+#define LOG_TASK_PRIORITY 1                    // Below the network task
+#define LOG_TASK_STACK_SIZE 4096               // Log task stack (bytes)
+#define LOG_DRAIN_PERIOD_MS 10                 // Log task poll period (ms)
+#define LOG_DEFAULT_SERIAL_LEVEL LOG_LEVEL_INFO // Serial verbosity at boot
+#define LOG_DEFAULT_WEB_LEVEL LOG_LEVEL_OFF    // Dashboard verbosity at boot
+
 #endif // SETTINGS_TIMING_H 
\ No newline at end of file
@@ -19,4 +19,8 @@ private:
     bool shortMode; // Added for short cleaning cycle
 };
 
+// Blocking gun clean cycle (pressurize, burst at the clean station, return to 0,0,0).
+// Returns false if abortOnHome is set and a HOME command interrupted it.
+bool runCleaningCycle(bool shortMode, bool abortOnHome);
+
 #endif // CLEANING_STATE_H 
\ No newline at end of file
@@ -2,8 +2,8 @@
 #define IDLE_STATE_H
 
 #include "State.h"
-// #include <Bounce2.h> // No longer needed here, moved to GlobalDebouncers.h
-#include "hardware/GlobalDebouncers.h" // Include for g_pnpCycleSensorDebouncer
+// #include <Bounce2.h> // No longer needed here
+#include "hardware/CycleSensor.h" // For the interrupt driven PnP cycle sensor
 
 // Machine state constants
 #define MACHINE_IDLE 0
@@ -17,7 +17,7 @@ public:
     const char* getName() const override;
 
 private:
-    // Bounce pnpCycleSwitch; // REMOVED: Now using global g_pnpCycleSensorDebouncer
+    // Bounce pnpCycleSwitch; // REMOVED: Now using the interrupt driven cycle sensor
 };
 
 #endif // IDLE_STATE_H 
\ No newline at end of file
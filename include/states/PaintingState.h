@@ -11,6 +11,9 @@ public:
     void exit() override;
     const char* getName() const override;
 
+    // Continue a paused All Sides job on the next enter()
+    void resumePaintJob();
+
 private:
     enum PaintingSubStep {
         PS_IDLE,
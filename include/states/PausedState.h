@@ -10,6 +10,19 @@ public:
     void update() override;
     void exit() override;
     const char* getName() const override;
+
+    // Called by the RESUME command; the resume itself runs in update()
+    void requestResume();
+
+private:
+    enum PausedSubStep {
+        PAUSED_WAITING,
+        PAUSED_PRESSURIZING,
+        PAUSED_RESUMING
+    };
+    PausedSubStep currentStep;
+    bool resumeRequested;
+    unsigned long pressurizeStartTime;
 };
 
-#endif // PAUSED_STATE_H 
\ No newline at end of file
+#endif // PAUSED_STATE_H 
@@ -1,11 +1,13 @@
 #pragma once
 
-// #include <Bounce2.h> // No longer needed here, moved to GlobalDebouncers.h
+// #include <Bounce2.h> // No longer needed here
 #include <FastAccelStepper.h>
 #include "states/State.h" // Assuming a base State class exists
 #include "utils/settings.h" // For grid dimensions, pins etc.
 #include "motors/ServoMotor.h" // Added include for ServoMotor
-#include "hardware/GlobalDebouncers.h" // Include for g_pnpCycleSensorDebouncer
+#include "hardware/CycleSensor.h" // Interrupt timestamped cycle sensor
+#include "storage/TrayLayouts.h" // For the active tray layout
+#include "system/PnPStats.h" // Per-phase cycle timing
 
 // Assuming StateMachine is needed for transitions
 class StateMachine; 
@@ -26,18 +28,20 @@ public:
     // void moveToTarget(PnPAction action); // REMOVED - Not implemented/used and PnPAction undefined
 
 private:
-    // Grid configuration
-    float gridPositionsX[GRID_ROWS * GRID_COLS];
-    float gridPositionsY[GRID_ROWS * GRID_COLS];
+    // Placement sequence: cells of the active tray layout (see TrayLayouts.h)
+    int placementOrder[MAX_TRAY_CELLS];
+    int placementCount;
 
     // Position tracking
-    int currentPnPGridPosition;
+    int currentPlacement;             // Index into placementOrder
+    int currentPnPGridPosition;       // Cell being placed (placementOrder[currentPlacement])
+    uint32_t placedCells;             // Cells filled this run, saved as tray occupancy on exit
     bool pnpCycleIsComplete;
     long pickLocationX_steps; // Pick location X in steps
     long pickLocationY_steps; // Pick location Y in steps
 
     // Cycle sensor (direct read)
-    // Bounce pnpCycleSensorDebouncer; // REMOVED: Now using global g_pnpCycleSensorDebouncer
+    // Bounce pnpCycleSensorDebouncer; // REMOVED: Now using the interrupt driven cycle sensor
     
     // Cycle timeout
     unsigned long lastCycleTime;  // Timestamp of the last cycle completion
@@ -47,19 +51,58 @@ private:
     // Simplified state tracking within PnPState
     // 0: Moving to initial pick location
     // 1: Waiting at Pick Location
-    // 2: Processing a PnP cycle (blocking Pick->Move->Place)
+    // 2: Processing a PnP cycle (Pick->Move->Place, sub-steps below)
     // 3: Moving back to Pick Location (non-blocking)
     // 4: PnP Complete, ready for homing/exit transition
     int pnp_step; 
 
+    // Sub-steps of one cycle (pnp_step 2). Each is advanced from update()
+    // by a millis() deadline or a move-complete check, never by delay().
+    enum PnPCycleStep {
+        CYCLE_VERIFY_PICK,      // Moving onto the pick location
+        CYCLE_PICK_EXTEND,      // Cylinder down at pick
+        CYCLE_PICK_VACUUM,      // Vacuum on, gripping
+        CYCLE_PICK_RETRACT,     // Cylinder up with the part
+        CYCLE_TRAVEL,           // Moving to the place location
+        CYCLE_PLACE_EXTEND,     // Cylinder down at place
+        CYCLE_PLACE_RELEASE,    // Vacuum off, releasing
+        CYCLE_PLACE_RETRACT,    // Cylinder up, cycle done when it expires
+        CYCLE_DONE
+    };
+    PnPCycleStep cycleStep;
+    unsigned long cycleStepDeadline;  // millis() at which the current timed sub-step ends
+
+    // Place move of the current cycle and its actuation overlap
+    long placeX_steps;
+    long placeY_steps;
+    float placeYSpeed;
+    unsigned long travelStartMs;
+    unsigned long pickRetractOverlapMs; // Part of the pick retract delay spent travelling
+    unsigned long placeExtendLeadMs;  // Cylinder starts extending this long before arrival
+    unsigned long travelDurationMs;   // Predicted by the move profile
+    unsigned long placeExtendStartMs; // 0 until the cylinder was started during travel
+
+    unsigned long lastArrivalToPickUs; // Sensor edge to cycle start, last cycle
+    unsigned long phaseStartUs;       // micros() at which the current PnP phase began
+    bool nextPartArmed;               // A part arrived during the return move
+    uint32_t pickArrivalCount;        // Sensor arrival count at the previous pick
+
     // Flag to signal that homing is needed after PnP completion
     bool homingNeededAfterPnP; 
 
     // Private helper methods
-    void calculateGridPositions();
+    void buildPlacementOrder();            // Placement cells in the planned order, report the plan
     void initializeHardware();
+    void recordArrivalToPickLatency();     // Uses the sensor's ISR timestamp
+    void endPhase(PnPPhase phase);         // Record the phase, the next one starts now
+    bool tryStartNextCycle();              // Start a cycle if a part is waiting
     void moveToPickLocation(bool initialMove = false); // Moves to pick location (non-blocking)
-    void process_single_pnp_cycle(); 
+    bool startPnpCycle();                  // Begin a cycle for currentPnPGridPosition
+    bool updatePnpCycle();                 // Advance the cycle, true once it is done
+    void startMoveTo(long x, float xSpeed, float xAccel, long y, float ySpeed, float yAccel); // Non-blocking XY move, Z to 0
+    bool axesIdle();
+    void startTimedStep(PnPCycleStep step, unsigned long durationMs);
+    void planPlaceMove();                  // Place target, speed and overlap lead times
     void resetStateAndReturnToIdle(); // Reset state and return to idle
 
     // Stepper references (assuming they are globally accessible or passed somehow)
@@ -39,6 +39,10 @@ public:
     void saveBool(const char* key, bool value);
     bool loadBool(const char* key, bool defaultValue);
     
+    // Fixed-size binary records (returns bytes read, 0 if missing or size differs)
+    void saveBytes(const char* key, const void* data, size_t length);
+    size_t loadBytes(const char* key, void* buffer, size_t length);
+    
     // Clear all settings
     void clearAll();
     
@@ -0,0 +1,66 @@
+#ifndef PROGRESS_JOURNAL_H
+#define PROGRESS_JOURNAL_H
+
+#include <Arduino.h>
+
+//* ************************************************************************
+//* ************************ PROGRESS JOURNAL ******************************
+//* ************************************************************************
+// Compact record of where the current All Sides job is, so a job interrupted
+// by a reset (brownout, watchdog, OTA) can be resumed from the last pass.
+//
+// - Every pass boundary updates a copy in RTC memory (survives soft resets,
+//   costs a struct copy and a CRC, no flash access).
+// - Side boundaries and pauses also write the record to a small ring of NVS
+//   keys. Rotating keys means a write torn by power loss leaves the previous
+//   slot intact; the newest slot with a valid CRC wins on boot.
+
+struct JournalRecord {
+    uint32_t magic;
+    uint32_t sequence;              // Increases on every write (RTC or NVS); orders records only
+    uint32_t jobId;
+    uint16_t interCoatDelaySeconds;
+    uint8_t active;                 // 1 while the job is unfinished
+    uint8_t totalCoats;
+    uint8_t coat;                   // 1-based
+    uint8_t side;                   // Side number (1-4)
+    uint8_t pass;                   // First pass of 'side' not yet painted
+    uint8_t fixture;                // 0-based fixture index (tray cell in tray jobs)
+    uint8_t mode;                   // PaintJobMode (see PaintProgress.h)
+    uint8_t flushCount;             // NVS writes so far (wraps); selects the next NVS slot
+    uint8_t reserved[2];
+    uint32_t crc;                   // CRC32 over all fields above
+};
+
+const int JOURNAL_NVS_SLOTS = 4;
+
+class ProgressJournal {
+public:
+    // Recover the newest valid record from RTC memory or NVS (call after NVS is usable)
+    void begin();
+
+    // Job lifecycle
+    void startJob(int totalCoats, int interCoatDelaySeconds, int mode);
+    void continueJob(const JournalRecord& record);   // Resume an interrupted job under its old id
+    void recordProgress(int coat, int fixture, int side, int pass, bool flushToFlash);
+    void finishJob();
+
+    // Job left unfinished by the previous boot
+    bool hasResumableJob() const { return resumable; }
+    const JournalRecord& resumableJob() const { return pending; }
+    void discardResumableJob();
+
+private:
+    JournalRecord current = {};
+    JournalRecord pending = {};
+    bool resumable = false;
+
+    void write(bool flushToFlash);
+    static uint32_t computeCrc(const JournalRecord& record);
+    static bool isValid(const JournalRecord& record);
+};
+
+// Global journal instance
+extern ProgressJournal progressJournal;
+
+#endif // PROGRESS_JOURNAL_H
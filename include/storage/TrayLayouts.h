@@ -0,0 +1,89 @@
+#ifndef TRAY_LAYOUTS_H
+#define TRAY_LAYOUTS_H
+
+#include <Arduino.h>
+
+//* ************************************************************************
+//* ************************** TRAY LAYOUTS ********************************
+//* ************************************************************************
+// Named tray layouts for pick and place, stored in NVS so a product
+// changeover is a dashboard selection instead of a reflash.
+//
+// A layout is a grid (cols x rows, origin, pitch) plus a placement bitmap
+// saying which cells receive a part. Cells are numbered row-major from the
+// origin (top-right corner); columns run toward -X, rows toward -Y. When a
+// layout is selected its cell coordinates are converted to steps once, so
+// the PnP cycle only does table lookups.
+//
+// Slot 0 defaults to the original 4x5 grid with every other cell used.
+//
+// The cells filled by the last PnP run are kept (occupancy) so a tray paint
+// job can paint exactly those parts. The paint offset places cell 0 relative
+// to fixture 1, the position the side patterns were taught on.
+
+const int MAX_TRAY_LAYOUTS = 4;
+const int MAX_TRAY_CELLS = 32;          // One bit per cell in the placement bitmap
+const int TRAY_LAYOUT_NAME_LEN = 16;
+
+struct TrayLayout {
+    char name[TRAY_LAYOUT_NAME_LEN];
+    uint8_t cols;
+    uint8_t rows;
+    uint8_t reserved[2];
+    float originX;                      // Cell 0 position (inches)
+    float originY;
+    float pitchX;                       // Distance between columns (inches)
+    float pitchY;                       // Distance between rows (inches)
+    uint32_t placementMask;             // Bit i set: place a part in cell i
+};
+
+class TrayLayouts {
+public:
+    // Load stored layouts and the active selection (call after NVS is usable)
+    void begin();
+
+    bool isDefined(int index) const;
+    const TrayLayout& layout(int index) const;
+    bool saveLayout(int index, const TrayLayout& layout);   // Validates, persists, rebuilds if active
+    bool select(int index);                                 // Persists the selection
+    int activeIndex() const { return activeLayout; }
+    const TrayLayout& active() const { return layouts[activeLayout]; }
+
+    // Step table of the active layout
+    int cellCount() const;
+    bool isPlacementCell(int cell) const;
+    int placementCount() const;
+    long cellXSteps(int cell) const { return stepX[cell]; }
+    long cellYSteps(int cell) const { return stepY[cell]; }
+
+    // Cells holding a part after the last PnP run (active layout only)
+    void setOccupiedCells(uint32_t mask);   // Persists
+    uint32_t occupiedCells() const { return occupiedMask; }
+    int occupiedCount() const;
+
+    // Painting offset of a cell from fixture 1 (steps)
+    void setPaintOffset(float offsetX, float offsetY);   // Inches, persists
+    float paintOffsetX() const { return paintOffsetXInches; }
+    float paintOffsetY() const { return paintOffsetYInches; }
+    long cellPaintOffsetXSteps(int cell) const;
+    long cellPaintOffsetYSteps(int cell) const;
+
+private:
+    TrayLayout layouts[MAX_TRAY_LAYOUTS];
+    bool defined[MAX_TRAY_LAYOUTS] = {};
+    int activeLayout = 0;
+    long stepX[MAX_TRAY_CELLS] = {};
+    long stepY[MAX_TRAY_CELLS] = {};
+    uint32_t occupiedMask = 0;
+    float paintOffsetXInches = 0.0f;
+    float paintOffsetYInches = 0.0f;
+
+    void buildStepTable();
+    static bool isValid(const TrayLayout& layout);
+    static TrayLayout defaultLayout();
+};
+
+// Global tray layout store
+extern TrayLayouts trayLayouts;
+
+#endif // TRAY_LAYOUTS_H
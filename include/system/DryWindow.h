@@ -0,0 +1,22 @@
+#ifndef DRY_WINDOW_H
+#define DRY_WINDOW_H
+
+#include <Arduino.h>
+
+//* ************************************************************************
+//* *************************** DRY WINDOW *********************************
+//* ************************************************************************
+// The inter-coat delay of an All Sides job, used as a scheduling window.
+// Background tasks (gun clean, drift check) run while the coat dries, but only
+// when their time estimate fits in what is left of the window. Progress is
+// reported to the dashboard as
+//   DRY_WINDOW:<elapsed s>,<total s>,<task or WAITING>   and   DRY_WINDOW:DONE
+//
+// A PAUSE received during the window stays pending and takes effect at the
+// first side boundary of the next coat, so the part still gets its full dry
+// time before painting continues.
+
+// Runs the window for durationMs. Returns false if HOME aborted it.
+bool runDryWindow(unsigned long durationMs, int nextCoat);
+
+#endif // DRY_WINDOW_H
@@ -0,0 +1,45 @@
+#ifndef EVENT_LOOP_H
+#define EVENT_LOOP_H
+
+#include <Arduino.h>
+
+//* ************************************************************************
+//* **************************** EVENT LOOP ********************************
+//* ************************************************************************
+// The controller (loop task) sleeps only when nothing is due. It is woken by
+// a task notification when an event arrives:
+//  - a cycle sensor edge (from the ISR)
+//  - a command queued by the network task
+// and otherwise at the earliest deadline requested during the pass (timed
+// PnP sub-steps, telemetry, sensor debounce window), or every
+// EVENT_LOOP_MOTION_POLL_MS while an axis moves, since the stepper driver has
+// no move-complete event. EVENT_LOOP_MAX_SLEEP_MS bounds any sleep.
+
+/**
+ * @brief Makes the calling task the one woken by events. Call from setup().
+ */
+void eventLoopBegin();
+
+// Wake the controller: something to do now
+void eventLoopNotify();
+void IRAM_ATTR eventLoopNotifyFromISR();
+
+/**
+ * @brief Requests a wake-up at 'deadlineMs' (millis()) for the current pass.
+ * Controller only; the earliest request wins and is cleared by the next wait.
+ */
+void eventLoopWakeAt(unsigned long deadlineMs);
+
+/**
+ * @brief End of loop(): sleeps until an event, the earliest requested
+ * deadline or the motion poll, whichever comes first.
+ */
+void eventLoopWait();
+
+/**
+ * @brief For blocking operations: sleeps up to 'maxMs', returning early when
+ * an event arrives (e.g. HOME). Replaces fixed delay() calls in wait loops.
+ */
+void eventLoopSleep(unsigned long maxMs);
+
+#endif // EVENT_LOOP_H
@@ -0,0 +1,55 @@
+#ifndef FIXTURES_H
+#define FIXTURES_H
+
+#include <Arduino.h>
+
+//* ************************************************************************
+//* **************************** FIXTURES **********************************
+//* ************************************************************************
+// Fixture origins for pipelined painting. Fixture 1 is the reference the
+// side patterns were taught on (offset 0,0); further fixtures are the same
+// patterns translated by an X/Y offset. All fixtures share the rotation axis.
+//
+// While a job runs, the patterns add the offset of the active fixture to
+// their start positions, so every pattern works unchanged on every fixture.
+// A tray paint job uses the same hook with a tray cell as the target.
+
+const int MAX_FIXTURES = 3;
+
+struct Fixture {
+    bool enabled;
+    float offsetX;          // Inches from fixture 1
+    float offsetY;
+};
+
+// Load the fixture table from NVS (call after NVS is usable)
+void loadFixtures();
+void saveFixtures();
+
+// Table access (index is 0-based, fixture 1 is index 0 and always enabled)
+const Fixture& getFixture(int index);
+void setFixtureEnabled(int index, bool enabled);
+void setFixtureOffset(int index, float offsetX, float offsetY);
+int enabledFixtureCount();
+
+// How a side pattern runs. A tray job paints one side on every cell before
+// the next side: the first cell sets the side up (safe Z, rotation, servo,
+// pressure pot), later cells reuse that setup, and no cell returns to the
+// rest position in between; the pattern ends at safe Z over its cell.
+enum PatternCellMode : uint8_t {
+    PATTERN_STANDALONE,     // Setup, pattern, move to rest (fixtures, single sides)
+    PATTERN_CELL_FIRST,     // Setup and pattern, stays over the cell
+    PATTERN_CELL_NEXT       // Pattern only, the side is already set up
+};
+
+void setPatternCellMode(PatternCellMode mode);
+PatternCellMode patternCellMode();
+
+// Fixture the side patterns currently paint on
+void setActiveFixture(int index);
+void setActiveTrayCell(int cell);      // Target a cell of the active tray layout instead
+int getActiveFixture();
+long fixtureOffsetXSteps();
+long fixtureOffsetYSteps();
+
+#endif // FIXTURES_H
@@ -0,0 +1,91 @@
+#ifndef LOGGER_H
+#define LOGGER_H
+
+#include <Arduino.h>
+#include <atomic>
+
+//* ************************************************************************
+//* ****************************** LOGGER **********************************
+//* ************************************************************************
+// Deferred, leveled logging for hot paths. A call stores a compact binary
+// record (timestamp, level, format pointer, up to LOG_MAX_ARGS 32-bit
+// arguments) in a RAM ring and returns; the low priority log task formats
+// the records later and writes them to Serial and, if enabled, to dashboard
+// clients as "LOG:<level>:<text>". Serial at 115200 baud no longer blocks
+// the controller. When a ring is full the record is dropped and counted.
+//
+// There is one ring per core, so the controller and the network task never
+// contend. Not for use from ISRs.
+//
+// The format string and any %s argument are stored by pointer: they must be
+// string literals or other storage that lives forever (e.g. State::getName()),
+// never String::c_str(). Supported conversions: d i u x X o c s f e g, with
+// flags, width and precision; 'l' length modifiers are accepted.
+
+enum LogLevel : uint8_t {
+    LOG_LEVEL_OFF = 0,
+    LOG_LEVEL_ERROR,
+    LOG_LEVEL_WARN,
+    LOG_LEVEL_INFO,
+    LOG_LEVEL_DEBUG
+};
+
+const uint8_t LOG_MAX_ARGS = 6;
+
+union LogArg {
+    int32_t i;
+    uint32_t u;
+    float f;
+    const char* s;
+
+    LogArg() : u(0) {}
+    LogArg(int v) : i(v) {}
+    LogArg(long v) : i((int32_t)v) {}
+    LogArg(unsigned int v) : u(v) {}
+    LogArg(unsigned long v) : u((uint32_t)v) {}
+    LogArg(float v) : f(v) {}
+    LogArg(double v) : f((float)v) {}
+    LogArg(const char* v) : s(v) {}
+};
+
+// Most verbose level of either output; calls above it return at once
+extern std::atomic<uint8_t> logActiveLevel;
+
+void logPush(LogLevel level, const char* format, const LogArg* args, uint8_t argCount);
+
+template <typename... Args>
+inline void logWrite(LogLevel level, const char* format, Args... args) {
+    static_assert(sizeof...(Args) <= LOG_MAX_ARGS, "Too many log arguments");
+    if (level > logActiveLevel.load(std::memory_order_relaxed)) {
+        return;
+    }
+    const LogArg packed[] = {LogArg(args)..., LogArg()};
+    logPush(level, format, packed, sizeof...(Args));
+}
+
+template <typename... Args> inline void logError(const char* format, Args... args) { logWrite(LOG_LEVEL_ERROR, format, args...); }
+template <typename... Args> inline void logWarn(const char* format, Args... args) { logWrite(LOG_LEVEL_WARN, format, args...); }
+template <typename... Args> inline void logInfo(const char* format, Args... args) { logWrite(LOG_LEVEL_INFO, format, args...); }
+template <typename... Args> inline void logDebug(const char* format, Args... args) { logWrite(LOG_LEVEL_DEBUG, format, args...); }
+
+/**
+ * @brief Starts the log task. Call from setup() after Serial.begin().
+ */
+void startLogTask();
+
+/**
+ * @brief Formats and writes every pending record now, e.g. before a restart.
+ * Any task; waits for a drain the log task is running.
+ */
+void logFlush();
+
+// Runtime verbosity of each output (LOG_LEVEL_OFF disables it)
+void logSetLevels(LogLevel serialLevel, LogLevel webLevel);
+LogLevel logSerialLevel();
+LogLevel logWebLevel();
+
+// "OFF", "ERROR", "WARN", "INFO", "DEBUG" (case-insensitive); false if unknown
+bool logParseLevel(const char* name, LogLevel& level);
+const char* logLevelName(LogLevel level);
+
+#endif // LOGGER_H
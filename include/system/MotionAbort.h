@@ -0,0 +1,36 @@
+#ifndef MOTION_ABORT_H
+#define MOTION_ABORT_H
+
+#include <Arduino.h>
+
+//* ************************************************************************
+//* ************************** MOTION ABORT ********************************
+//* ************************************************************************
+// HOME aborts whatever the machine is doing. The request is an atomic flag
+// raised by whichever task receives the command (normally the network task
+// as the WebSocket message arrives); raising it also wakes the loop task, so
+// a blocking move sleeping between 1 ms motion polls reacts at once. The
+// loop task then ramps the axes down with stopMove(): the abort takes the
+// deceleration time instead of waiting for the next pattern-level check.
+//
+// checkForHomeCommand() reads the flag and nothing else, so pattern code can
+// call it as often as it likes. HomingState clears the flag on entry.
+
+/**
+ * @brief Requests an abort. Safe from any task.
+ */
+void motionAbortRequest();
+
+// True from the request until homing starts
+bool motionAbortPending();
+
+// Called by HomingState once the abort is being handled
+void motionAbortClear();
+
+/**
+ * @brief Decelerates X, Y (both motors), Z and the rotation axis to a stop
+ * and waits until they are stopped. Controller (loop task) only.
+ */
+void motionAbortStopAxes();
+
+#endif // MOTION_ABORT_H
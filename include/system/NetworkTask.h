@@ -0,0 +1,62 @@
+#ifndef NETWORK_TASK_H
+#define NETWORK_TASK_H
+
+#include <Arduino.h>
+
+//* ************************************************************************
+//* *************************** NETWORK TASK *******************************
+//* ************************************************************************
+// WiFi, the dashboard HTTP server, the WebSocket server and OTA are serviced
+// by a task on NETWORK_TASK_CORE. Motion and the state machine stay in the
+// loop task on the other core. The two sides only talk through two queues:
+//  - commands: fixed-size records in a lock-free single producer/single
+//    consumer ring (see utils/SpscRing.h). The WebSocket callback only copies
+//    the text into a record; the loop task drains the ring from loop() and
+//    runs each record through processWebCommand(), in arrival order and never
+//    from inside another command or a blocking move.
+//  - outbound: text sent with webSendTXT()/webBroadcastTXT() from any task,
+//    written to the clients by the network task. Entries carry a heap copy of
+//    the text, freed by the network task.
+// Machine state the network task needs (e.g. for a new client) comes from
+// the telemetry snapshot (system/Telemetry.h), never from controller objects.
+//
+// HOME and PAUSE must act while a blocking move or paint job runs, so the
+// callback also raises their flags (motion abort, pauseCommandReceived)
+// at once; the queued record then only finishes the job (state change, reply)
+// when the controller gets to it. The flags are raised even when the record
+// cannot be queued, and a pending abort without its record still ends in
+// homing when the controller next drains the ring.
+
+/**
+ * @brief Creates the queues and starts the network task. Call at the end of
+ * setup(), after initializeWebCommunications(). Until then sends go straight
+ * to the WebSocket server.
+ */
+void startNetworkTask();
+
+/**
+ * @brief Copies a received command into the ring for the motion side
+ * (network task only).
+ * @return false if the command is too long or the ring is full (dropped).
+ * A dropped HOME or PAUSE still raises its flag.
+ */
+bool webEnqueueCommand(uint8_t num, const uint8_t* payload, size_t length);
+
+/**
+ * @brief Runs the queued commands through processWebCommand(). Loop task
+ * only, and only from loop(): commands never run nested.
+ */
+void processQueuedWebCommands();
+
+/**
+ * @brief Restarts the controller from the network task once it has sent
+ * everything queued so far (replies, log lines). Any task; the caller does
+ * not wait for the restart.
+ */
+void webRestartAfterSend();
+
+// Thread safe replacements for webSocket.sendTXT()/broadcastTXT()
+void webSendTXT(uint8_t num, const String& text);
+void webBroadcastTXT(const String& text);
+
+#endif // NETWORK_TASK_H
@@ -0,0 +1,88 @@
+#ifndef PAINT_PROGRESS_H
+#define PAINT_PROGRESS_H
+
+#include <Arduino.h>
+
+//* ************************************************************************
+//* ************************* PAINT PROGRESS *******************************
+//* ************************************************************************
+// Tracks where an All Sides paint job is (coat, side, pass) so it can be
+// paused at a pass boundary and resumed from exactly that pass.
+//
+// A "pass" is one gun-on sweep of a side pattern plus the travel that leads
+// to the next sweep. The end sequence of Sides 2 and 4 counts as one extra
+// pass after the regular sweeps.
+
+// What a job paints: the enabled fixtures, or every occupied cell of the
+// active tray layout (see TrayLayouts.h). In a tray job the 'fixture' of the
+// progress and checkpoint is the tray cell.
+enum PaintJobMode {
+    PAINT_JOB_FIXTURES = 0,
+    PAINT_JOB_TRAY = 1
+};
+
+// Checkpoint recorded when a job is paused. coat/side/pass point at the first
+// pass that has NOT been painted yet.
+struct PaintCheckpoint {
+    bool valid;
+    int totalCoats;
+    int coat;               // 1-based coat number
+    PaintJobMode mode;
+    int fixture;            // 0-based fixture index (see Fixtures.h), tray cell in tray jobs
+    int side;               // Side number (1-4)
+    int pass;               // 0-based pass index within the side
+    long xSteps;            // Axis positions when the job stopped
+    long ySteps;
+    long zSteps;
+    long rotationSteps;
+    bool paintGunOn;        // Tool state when the job stopped
+    bool pressurePotOn;
+    int servoAngle;
+};
+
+// Where the current job is (all 0 when no job is active)
+struct PaintJobPosition {
+    int totalCoats;
+    int coat;
+    int fixture;
+    int side;
+    int pass;
+};
+
+// Set by the PAUSE web command, consumed at the next pass boundary
+extern volatile bool pauseCommandReceived;
+
+// Job lifecycle (called by paintAllSides)
+void paintJobBegin(int totalCoats, PaintJobMode mode = PAINT_JOB_FIXTURES);
+void paintJobEnd();            // Also clears an aborted job
+void paintJobAbort();          // HOME during a job: drop checkpoint, patterns unwind
+bool isPaintJobActive();       // Running, paused or resuming
+bool isPaintJobRunning();      // Currently executing passes
+bool isPaintJobPaused();
+
+// Progress reporting
+void paintJobBeginCoat(int coat);
+void paintJobBeginFixture(int fixture);  // Also makes it the active fixture (or tray cell)
+void paintJobBeginSide(int side);
+void paintJobPassComplete(int side, int pass);
+
+// Called by the patterns at every pass boundary. Returns true when the pattern
+// must raise Z and return: a PAUSE was requested (checkpoint recorded) or the
+// job was aborted.
+bool paintJobStopRequested();
+
+// Resume support
+void paintJobResume();                  // Re-arm a paused job from its checkpoint
+bool paintJobRestoreFromJournal();      // Pause point from a job interrupted by a reset
+bool isPaintJobResuming();
+int paintJobResumeCoat();
+int paintJobTotalCoats();
+PaintJobMode paintJobMode();
+bool paintJobShouldSkipFixture(int fixture); // Fixture painted before the checkpoint fixture
+bool paintJobShouldSkipSide(int side);  // Side lies before the checkpoint side
+int paintJobTakeResumePass(int side);   // First pass to paint on 'side', clears resume mode
+
+const PaintCheckpoint& paintJobCheckpoint();
+PaintJobPosition paintJobPosition();
+
+#endif // PAINT_PROGRESS_H
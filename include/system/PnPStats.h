@@ -0,0 +1,35 @@
+#ifndef PNP_STATS_H
+#define PNP_STATS_H
+
+#include <Arduino.h>
+#include <ArduinoJson.h>
+
+//* ************************************************************************
+//* ***************************** PNP STATS ********************************
+//* ************************************************************************
+// Per-phase timing of the PnP cycle, kept in RAM since boot (or the last
+// reset). Min/avg/max cover every sample; p95 is taken over the most recent
+// PNP_STATS_WINDOW samples of each phase.
+
+enum PnPPhase {
+    PNP_PHASE_WAIT_SENSOR,      // At the pick location until a part is present
+    PNP_PHASE_ARRIVAL_LATENCY,  // Sensor edge (ISR timestamp) to cycle start
+    PNP_PHASE_VERIFY_MOVE,      // Settling onto the pick location
+    PNP_PHASE_PICK,             // Extend, vacuum, retract at pick
+    PNP_PHASE_LOADED_TRAVEL,    // Pick to place with the part
+    PNP_PHASE_PLACE,            // Extend, release, retract at place
+    PNP_PHASE_RETURN_TRAVEL,    // Place back to pick, empty
+    PNP_PHASE_COUNT
+};
+
+const int PNP_STATS_WINDOW = 64;
+
+void pnpStatsRecord(PnPPhase phase, unsigned long durationUs);
+void pnpStatsCycleComplete();
+void pnpStatsReset();
+const char* pnpPhaseName(PnPPhase phase);
+
+// Fills 'doc' with the "pnp_stats" event (times in ms)
+void pnpStatsToJson(JsonDocument& doc);
+
+#endif // PNP_STATS_H
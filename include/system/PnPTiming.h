@@ -0,0 +1,90 @@
+#ifndef PNP_TIMING_H
+#define PNP_TIMING_H
+
+#include <Arduino.h>
+#include <ArduinoJson.h>
+#include "system/PnPStats.h" // For PnPPhase
+
+//* ************************************************************************
+//* **************************** PNP TIMING ********************************
+//* ************************************************************************
+// Time model of the PnP cycle, built on the trapezoidal move profiles. PnPState
+// uses it to order placements and to overlap actuation with travel; the
+// benchmark replays a whole tray with the same model, so tuning changes can be
+// compared without moving the machine.
+
+struct PnPMoveProfile {
+    float xSpeed;
+    float xAccel;
+    float ySpeed;
+    float yAccel;
+};
+
+// Current settings (see Web_Dashboard_Commands.cpp)
+PnPMoveProfile pnpLoadedProfile();   // Pick to place, part on the vacuum cup
+PnPMoveProfile pnpUnloadedProfile(); // Back to pick, empty
+
+// Y speed of the loaded move; the final placement is made at half speed
+float pnpPlaceMoveYSpeed(const PnPMoveProfile& loaded, bool finalPlacement);
+
+// Actuator time per cycle at the pick and place locations (ms), excluding overlap with travel
+extern const unsigned long PNP_ACTUATION_MS;
+
+// Extra wait after the vacuum comes on at pick (ms)
+const unsigned long PNP_PICK_VACUUM_SETTLE_MS = 50;
+
+struct PnPPlaceTiming {
+    unsigned long travelMs;          // Loaded move, predicted by the profile
+    unsigned long retractOverlapMs;  // Part of the pick retract delay spent travelling
+    unsigned long extendLeadMs;      // Cylinder starts extending this long before arrival
+};
+
+/**
+ * @brief Plans the loaded move by (dx, dy) steps and how much actuator time can
+ * overlap with it: the pick retract may still be settling while the gantry
+ * covers PNP_PICK_RETRACT_OVERLAP_INCHES, and the place extend may start when
+ * PNP_PLACE_EXTEND_OVERLAP_INCHES of travel remain.
+ */
+PnPPlaceTiming pnpPlanPlaceMove(long dx, long dy, const PnPMoveProfile& loaded, bool finalPlacement);
+
+// Duration of the empty move back to pick (s)
+float pnpReturnTime(long dx, long dy, const PnPMoveProfile& unloaded);
+
+/**
+ * @brief Fills 'order' with the placement cells of the active tray layout,
+ * ordered for the least total cycle time (see PnPTiming.cpp).
+ * @param travelSeconds Receives the total pick/place travel time of the plan.
+ * @return Number of placements.
+ */
+int pnpPlanPlacementOrder(long pickX, long pickY, const PnPMoveProfile& loaded,
+                          const PnPMoveProfile& unloaded, int* order, float& travelSeconds);
+
+//* ************************************************************************
+//* ************************** PNP BENCHMARK *******************************
+//* ************************************************************************
+// Deterministic dry run of a full tray on the active layout. The gantry starts
+// at the pick location; a scripted sensor delivers part k at k * partIntervalMs
+// (0: a part is always waiting). Phases follow PnPState's cycle, including the
+// travel overlap and picking a part that arrived during the return move.
+
+struct PnPBenchmarkConfig {
+    PnPMoveProfile loaded;
+    PnPMoveProfile unloaded;
+    unsigned long partIntervalMs;
+};
+
+struct PnPBenchmarkResult {
+    int parts;
+    float totalMs;
+    float partsPerHour;
+    float phaseMs[PNP_PHASE_COUNT];  // Summed over the run
+    float travelXInches;             // Total axis travel
+    float travelYInches;
+};
+
+void pnpBenchmarkRun(const PnPBenchmarkConfig& config, PnPBenchmarkResult& result);
+
+// Fills 'doc' with the "pnp_benchmark" event (times in ms)
+void pnpBenchmarkToJson(const PnPBenchmarkConfig& config, const PnPBenchmarkResult& result, JsonDocument& doc);
+
+#endif // PNP_TIMING_H
@@ -0,0 +1,37 @@
+#ifndef RETAINED_POSITIONS_H
+#define RETAINED_POSITIONS_H
+
+#include <Arduino.h>
+
+//* ************************************************************************
+//* *********************** RETAINED POSITIONS *****************************
+//* ************************************************************************
+// Axis positions kept in RTC memory across a controlled software restart
+// (OTA update, RESTART command). The stepper drivers stay powered through
+// such a restart, so the positions are still valid and boot homing can be
+// skipped. Any other reset (power-on, brownout, panic, watchdog) discards them.
+
+// Positions are only retained once they are referenced to the home switches
+void setAxesReferenced(bool referenced);
+bool areAxesReferenced();
+
+// Snapshot before a controlled restart. Refuses (and invalidates) while any
+// axis is moving or the axes are not referenced.
+bool retainPositionsForRestart();
+void invalidateRetainedPositions();
+
+// At boot, after the steppers are connected. Returns true when positions were
+// restored and homing can be skipped. The RTC copy is consumed either way.
+bool restoreRetainedPositions();
+
+// OTA: the controller keeps running during the upload, so positions are
+// retained at its end, and only if the controller was held idle throughout.
+// While held it refuses commands and Idle ignores the PnP cycle sensor.
+// RESTART uses the same hold between its reply and the reboot.
+void restartHoldBegin();    // Network task, upload starting
+void restartHoldUpdate();   // Controller, every pass: settles the hold (idle and stopped, or busy)
+bool restartHoldActive();
+bool restartHoldRetain();   // Network task, upload done: retains if the controller was held idle
+void restartHoldCancel();   // Upload failed; the machine keeps running
+
+#endif // RETAINED_POSITIONS_H
@@ -8,46 +8,82 @@
 #include "states/PausedState.h"
 #include "states/IdleState.h"
 #include "states/PnPState.h"
+#include "utils/settings.h" // For STATE_TRANSITION_QUEUE_LENGTH
+
+//* ************************************************************************
+//* ************************* STATE MACHINE *******************************
+//* ************************************************************************
+// States are members of the machine (no heap). Nothing changes state
+// directly: patterns, web commands and the states themselves queue a
+// transition with requestTransition(), and update() applies the queue on
+// the loop task before running the current state. Each transition is checked
+// against TRANSITIONS (StateMachine.cpp) and dropped if it is not allowed, or
+// if the state it was requested from is no longer current (e.g. a job asking
+// for Idle after HOME already moved the machine to Homing). Homing is never
+// dropped as stale; it is checked against the state current when applied.
+// Every drop is logged.
+
+enum StateId : uint8_t {
+    STATE_IDLE = 0,
+    STATE_HOMING,
+    STATE_PAINTING,
+    STATE_CLEANING,
+    STATE_PAUSED,
+    STATE_PNP,
+    STATE_COUNT,
+    STATE_NONE = STATE_COUNT
+};
+
+struct StateTransition {
+    StateId from;         // Current state when requested
+    StateId to;
+    StateId then;         // Where Cleaning continues when done (STATE_NONE: Idle)
+    bool paintAllSides;   // Cleaning rotates for, and Painting starts, an All Sides job
+};
 
 class StateMachine {
 public:
     StateMachine();
-    ~StateMachine();
-    
-    void changeState(State* newState);
+
+    /**
+     * @brief Queues a transition from the current state to 'to'. Loop task only.
+     * @return false if the queue is full.
+     */
+    bool requestTransition(StateId to, StateId then = STATE_NONE, bool paintAllSides = false);
+    bool isTransitionQueued(StateId to) const;
     void update();
+
     State* getCurrentState() { return currentState; }
-    
+    StateId getCurrentStateId() const { return currentId; }
+
+    // The transition that entered the current state (read it in enter())
+    const StateTransition& getEntryTransition() const { return entryTransition; }
+
     // Getter methods for state access from other classes
-    State* getIdleState() { return idleState; }
-    State* getHomingState() { return homingState; }
-    State* getPaintingState() { return paintingState; }
-    State* getCleaningState() { return cleaningState; }
-    State* getPausedState() { return pausedState; }
-    State* getPnpState() { return pnpState; }
-    
-    // Mechanism to allow a state to define the next state after a sub-routine
-    void setNextStateOverride(State* state);
-    State* getNextStateOverrideAndClear();
-
-    // Helper method to get state name for debugging
-    const char* getStateName(State* state);
-
-    // Flag and methods for 'paint all sides' transition
-    void setTransitioningToPaintAllSides(bool value);
-    bool isTransitioningToPaintAllSides() const; // No longer clears flag
-    void clearTransitioningToPaintAllSidesFlag();
+    State* getIdleState() { return &idleState; }
+    State* getHomingState() { return &homingState; }
+    State* getPaintingState() { return &paintingState; }
+    State* getCleaningState() { return &cleaningState; }
+    State* getPausedState() { return &pausedState; }
+    State* getPnpState() { return &pnpState; }
+    State* getState(StateId id);
 
 private:
+    void applyTransition(StateTransition transition);
+
+    IdleState idleState;
+    HomingState homingState;
+    PaintingState paintingState;
+    CleaningState cleaningState;
+    PausedState pausedState;
+    PnPState pnpState;
+
     State* currentState;
-    State* idleState;
-    State* homingState;
-    State* paintingState;
-    State* cleaningState;
-    State* pausedState;
-    State* pnpState;
-    State* nextStateOverride; // Added for sub-routine returns
-    bool _isTransitioningToPaintAllSides; // Flag for paint all sides transition
+    StateId currentId;
+    StateTransition entryTransition;
+    StateTransition pending[STATE_TRANSITION_QUEUE_LENGTH]; // FIFO, loop task only
+    uint8_t pendingHead;
+    uint8_t pendingCount;
 };
 
-#endif // STATEMACHINE_H 
\ No newline at end of file
+#endif // STATEMACHINE_H
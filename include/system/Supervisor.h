@@ -0,0 +1,60 @@
+#ifndef SUPERVISOR_H
+#define SUPERVISOR_H
+
+#include <Arduino.h>
+#include <ArduinoJson.h>
+
+//* ************************************************************************
+//* **************************** SUPERVISOR ********************************
+//* ************************************************************************
+// Watches the controller (loop task) from the network task.
+//  - Every loop pass is timed (excluding its sleep) into a histogram; passes
+//    over SUPERVISOR_LOOP_BUDGET_MS are counted as overruns.
+//  - Blocking motion is bracketed as segments, each with a time budget;
+//    segments that finish over budget are counted as overruns.
+//  - The controller reports progress at the end of each pass and at segment
+//    boundaries only. Sleeping is not progress: a blocking wait that can
+//    outlast SUPERVISOR_STALL_MS must run as a segment with a budget.
+// The network task checks for a stall (no progress for SUPERVISOR_STALL_MS
+// outside a segment, or the current segment SUPERVISOR_STALL_MS past its
+// budget). On a stall it stores the reason in RTC memory, switches the paint
+// gun and pressure pot off, force stops every axis and stops feeding the
+// task watchdog, whose panic reset restarts the controller. The reason is
+// reported at the next boot.
+
+// At boot, before the network task starts: reports a stall stored before the reset
+void supervisorBegin();
+
+// Controller: bracket the work of one loop pass (not the event loop wait)
+void supervisorLoopBegin();
+void supervisorLoopEnd();
+
+/**
+ * @brief Controller: a blocking motion segment starts. 'name' must be a
+ * string literal. Segments nest up to SUPERVISOR_SEGMENT_DEPTH deep.
+ */
+void supervisorSegmentBegin(const char* name, unsigned long budgetMs);
+void supervisorSegmentEnd();
+
+// Budget for a move of 'steps' at 'speedHz' (see SUPERVISOR_MOVE_BUDGET_FACTOR)
+unsigned long supervisorMoveBudgetMs(long steps, unsigned int speedHz);
+
+// Controller: real progress (end of a pass, segment boundary)
+void supervisorFeed();
+
+/**
+ * @brief Network task: subscribes the calling task to the task watchdog.
+ */
+void supervisorWatchdogBegin();
+
+/**
+ * @brief Network task, every pass: feeds the watchdog while the controller
+ * makes progress; on a stall, stops the machine and lets the watchdog reset it.
+ */
+void supervisorCheck();
+
+// Loop pass histogram, overruns and the last stall (controller only)
+void supervisorToJson(JsonDocument& doc);
+void supervisorReset();
+
+#endif // SUPERVISOR_H
@@ -0,0 +1,58 @@
+#ifndef TELEMETRY_H
+#define TELEMETRY_H
+
+#include <Arduino.h>
+#include <ArduinoJson.h>
+
+//* ************************************************************************
+//* **************************** TELEMETRY *********************************
+//* ************************************************************************
+// Snapshot of the machine published by the controller (loop task) every
+// TELEMETRY_PERIOD_MS, and also from blocking moves through
+// checkForHomeCommand(). Any task can read a consistent copy without locks or
+// stepper driver calls: the snapshot sits behind a sequence lock, the writer
+// makes the sequence odd while it copies and readers retry if it changed.
+
+struct Telemetry {
+    uint32_t timeMs;          // millis() when published
+    int32_t xSteps;
+    int32_t yLeftSteps;
+    int32_t yRightSteps;
+    int32_t zSteps;
+    int32_t rotationSteps;
+    float rotationAngle;      // Degrees
+    bool paintGunOn;
+    bool pressurePotOn;
+    bool vacuumOn;
+    bool cylinderDown;
+    bool jobRunning;          // All Sides / tray paint job
+    bool jobPaused;
+    uint8_t jobCoat;
+    uint8_t jobTotalCoats;
+    uint8_t jobFixture;       // Fixture index, tray cell in tray jobs
+    uint8_t jobSide;
+    uint8_t jobPass;
+    bool resumeAvailable;     // Journal holds a job interrupted by a reset
+    uint8_t resumeCoat;
+    uint8_t resumeTotalCoats;
+    uint8_t resumeSide;
+    uint8_t resumePass;       // First pass not yet painted (0-based)
+    char state[16];           // State name, e.g. "IDLE"
+};
+
+/**
+ * @brief Publishes a new snapshot if TELEMETRY_PERIOD_MS has passed since
+ * the last one. Controller (loop task) only.
+ */
+void telemetryUpdate();
+
+/**
+ * @brief Copies the latest snapshot. Safe from any task.
+ * @return false if nothing has been published yet.
+ */
+bool telemetryRead(Telemetry& out);
+
+// Fills 'doc' with the "telemetry" event (positions in inches/degrees)
+void telemetryToJson(const Telemetry& telemetry, JsonDocument& doc);
+
+#endif // TELEMETRY_H
@@ -11,6 +11,6 @@
 // Let's remove these for now, includes should come from StateMachine.h directly where needed.
 
 // Machine flags
-extern volatile bool homeCommandReceived;
+// HOME requests: see system/MotionAbort.h
 
 #endif // MACHINE_STATE_H 
\ No newline at end of file
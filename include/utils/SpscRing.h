@@ -0,0 +1,60 @@
+#ifndef SPSC_RING_H
+#define SPSC_RING_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <atomic>
+
+//* ************************************************************************
+//* ************************** SPSC RING BUFFER ****************************
+//* ************************************************************************
+// Lock-free ring of fixed-size records for exactly one producer and one
+// consumer, which may run on different cores. Records are filled and read in
+// place: the producer claims a slot with pushSlot(), writes it and publishes
+// it with commitPush(); the consumer reads front() and releases it with pop().
+// Ordering is strictly first in, first out. N must be a power of two.
+
+template <typename T, uint32_t N>
+class SpscRing {
+    static_assert(N >= 2 && (N & (N - 1)) == 0, "SpscRing size must be a power of two");
+
+public:
+    // Producer: free slot to fill, or nullptr if the ring is full
+    T* pushSlot() {
+        uint32_t head = _head.load(std::memory_order_relaxed);
+        if (head - _tail.load(std::memory_order_acquire) >= N) {
+            return nullptr;
+        }
+        return &_slots[head & (N - 1)];
+    }
+
+    // Producer: publishes the slot returned by pushSlot()
+    void commitPush() {
+        _head.store(_head.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+    }
+
+    // Consumer: oldest record, or nullptr if the ring is empty
+    const T* front() const {
+        uint32_t tail = _tail.load(std::memory_order_relaxed);
+        if (tail == _head.load(std::memory_order_acquire)) {
+            return nullptr;
+        }
+        return &_slots[tail & (N - 1)];
+    }
+
+    // Consumer: releases the record returned by front()
+    void pop() {
+        _tail.store(_tail.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+    }
+
+    uint32_t size() const {
+        return _head.load(std::memory_order_acquire) - _tail.load(std::memory_order_acquire);
+    }
+
+private:
+    T _slots[N];
+    std::atomic<uint32_t> _head{0}; // Written by the producer only
+    std::atomic<uint32_t> _tail{0}; // Written by the consumer only
+};
+
+#endif // SPSC_RING_H
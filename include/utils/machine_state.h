@@ -17,7 +17,7 @@ class StateMachine;
 extern StateMachine* stateMachine;
 
 // Machine flags
-extern volatile bool homeCommandReceived;
+// HOME requests: see system/MotionAbort.h
 
 // Function declarations
 void setMachineState(int state);
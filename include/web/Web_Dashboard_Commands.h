@@ -8,7 +8,7 @@
 
 // Declare functions defined in Web_Dashboard_Commands.cpp that are used elsewhere
 
-// Main function to handle web server and WebSocket loop
+// Main function to handle web server and WebSocket loop (network task)
 void runDashboardServer();
 
 // Function to stop the server
@@ -22,9 +22,6 @@ void webSocketEvent(uint8_t num, WStype_t type, uint8_t * payload, size_t length
 // or have a dedicated messaging module.
 void sendWebStatus(WebSocketsServer* webSocket, const char* message);
 
-// Process WebSocket events without executing commands (for checking during operations)
-void processWebSocketEvents();
-
 // Check if a home command was received during painting operations
 bool checkForHomeCommand();
 
@@ -34,6 +31,7 @@ void setupWebDashboardCommands();
 // Function declarations
 void processWebCommand(WebSocketsServer* webSocket, uint8_t num, String command);
 void sendCurrentPnpSettings(uint8_t clientNum);
+void sendResumeAvailable(int clientNum); // clientNum < 0 broadcasts; controller only
 void savePnpSettingsToNVS(); // Declaration for saving PNP settings
 void loadPnpSettingsFromNVS(); // Declaration for loading PNP settings
 
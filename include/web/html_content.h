@@ -91,6 +91,14 @@ const char HTML_PROGMEM[] PROGMEM = R"rawliteral(
             color: var(--text-muted);
         }
         
+        /* Telemetry line under the status display */
+        #telemetryDisplay {
+            margin: -16px auto 24px auto;
+            font-size: 0.9rem;
+            color: var(--text-muted);
+            text-align: center;
+        }
+
         /* Status Display */
         #machineStatusDisplay {
             background: rgba(255, 255, 255, 0.06);
@@ -752,7 +760,17 @@ const char HTML_PROGMEM[] PROGMEM = R"rawliteral(
             /* Inherits text-align: center from general .setting-input */
         }
 
-        #paintMultipleCoatsBtn {
+        .pnp-stats-table {
+            width: 100%;
+            border-collapse: collapse;
+            text-align: right;
+        }
+
+        .pnp-stats-table th:first-child, .pnp-stats-table td:first-child {
+            text-align: left;
+        }
+
+        #paintMultipleCoatsBtn, #paintTrayBtn {
             grid-column: 1 / -1; /* This makes the button span all columns of its parent grid */
             /* width and max-width are removed as the grid layout handles this */
             padding-top: 14px;
@@ -819,6 +837,7 @@ const char HTML_PROGMEM[] PROGMEM = R"rawliteral(
                         // Request PNP settings
                         if (websocket.readyState === WebSocket.OPEN) {
                             websocket.send(JSON.stringify({ command: "GET_PNP_SETTINGS" }));
+                            websocket.send(JSON.stringify({ command: "GET_TRAY_LAYOUTS" }));
                             console.log("Requested PNP settings");
                         }
                     }, 500);
@@ -930,9 +949,77 @@ const char HTML_PROGMEM[] PROGMEM = R"rawliteral(
                     if (data.pnp_x_accel !== undefined) document.getElementById('pnp_x_accel').value = data.pnp_x_accel;
                     if (data.pnp_y_speed !== undefined) document.getElementById('pnp_y_speed').value = data.pnp_y_speed;
                     if (data.pnp_y_accel !== undefined) document.getElementById('pnp_y_accel').value = data.pnp_y_accel;
+                    if (data.pnp_loaded_x_speed !== undefined) document.getElementById('pnp_loaded_x_speed').value = data.pnp_loaded_x_speed;
+                    if (data.pnp_loaded_x_accel !== undefined) document.getElementById('pnp_loaded_x_accel').value = data.pnp_loaded_x_accel;
+                    if (data.pnp_loaded_y_speed !== undefined) document.getElementById('pnp_loaded_y_speed').value = data.pnp_loaded_y_speed;
+                    if (data.pnp_loaded_y_accel !== undefined) document.getElementById('pnp_loaded_y_accel').value = data.pnp_loaded_y_accel;
                     return;
                 }
                 
+                // Handle tray layout list
+                if (data.event === "tray_layouts") {
+                    trayLayouts = {};
+                    data.layouts.forEach(function(layout) { trayLayouts[layout.index] = layout; });
+                    trayActiveLayout = data.active;
+                    trayOccupiedMask = data.occupied;
+                    document.getElementById('tray_paint_offset_x').value = data.paintOffsetX;
+                    document.getElementById('tray_paint_offset_y').value = data.paintOffsetY;
+                    document.getElementById('tray_slot').value = data.active;
+                    showTrayLayout();
+                    return;
+                }
+
+                // Handle PnP per-phase statistics
+                if (data.event === "pnp_stats") {
+                    const body = document.getElementById('pnpStatsBody');
+                    body.innerHTML = '';
+                    data.phases.forEach(function(phase) {
+                        const row = document.createElement('tr');
+                        [phase.name, phase.n, phase.min.toFixed(1), phase.avg.toFixed(1), phase.max.toFixed(1), phase.p95.toFixed(1)]
+                            .forEach(function(value) {
+                                const cell = document.createElement('td');
+                                cell.textContent = value;
+                                row.appendChild(cell);
+                            });
+                        body.appendChild(row);
+                    });
+                    document.getElementById('pnpStatsCycles').textContent = data.cycles + ' cycle(s)';
+                    return;
+                }
+
+                // Handle the periodic machine snapshot
+                if (data.event === "telemetry") {
+                    const io = ['gun', 'pot', 'vacuum', 'cylinder'].filter(function(key) { return data[key]; });
+                    let text = 'X ' + data.x.toFixed(2) + '  Y ' + data.y.toFixed(2) + '  Z ' + data.z.toFixed(2) +
+                               '  A ' + data.angle.toFixed(1) + '\u00B0  IO: ' + (io.length ? io.join(', ') : 'off');
+                    if (data.job) {
+                        text += '  Job: coat ' + data.job.coat + '/' + data.job.coats + ', side ' + data.job.side +
+                                ', pass ' + data.job.pass + (data.job.paused ? ' (paused)' : '');
+                    }
+                    document.getElementById('telemetryDisplay').textContent = text;
+                    return;
+                }
+
+                // Handle the result of a PnP dry-run benchmark
+                if (data.event === "pnp_benchmark") {
+                    const phases = data.phases
+                        .filter(function(phase) { return phase.total > 0; })
+                        .map(function(phase) { return phase.name + ' ' + phase.avg.toFixed(0); });
+                    document.getElementById('pnpBenchmarkLabel').textContent =
+                        data.layout + ': ' + data.parts + ' parts in ' + (data.totalMs / 1000).toFixed(1) + ' s, ' +
+                        data.partsPerHour.toFixed(0) + ' parts/h, travel X ' + data.travelX.toFixed(0) + ' in, Y ' +
+                        data.travelY.toFixed(0) + ' in. Avg ms: ' + phases.join(', ');
+                    return;
+                }
+
+                // Handle the placement plan reported when PnP starts
+                if (data.event === "pnp_plan") {
+                    document.getElementById('pnpPlanLabel').textContent =
+                        data.layout + ': ' + data.order.length + ' placements, order ' + data.order.join(',') +
+                        ', expected ' + (data.totalMs / 1000).toFixed(1) + ' s (' + (data.cycleMs / 1000).toFixed(2) + ' s/cycle)';
+                    return;
+                }
+
                 // Handle other JSON messages if needed
                 console.log("Received JSON message:", data);
                 
@@ -952,6 +1039,52 @@ const char HTML_PROGMEM[] PROGMEM = R"rawliteral(
                     updateButtonStates(stateName); // Enable/disable buttons based on state
                 }
                 
+                // Job interrupted by a reset: RESUME_AVAILABLE:coat,totalCoats,side,pass (or NONE)
+                else if (messageText.startsWith('RESUME_AVAILABLE:')) {
+                    const payload = messageText.substring(17);
+                    const banner = document.getElementById('resumeJobBanner');
+                    const parts = payload.split(',');
+                    if (banner && parts.length === 4) {
+                        document.getElementById('resumeJobText').textContent =
+                            `Unfinished paint job: Coat ${parts[0]}/${parts[1]}, Side ${parts[2]}, Pass ${parts[3]}`;
+                        banner.style.display = 'block';
+                    } else if (banner) {
+                        banner.style.display = 'none';
+                    }
+                }
+
+                // Inter-coat dry window: DRY_WINDOW:elapsed,total,activity (or DONE)
+                else if (messageText.startsWith('DRY_WINDOW:')) {
+                    const payload = messageText.substring(11);
+                    const display = document.getElementById('dryWindowDisplay');
+                    const parts = payload.split(',');
+                    if (display && parts.length === 3) {
+                        const activity = parts[2] === 'WAITING' ? 'Drying' : parts[2].replace('_', ' ');
+                        document.getElementById('dryWindowText').textContent =
+                            `${activity} - ${parts[0]}s / ${parts[1]}s`;
+                        const progress = document.getElementById('dryWindowProgress');
+                        progress.max = Math.max(1, parseInt(parts[1]));
+                        progress.value = parseInt(parts[0]);
+                        display.style.display = 'block';
+                    } else if (display) {
+                        display.style.display = 'none';
+                    }
+                }
+
+                // Drift measured during the dry window: DRY_WINDOW_DRIFT:axis,steps (or LOST)
+                else if (messageText.startsWith('DRY_WINDOW_DRIFT:')) {
+                    console.log('Axis drift: ' + messageText.substring(17));
+                }
+
+                // Paused job checkpoint: PAUSED_AT:coat,totalCoats,side,pass
+                else if (messageText.startsWith('PAUSED_AT:')) {
+                    const parts = messageText.substring(10).split(',');
+                    const statusDisplay = document.getElementById('machineStatusDisplay');
+                    if (statusDisplay && parts.length === 4) {
+                        statusDisplay.textContent = `PAUSED - Coat ${parts[0]}/${parts[1]}, Side ${parts[2]}, Pass ${parts[3]}`;
+                    }
+                }
+
                 // Check for pressure pot status updates
                 else if (messageText.startsWith('PRESSURE_POT_STATUS:')) {
                     const status = messageText.split(':')[1];
@@ -1021,6 +1154,7 @@ const char HTML_PROGMEM[] PROGMEM = R"rawliteral(
             const paintSide4Btn = document.getElementById('paintSide4Btn');
             const paintAllSidesBtn = document.getElementById('paintAllSidesBtn');
             const paintMultipleCoatsBtn = document.getElementById('paintMultipleCoatsBtn'); // Added
+            const paintTrayBtn = document.getElementById('paintTrayBtn');
             const homeBtn = document.getElementById('homeBtn');
             const cleanGunBtn = document.getElementById('cleanGunBtn');
             const pnpButton = document.getElementById('pnpButton'); // Assuming this is the start PnP button
@@ -1037,10 +1171,26 @@ const char HTML_PROGMEM[] PROGMEM = R"rawliteral(
             if (paintSide4Btn) paintSide4Btn.disabled = !isIdle; // Only from IDLE
             if (paintAllSidesBtn) paintAllSidesBtn.disabled = !isIdle; // Only from IDLE
             if (paintMultipleCoatsBtn) paintMultipleCoatsBtn.disabled = !isIdle; // Only from IDLE
+            if (paintTrayBtn) paintTrayBtn.disabled = !isIdle; // Only from IDLE
             if (homeBtn) homeBtn.disabled = !isIdle && !(stateName === 'ERROR'); // Allow homing from IDLE or ERROR state
             if (cleanGunBtn) cleanGunBtn.disabled = !isIdle; // Only from IDLE
             if (pnpButton) pnpButton.disabled = !isIdle; // Only from IDLE to start PnP cycle
 
+            // Pause/Resume for All Sides jobs
+            const pauseBtn = document.getElementById('pauseBtn');
+            const resumeBtn = document.getElementById('resumeBtn');
+            if (pauseBtn) pauseBtn.disabled = (stateName !== 'PAINTING');
+            if (resumeBtn) resumeBtn.disabled = (stateName !== 'PAUSED');
+            if (homeBtn && stateName === 'PAUSED') homeBtn.disabled = false; // Homing discards the paused job
+
+            // Resume offer only applies while IDLE
+            const resumeJobBanner = document.getElementById('resumeJobBanner');
+            if (resumeJobBanner && !isIdle) resumeJobBanner.style.display = 'none';
+
+            // Dry window progress only applies while PAINTING
+            const dryWindowDisplay = document.getElementById('dryWindowDisplay');
+            if (dryWindowDisplay && stateName !== 'PAINTING') dryWindowDisplay.style.display = 'none';
+
             // Manual Control Elements
             const manualXInput = document.getElementById('manualX');
             const manualYInput = document.getElementById('manualY');
@@ -1237,18 +1387,44 @@ const char HTML_PROGMEM[] PROGMEM = R"rawliteral(
             }
         }
 
+        // Dry run of the active tray with the values currently in the PNP settings form (not saved)
+        function runPnpBenchmark() {
+            const payload = { command: "RUN_PNP_BENCHMARK" };
+            ['pnp_x_speed', 'pnp_x_accel', 'pnp_y_speed', 'pnp_y_accel',
+             'pnp_loaded_x_speed', 'pnp_loaded_x_accel', 'pnp_loaded_y_speed', 'pnp_loaded_y_accel'].forEach(function(id) {
+                const value = parseInt(document.getElementById(id).value);
+                if (!isNaN(value)) payload[id] = value;
+            });
+            const interval = parseInt(document.getElementById('pnpBenchmarkInterval').value);
+            payload.partIntervalMs = isNaN(interval) ? 0 : interval;
+
+            if (websocket.readyState === WebSocket.OPEN) {
+                websocket.send(JSON.stringify(payload));
+            } else {
+                console.error("WebSocket not connected");
+            }
+        }
+
         function updatePnpSettings() {
             const pnpXSpeed = document.getElementById('pnp_x_speed').value;
             const pnpXAccel = document.getElementById('pnp_x_accel').value;
             const pnpYSpeed = document.getElementById('pnp_y_speed').value;
             const pnpYAccel = document.getElementById('pnp_y_accel').value;
+            const pnpLoadedXSpeed = document.getElementById('pnp_loaded_x_speed').value;
+            const pnpLoadedXAccel = document.getElementById('pnp_loaded_x_accel').value;
+            const pnpLoadedYSpeed = document.getElementById('pnp_loaded_y_speed').value;
+            const pnpLoadedYAccel = document.getElementById('pnp_loaded_y_accel').value;
             
             const payload = {
                 command: "update_pnp_settings",
                 pnp_x_speed: parseInt(pnpXSpeed),
                 pnp_x_accel: parseInt(pnpXAccel),
                 pnp_y_speed: parseInt(pnpYSpeed),
-                pnp_y_accel: parseInt(pnpYAccel)
+                pnp_y_accel: parseInt(pnpYAccel),
+                pnp_loaded_x_speed: parseInt(pnpLoadedXSpeed),
+                pnp_loaded_x_accel: parseInt(pnpLoadedXAccel),
+                pnp_loaded_y_speed: parseInt(pnpLoadedYSpeed),
+                pnp_loaded_y_accel: parseInt(pnpLoadedYAccel)
             };
             
             if (websocket.readyState === WebSocket.OPEN) {
@@ -1259,6 +1435,76 @@ const char HTML_PROGMEM[] PROGMEM = R"rawliteral(
             }
         }
 
+        // Tray layouts received from the ESP32, keyed by slot index
+        let trayLayouts = {};
+        let trayActiveLayout = 0;
+        let trayOccupiedMask = 0;
+
+        // Cell numbers set in a 32-bit cell mask
+        function trayMaskToCells(mask) {
+            const cells = [];
+            for (let cell = 0; cell < 32; cell++) {
+                if ((mask >>> cell) & 1) cells.push(cell);
+            }
+            return cells;
+        }
+
+        function showTrayLayout() {
+            const slot = parseInt(document.getElementById('tray_slot').value);
+            const layout = trayLayouts[slot] || { name: "", cols: 1, rows: 1, originX: 0, originY: 0, pitchX: 0, pitchY: 0, mask: 0 };
+            document.getElementById('tray_name').value = layout.name;
+            document.getElementById('tray_cols').value = layout.cols;
+            document.getElementById('tray_rows').value = layout.rows;
+            document.getElementById('tray_origin_x').value = layout.originX;
+            document.getElementById('tray_origin_y').value = layout.originY;
+            document.getElementById('tray_pitch_x').value = layout.pitchX;
+            document.getElementById('tray_pitch_y').value = layout.pitchY;
+            document.getElementById('tray_cells').value = trayMaskToCells(layout.mask).join(',');
+            document.getElementById('tray_occupied').textContent =
+                slot === trayActiveLayout ? (trayMaskToCells(trayOccupiedMask).join(',') || 'none') : '-';
+            const active = trayLayouts[trayActiveLayout];
+            document.getElementById('trayActiveLabel').textContent = active ? ('Active: ' + active.name) : '';
+        }
+
+        function saveTrayLayout() {
+            let mask = 0;
+            document.getElementById('tray_cells').value.split(',').forEach(function(part) {
+                const cell = parseInt(part);
+                if (!isNaN(cell) && cell >= 0 && cell < 32) mask = (mask | (1 << cell)) >>> 0;
+            });
+            const payload = {
+                command: "SAVE_TRAY_LAYOUT",
+                index: parseInt(document.getElementById('tray_slot').value),
+                name: document.getElementById('tray_name').value,
+                cols: parseInt(document.getElementById('tray_cols').value),
+                rows: parseInt(document.getElementById('tray_rows').value),
+                originX: parseFloat(document.getElementById('tray_origin_x').value),
+                originY: parseFloat(document.getElementById('tray_origin_y').value),
+                pitchX: parseFloat(document.getElementById('tray_pitch_x').value),
+                pitchY: parseFloat(document.getElementById('tray_pitch_y').value),
+                mask: mask
+            };
+            if (websocket.readyState === WebSocket.OPEN) {
+                websocket.send(JSON.stringify(payload));
+            }
+        }
+
+        function setTrayPaintOffset() {
+            if (websocket.readyState === WebSocket.OPEN) {
+                websocket.send(JSON.stringify({
+                    command: "SET_TRAY_PAINT_OFFSET",
+                    offsetX: parseFloat(document.getElementById('tray_paint_offset_x').value) || 0,
+                    offsetY: parseFloat(document.getElementById('tray_paint_offset_y').value) || 0
+                }));
+            }
+        }
+
+        function selectTrayLayout() {
+            if (websocket.readyState === WebSocket.OPEN) {
+                websocket.send(JSON.stringify({ command: "SELECT_TRAY_LAYOUT", index: parseInt(document.getElementById('tray_slot').value) }));
+            }
+        }
+
         function initPnpSettings() {
             // Request current PNP settings from the ESP32
             if (websocket && websocket.readyState === WebSocket.OPEN) {
@@ -1298,7 +1544,8 @@ const char HTML_PROGMEM[] PROGMEM = R"rawliteral(
             sendCommand(command);
         }
 
-        function paintMultipleCoats() {
+        // mode: 'PAINT_MULTIPLE_COATS' (fixtures) or 'PAINT_TRAY' (cells filled by PnP)
+        function paintMultipleCoats(mode = 'PAINT_MULTIPLE_COATS') {
             const numCoatsInput = document.getElementById('numCoats');
             const interCoatDelayInput = document.getElementById('interCoatDelay'); // New
 
@@ -1323,7 +1570,7 @@ const char HTML_PROGMEM[] PROGMEM = R"rawliteral(
                 return;
             }
 
-            const command = `PAINT_MULTIPLE_COATS:${numCoatsInt}:${interCoatDelayInt}`; // Updated command
+            const command = `${mode}:${numCoatsInt}:${interCoatDelayInt}`; // Updated command
             sendCommand(command);
             console.log("Sending command: " + command);
         }
@@ -1369,6 +1616,20 @@ const char HTML_PROGMEM[] PROGMEM = R"rawliteral(
 <body>
     <!-- Machine Status Display -->
     <div id="machineStatusDisplay">Machine status will appear here...</div>
+    <div id="telemetryDisplay"></div>
+
+    <!-- Unfinished job left by a reset -->
+    <div id="resumeJobBanner" style="display: none;">
+        <span id="resumeJobText">Unfinished paint job found.</span>
+        <button class="main-btn highlight" onclick="sendCommand('RESUME_JOB')">RESUME JOB</button>
+        <button class="main-btn" onclick="sendCommand('DISCARD_JOB')">DISCARD</button>
+    </div>
+
+    <!-- Inter-coat dry window progress -->
+    <div id="dryWindowDisplay" style="display: none;">
+        <span id="dryWindowText">Drying...</span>
+        <progress id="dryWindowProgress" value="0" max="1"></progress>
+    </div>
 
     <!-- Main Controls Container -->
     <div class="top-controls-container">
@@ -1459,6 +1720,9 @@ const char HTML_PROGMEM[] PROGMEM = R"rawliteral(
                         </span>
                         <span class="btn-label">PAINT MULTIPLE COATS</span>
                     </button>
+                    <button id="paintTrayBtn" class="main-btn highlight" title="Paint every part placed by the last PnP run" aria-label="Paint Whole Tray" onclick="paintMultipleCoats('PAINT_TRAY')">
+                        <span class="btn-label">PAINT WHOLE TRAY</span>
+                    </button>
                 </div> <!-- multiple-coats-controls div now closes AFTER the button -->
             </div>
 
@@ -1476,6 +1740,23 @@ const char HTML_PROGMEM[] PROGMEM = R"rawliteral(
                     </span>
                     <span class="btn-label">HOME</span>
                 </button>
+                <button id="pauseBtn" class="main-btn blue" title="Pause Paint Job After Current Pass" aria-label="Pause" onclick="sendCommand('PAUSE')" disabled>
+                    <span class="btn-icon" aria-hidden="true">
+                        <svg width="24" height="24" viewBox="0 0 24 24" fill="none" xmlns="http://www.w3.org/2000/svg">
+                            <path d="M9 5V19" stroke="currentColor" stroke-width="2.5" stroke-linecap="round"/>
+                            <path d="M15 5V19" stroke="currentColor" stroke-width="2.5" stroke-linecap="round"/>
+                        </svg>
+                    </span>
+                    <span class="btn-label">PAUSE</span>
+                </button>
+                <button id="resumeBtn" class="main-btn blue" title="Resume Paused Paint Job" aria-label="Resume" onclick="sendCommand('RESUME')" disabled>
+                    <span class="btn-icon" aria-hidden="true">
+                        <svg width="24" height="24" viewBox="0 0 24 24" fill="none" xmlns="http://www.w3.org/2000/svg">
+                            <path d="M7 5L19 12L7 19V5Z" stroke="currentColor" stroke-width="2" stroke-linejoin="round"/>
+                        </svg>
+                    </span>
+                    <span class="btn-label">RESUME</span>
+                </button>
                 <button id="cleanGunBtn" class="main-btn blue" title="Clean Paint Gun" aria-label="Clean Gun" onclick="sendCommand('CLEAN_GUN')">
                     <span class="btn-icon" aria-hidden="true">
                         <svg width="24" height="24" viewBox="0 0 24 24" fill="none" xmlns="http://www.w3.org/2000/svg">
@@ -1571,6 +1852,7 @@ const char HTML_PROGMEM[] PROGMEM = R"rawliteral(
                 <button class="pattern-tab" id="side2TabBtn" onclick="openPatternTab('side2Tab')">Side 2 Settings</button>
                 <button class="pattern-tab" id="side3TabBtn" onclick="openPatternTab('side3Tab')">Side 3 Settings</button>
                 <button class="pattern-tab" id="side4TabBtn" onclick="openPatternTab('side4Tab')">Side 4 Settings</button>
+                <button class="pattern-tab" id="fixturesTabBtn" onclick="openPatternTab('fixturesTab')">Fixtures</button>
             </div>
             
             <div class="main-divider"></div>
@@ -1731,6 +2013,40 @@ const char HTML_PROGMEM[] PROGMEM = R"rawliteral(
                 </div>
             </div>
             
+            <!-- Fixtures Tab Content (offsets in inches from fixture 1) -->
+            <div class="pattern-tab-content" id="fixturesTab">
+                <div class="pattern-settings-grid">
+                    <div class="pattern-setting-group">
+                        <h3>Fixture 2</h3>
+                        <div class="setting-inputs labeled-inputs">
+                            <label for="fixture2Enabled">On:</label>
+                            <select id="fixture2Enabled" class="setting-input" onchange="updatePatternSetting('FIXTURE2ENABLED', this.value)">
+                                <option value="0">No</option>
+                                <option value="1">Yes</option>
+                            </select>
+                            <label for="fixture2OffsetX">X:</label>
+                            <input type="number" id="fixture2OffsetX" class="setting-input" min="-37" max="37" step="0.1" placeholder="0.0" onchange="updatePatternSetting('FIXTURE2OFFSETX', this.value)">
+                            <label for="fixture2OffsetY">Y:</label>
+                            <input type="number" id="fixture2OffsetY" class="setting-input" min="-37" max="37" step="0.1" placeholder="0.0" onchange="updatePatternSetting('FIXTURE2OFFSETY', this.value)">
+                        </div>
+                    </div>
+                    <div class="pattern-setting-group">
+                        <h3>Fixture 3</h3>
+                        <div class="setting-inputs labeled-inputs">
+                            <label for="fixture3Enabled">On:</label>
+                            <select id="fixture3Enabled" class="setting-input" onchange="updatePatternSetting('FIXTURE3ENABLED', this.value)">
+                                <option value="0">No</option>
+                                <option value="1">Yes</option>
+                            </select>
+                            <label for="fixture3OffsetX">X:</label>
+                            <input type="number" id="fixture3OffsetX" class="setting-input" min="-37" max="37" step="0.1" placeholder="0.0" onchange="updatePatternSetting('FIXTURE3OFFSETX', this.value)">
+                            <label for="fixture3OffsetY">Y:</label>
+                            <input type="number" id="fixture3OffsetY" class="setting-input" min="-37" max="37" step="0.1" placeholder="0.0" onchange="updatePatternSetting('FIXTURE3OFFSETY', this.value)">
+                        </div>
+                    </div>
+                </div>
+            </div>
+
             <div class="main-divider"></div>
             
             <!-- Settings Controls -->
@@ -1753,7 +2069,7 @@ const char HTML_PROGMEM[] PROGMEM = R"rawliteral(
         <div class="pattern-settings-content-wrapper" id="pnpSettingsContent">
             <div class="pattern-settings-grid">
                 <div class="pattern-setting-group">
-                    <h3>X Axis</h3>
+                    <h3>X Axis (Unloaded)</h3>
                     <div class="setting-inputs labeled-inputs">
                         <label for="pnp_x_speed">Speed (steps/s):</label>
                         <input type="number" id="pnp_x_speed" class="setting-input" min="1000" max="30000" step="500" placeholder="10000">
@@ -1762,7 +2078,7 @@ const char HTML_PROGMEM[] PROGMEM = R"rawliteral(
                     </div>
                 </div>
                 <div class="pattern-setting-group">
-                    <h3>Y Axis</h3>
+                    <h3>Y Axis (Unloaded)</h3>
                     <div class="setting-inputs labeled-inputs">
                         <label for="pnp_y_speed">Speed (steps/s):</label>
                         <input type="number" id="pnp_y_speed" class="setting-input" min="1000" max="35000" step="500" placeholder="25000">
@@ -1770,6 +2086,24 @@ const char HTML_PROGMEM[] PROGMEM = R"rawliteral(
                         <input type="number" id="pnp_y_accel" class="setting-input" min="1000" max="35000" step="500" placeholder="32000">
                     </div>
                 </div>
+                <div class="pattern-setting-group">
+                    <h3>X Axis (Loaded)</h3>
+                    <div class="setting-inputs labeled-inputs">
+                        <label for="pnp_loaded_x_speed">Speed (steps/s):</label>
+                        <input type="number" id="pnp_loaded_x_speed" class="setting-input" min="1000" max="30000" step="500" placeholder="20000">
+                        <label for="pnp_loaded_x_accel">Accel (steps/s²):</label>
+                        <input type="number" id="pnp_loaded_x_accel" class="setting-input" min="1000" max="30000" step="500" placeholder="20000">
+                    </div>
+                </div>
+                <div class="pattern-setting-group">
+                    <h3>Y Axis (Loaded)</h3>
+                    <div class="setting-inputs labeled-inputs">
+                        <label for="pnp_loaded_y_speed">Speed (steps/s):</label>
+                        <input type="number" id="pnp_loaded_y_speed" class="setting-input" min="1000" max="35000" step="500" placeholder="30000">
+                        <label for="pnp_loaded_y_accel">Accel (steps/s²):</label>
+                        <input type="number" id="pnp_loaded_y_accel" class="setting-input" min="1000" max="35000" step="500" placeholder="30000">
+                    </div>
+                </div>
             </div>
             
             <div class="main-divider"></div>
@@ -1780,6 +2114,110 @@ const char HTML_PROGMEM[] PROGMEM = R"rawliteral(
             </div>
         </div>
     </div>
+
+    <!-- PNP Cycle Statistics Section -->
+    <div class="pattern-settings-container">
+        <h2 class="pattern-settings-header">
+            PNP Cycle Statistics
+        </h2>
+
+        <div class="pattern-settings-content-wrapper">
+            <table class="pnp-stats-table">
+                <thead>
+                    <tr><th>Phase</th><th>n</th><th>Min (ms)</th><th>Avg (ms)</th><th>Max (ms)</th><th>p95 (ms)</th></tr>
+                </thead>
+                <tbody id="pnpStatsBody"></tbody>
+            </table>
+
+            <div class="main-divider"></div>
+
+            <div class="settings-controls">
+                <span id="pnpStatsCycles"></span>
+                <button class="main-btn" onclick="websocket.send(JSON.stringify({ command: 'GET_PNP_STATS' }))">Refresh</button>
+                <button class="main-btn" onclick="websocket.send(JSON.stringify({ command: 'RESET_PNP_STATS' }))">Reset</button>
+            </div>
+
+            <div class="main-divider"></div>
+
+            <!-- Dry run of the active tray with the PNP settings form values -->
+            <div class="settings-controls">
+                <label for="pnpBenchmarkInterval">Part interval (ms, 0 = always ready):</label>
+                <input type="number" id="pnpBenchmarkInterval" class="setting-input" min="0" step="100" value="0">
+                <button class="main-btn" onclick="runPnpBenchmark()">Benchmark</button>
+            </div>
+            <div id="pnpBenchmarkLabel"></div>
+        </div>
+    </div>
+
+    <!-- PNP Tray Layout Section -->
+    <div class="pattern-settings-container">
+        <h2 id="trayLayoutHeader" class="pattern-settings-header">
+            PNP Tray Layout
+        </h2>
+
+        <div class="pattern-settings-content-wrapper" id="trayLayoutContent">
+            <div class="pattern-settings-grid">
+                <div class="pattern-setting-group">
+                    <h3>Layout</h3>
+                    <div class="setting-inputs labeled-inputs">
+                        <label for="tray_slot">Slot:</label>
+                        <select id="tray_slot" class="setting-input" onchange="showTrayLayout()">
+                            <option value="0">1</option>
+                            <option value="1">2</option>
+                            <option value="2">3</option>
+                            <option value="3">4</option>
+                        </select>
+                        <label for="tray_name">Name:</label>
+                        <input type="text" id="tray_name" class="setting-input" maxlength="15">
+                        <label for="tray_cols">Columns:</label>
+                        <input type="number" id="tray_cols" class="setting-input" min="1" max="32" step="1">
+                        <label for="tray_rows">Rows:</label>
+                        <input type="number" id="tray_rows" class="setting-input" min="1" max="32" step="1">
+                    </div>
+                </div>
+                <div class="pattern-setting-group">
+                    <h3>Geometry (inches)</h3>
+                    <div class="setting-inputs labeled-inputs">
+                        <label for="tray_origin_x">Origin X:</label>
+                        <input type="number" id="tray_origin_x" class="setting-input" step="0.01">
+                        <label for="tray_origin_y">Origin Y:</label>
+                        <input type="number" id="tray_origin_y" class="setting-input" step="0.01">
+                        <label for="tray_pitch_x">Pitch X:</label>
+                        <input type="number" id="tray_pitch_x" class="setting-input" min="0" step="0.01">
+                        <label for="tray_pitch_y">Pitch Y:</label>
+                        <input type="number" id="tray_pitch_y" class="setting-input" min="0" step="0.01">
+                    </div>
+                </div>
+                <div class="pattern-setting-group">
+                    <h3>Placements</h3>
+                    <div class="setting-inputs labeled-inputs">
+                        <label for="tray_cells">Cells (e.g. 1,3,5):</label>
+                        <input type="text" id="tray_cells" class="setting-input">
+                        <label>Occupied:</label>
+                        <span id="tray_occupied"></span>
+                    </div>
+                </div>
+                <div class="pattern-setting-group">
+                    <h3>Tray Painting (inches)</h3>
+                    <div class="setting-inputs labeled-inputs">
+                        <label for="tray_paint_offset_x">Cell 0 from Fixture 1 X:</label>
+                        <input type="number" id="tray_paint_offset_x" class="setting-input" step="0.01" onchange="setTrayPaintOffset()">
+                        <label for="tray_paint_offset_y">Cell 0 from Fixture 1 Y:</label>
+                        <input type="number" id="tray_paint_offset_y" class="setting-input" step="0.01" onchange="setTrayPaintOffset()">
+                    </div>
+                </div>
+            </div>
+
+            <div class="main-divider"></div>
+
+            <div class="settings-controls">
+                <span id="trayActiveLabel"></span>
+                <span id="pnpPlanLabel"></span>
+                <button class="main-btn" onclick="saveTrayLayout()">Save Layout</button>
+                <button class="main-btn" onclick="selectTrayLayout()">Use This Layout</button>
+            </div>
+        </div>
+    </div>
 </body>
 </html>
 )rawliteral";
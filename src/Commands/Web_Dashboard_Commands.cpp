@@ -26,6 +26,19 @@
 #include "states/IdleState.h" // Include IdleState for comparison
 #include "settings/motion.h" // Include for default PNP values
 #include "states/CleaningState.h" // Include for setShortMode
+#include "states/PausedState.h" // Include for requestResume
+#include "system/PaintProgress.h" // For PAUSE/RESUME of All Sides jobs
+#include "storage/ProgressJournal.h" // For resuming jobs interrupted by a reset
+#include "system/RetainedPositions.h" // For RESTART without re-homing
+#include "system/Fixtures.h" // For fixture offsets of pipelined jobs
+#include "storage/TrayLayouts.h" // For PnP tray layout selection
+#include "system/PnPStats.h" // For GET_PNP_STATS
+#include "system/PnPTiming.h" // For RUN_PNP_BENCHMARK
+#include "system/NetworkTask.h" // Command/outbound queues between the cores
+#include "system/MotionAbort.h" // HOME aborts
+#include "system/Telemetry.h" // State name for new clients, updates during blocking moves
+#include "system/Supervisor.h" // For GET_SUPERVISOR
+#include "system/Logger.h" // For SET_LOG_LEVEL
 #include <limits.h> // ADDED For LONG_MIN, INT_MIN
 
 // --- PNP Settings Keys for NVS ---
@@ -33,13 +46,23 @@
 #define PNP_X_ACCEL_KEY "pnpXAcc"
 #define PNP_Y_SPEED_KEY "pnpYSpd"
 #define PNP_Y_ACCEL_KEY "pnpYAcc"
+#define PNP_LOADED_X_SPEED_KEY "pnpLXSpd"
+#define PNP_LOADED_X_ACCEL_KEY "pnpLXAcc"
+#define PNP_LOADED_Y_SPEED_KEY "pnpLYSpd"
+#define PNP_LOADED_Y_ACCEL_KEY "pnpLYAcc"
 
-// Global variables for PNP settings
+// Global variables for PNP settings (unloaded moves)
 float g_pnp_x_speed = DEFAULT_PNP_X_SPEED;
 float g_pnp_x_accel = DEFAULT_PNP_X_ACCEL;
 float g_pnp_y_speed = DEFAULT_PNP_Y_SPEED;
 float g_pnp_y_accel = DEFAULT_PNP_Y_ACCEL;
 
+// Loaded move (pick to place, part on the vacuum cup)
+float g_pnp_loaded_x_speed = DEFAULT_PNP_LOADED_X_SPEED;
+float g_pnp_loaded_x_accel = DEFAULT_PNP_LOADED_X_ACCEL;
+float g_pnp_loaded_y_speed = DEFAULT_PNP_LOADED_Y_SPEED;
+float g_pnp_loaded_y_accel = DEFAULT_PNP_LOADED_Y_ACCEL;
+
 // Global variable to store requested number of coats for All Sides painting
 extern int g_requestedCoats; // Declaration added
 extern int g_interCoatDelaySeconds; // ADDED: For delay between coats
@@ -54,6 +77,10 @@ void savePnpSettingsToNVS() {
     persistence.saveFloat(PNP_X_ACCEL_KEY, g_pnp_x_accel);
     persistence.saveFloat(PNP_Y_SPEED_KEY, g_pnp_y_speed);
     persistence.saveFloat(PNP_Y_ACCEL_KEY, g_pnp_y_accel);
+    persistence.saveFloat(PNP_LOADED_X_SPEED_KEY, g_pnp_loaded_x_speed);
+    persistence.saveFloat(PNP_LOADED_X_ACCEL_KEY, g_pnp_loaded_x_accel);
+    persistence.saveFloat(PNP_LOADED_Y_SPEED_KEY, g_pnp_loaded_y_speed);
+    persistence.saveFloat(PNP_LOADED_Y_ACCEL_KEY, g_pnp_loaded_y_accel);
     persistence.endTransaction(); // Close NVS
     Serial.println("PNP motion settings saved to NVS.");
 }
@@ -64,10 +91,16 @@ void loadPnpSettingsFromNVS() {
     g_pnp_x_accel = persistence.loadFloat(PNP_X_ACCEL_KEY, DEFAULT_PNP_X_ACCEL);
     g_pnp_y_speed = persistence.loadFloat(PNP_Y_SPEED_KEY, DEFAULT_PNP_Y_SPEED);
     g_pnp_y_accel = persistence.loadFloat(PNP_Y_ACCEL_KEY, DEFAULT_PNP_Y_ACCEL);
+    g_pnp_loaded_x_speed = persistence.loadFloat(PNP_LOADED_X_SPEED_KEY, DEFAULT_PNP_LOADED_X_SPEED);
+    g_pnp_loaded_x_accel = persistence.loadFloat(PNP_LOADED_X_ACCEL_KEY, DEFAULT_PNP_LOADED_X_ACCEL);
+    g_pnp_loaded_y_speed = persistence.loadFloat(PNP_LOADED_Y_SPEED_KEY, DEFAULT_PNP_LOADED_Y_SPEED);
+    g_pnp_loaded_y_accel = persistence.loadFloat(PNP_LOADED_Y_ACCEL_KEY, DEFAULT_PNP_LOADED_Y_ACCEL);
     persistence.endTransaction(); // Close NVS
     Serial.println("PNP motion settings loaded from NVS.");
     Serial.printf("Loaded PNP Settings: X_Speed=%.0f, X_Accel=%.0f, Y_Speed=%.0f, Y_Accel=%.0f\\n",
                   g_pnp_x_speed, g_pnp_x_accel, g_pnp_y_speed, g_pnp_y_accel);
+    Serial.printf("Loaded PNP Loaded Profile: X_Speed=%.0f, X_Accel=%.0f, Y_Speed=%.0f, Y_Accel=%.0f\n",
+                  g_pnp_loaded_x_speed, g_pnp_loaded_x_accel, g_pnp_loaded_y_speed, g_pnp_loaded_y_accel);
 }
 
 //* ************************************************************************
@@ -166,6 +199,53 @@ const char* response_html = R"rawliteral(
 </html>
 )rawliteral";
 
+static String resumeAvailableMessage(uint8_t coat, uint8_t totalCoats, uint8_t side, uint8_t pass) {
+    return "RESUME_AVAILABLE:" + String(coat) + "," + String(totalCoats) + "," + String(side) + "," + String(pass + 1);
+}
+
+// Tell clients that a job interrupted by a reset can be resumed (clientNum < 0 broadcasts).
+// Controller only: it reads the journal
+void sendResumeAvailable(int clientNum) {
+    if (!progressJournal.hasResumableJob()) {
+        return;
+    }
+    const JournalRecord& job = progressJournal.resumableJob();
+    String message = resumeAvailableMessage(job.coat, job.totalCoats, job.side, job.pass);
+    if (clientNum < 0) {
+        webBroadcastTXT(message);
+    } else {
+        webSendTXT((uint8_t)clientNum, message);
+    }
+}
+
+// Send all defined tray layouts and the active selection to one client
+void sendTrayLayouts(uint8_t num) {
+    JsonDocument doc;
+    doc["event"] = "tray_layouts";
+    doc["active"] = trayLayouts.activeIndex();
+    doc["occupied"] = trayLayouts.occupiedCells();
+    doc["paintOffsetX"] = trayLayouts.paintOffsetX();
+    doc["paintOffsetY"] = trayLayouts.paintOffsetY();
+    JsonArray layouts = doc["layouts"].to<JsonArray>();
+    for (int i = 0; i < MAX_TRAY_LAYOUTS; ++i) {
+        if (!trayLayouts.isDefined(i)) continue;
+        const TrayLayout& layout = trayLayouts.layout(i);
+        JsonObject entry = layouts.add<JsonObject>();
+        entry["index"] = i;
+        entry["name"] = layout.name;
+        entry["cols"] = layout.cols;
+        entry["rows"] = layout.rows;
+        entry["originX"] = layout.originX;
+        entry["originY"] = layout.originY;
+        entry["pitchX"] = layout.pitchX;
+        entry["pitchY"] = layout.pitchY;
+        entry["mask"] = layout.placementMask;
+    }
+    String output;
+    serializeJson(doc, output);
+    webSendTXT(num, output);
+}
+
 // WebSocket event handler
 void webSocketEvent(uint8_t num, WStype_t type, uint8_t * payload, size_t length) {
   switch(type) {
@@ -179,27 +259,32 @@ void webSocketEvent(uint8_t num, WStype_t type, uint8_t * payload, size_t length
         Serial.printf("[WS] Client #%u connected from %d.%d.%d.%d\n", num, ip[0], ip[1], ip[2], ip[3]);
         
         // --- Send current state to newly connected client --- 
-        if (stateMachine && stateMachine->getCurrentState()) {
+        Telemetry telemetry;
+        bool published = telemetryRead(telemetry);
+        if (published) {
             String stateMessage = "STATE:";
-            stateMessage += stateMachine->getCurrentState()->getName();
-            webSocket.sendTXT(num, stateMessage);
+            stateMessage += telemetry.state;
+            webSendTXT(num, stateMessage);
             Serial.print("Sent current state to client #");
             Serial.print(num);
             Serial.print(": ");
             Serial.println(stateMessage);
         } else {
             Serial.println("[WS] Could not send initial state: StateMachine or current state is null.");
-            webSocket.sendTXT(num, "STATE:UNKNOWN"); // Send a default
+            webSendTXT(num, "STATE:UNKNOWN"); // Send a default
+        }
+        // From the snapshot: the journal belongs to the controller
+        if (published && telemetry.resumeAvailable && strcmp(telemetry.state, "IDLE") == 0) {
+            webSendTXT(num, resumeAvailableMessage(telemetry.resumeCoat, telemetry.resumeTotalCoats,
+                                                   telemetry.resumeSide, telemetry.resumePass));
         }
         // ------------------------------------------------------
       }
       break;
     
     case WStype_TEXT:
-      {
-        String command = String((char*)payload);
-        processWebCommand(&webSocket, num, command); 
-      }
+      // Runs in the network task: hand the command to the motion side
+      webEnqueueCommand(num, payload, length);
       break;
       
     case WStype_BIN:
@@ -237,6 +322,10 @@ void processWebCommand(WebSocketsServer* webSocket, uint8_t num, String commandP
                 if (doc["pnp_x_accel"].is<float>()) g_pnp_x_accel = doc["pnp_x_accel"].as<float>();
                 if (doc["pnp_y_speed"].is<float>()) g_pnp_y_speed = doc["pnp_y_speed"].as<float>();
                 if (doc["pnp_y_accel"].is<float>()) g_pnp_y_accel = doc["pnp_y_accel"].as<float>();
+                if (doc["pnp_loaded_x_speed"].is<float>()) g_pnp_loaded_x_speed = doc["pnp_loaded_x_speed"].as<float>();
+                if (doc["pnp_loaded_x_accel"].is<float>()) g_pnp_loaded_x_accel = doc["pnp_loaded_x_accel"].as<float>();
+                if (doc["pnp_loaded_y_speed"].is<float>()) g_pnp_loaded_y_speed = doc["pnp_loaded_y_speed"].as<float>();
+                if (doc["pnp_loaded_y_accel"].is<float>()) g_pnp_loaded_y_accel = doc["pnp_loaded_y_accel"].as<float>();
                 
                 Serial.printf("Updated PNP Settings (in memory): X_Speed=%.0f, X_Accel=%.0f, Y_Speed=%.0f, Y_Accel=%.0f\n", 
                               g_pnp_x_speed, g_pnp_x_accel, g_pnp_y_speed, g_pnp_y_accel);
@@ -249,10 +338,14 @@ void processWebCommand(WebSocketsServer* webSocket, uint8_t num, String commandP
                 pnpSettingsDoc["pnp_x_accel"] = g_pnp_x_accel;
                 pnpSettingsDoc["pnp_y_speed"] = g_pnp_y_speed;
                 pnpSettingsDoc["pnp_y_accel"] = g_pnp_y_accel;
+                pnpSettingsDoc["pnp_loaded_x_speed"] = g_pnp_loaded_x_speed;
+                pnpSettingsDoc["pnp_loaded_x_accel"] = g_pnp_loaded_x_accel;
+                pnpSettingsDoc["pnp_loaded_y_speed"] = g_pnp_loaded_y_speed;
+                pnpSettingsDoc["pnp_loaded_y_accel"] = g_pnp_loaded_y_accel;
                 
                 String output;
                 serializeJson(pnpSettingsDoc, output);
-                webSocket->sendTXT(num, output);
+                webSendTXT(num, output);
                 Serial.println("Sent current PNP settings to client after update.");
                 return; // Command processed
             } else if (json_command_field.equalsIgnoreCase("GET_PNP_SETTINGS")) {
@@ -262,12 +355,131 @@ void processWebCommand(WebSocketsServer* webSocket, uint8_t num, String commandP
                 settings_doc["pnp_x_accel"] = g_pnp_x_accel;
                 settings_doc["pnp_y_speed"] = g_pnp_y_speed;
                 settings_doc["pnp_y_accel"] = g_pnp_y_accel;
+                settings_doc["pnp_loaded_x_speed"] = g_pnp_loaded_x_speed;
+                settings_doc["pnp_loaded_x_accel"] = g_pnp_loaded_x_accel;
+                settings_doc["pnp_loaded_y_speed"] = g_pnp_loaded_y_speed;
+                settings_doc["pnp_loaded_y_accel"] = g_pnp_loaded_y_accel;
                 
                 String output;
                 serializeJson(settings_doc, output);
-                webSocket->sendTXT(num, output);
+                webSendTXT(num, output);
                 Serial.println("Sent current PNP settings to client on request.");
                 return; // Command processed
+            } else if (json_command_field.equalsIgnoreCase("GET_PNP_STATS") ||
+                       json_command_field.equalsIgnoreCase("RESET_PNP_STATS")) {
+                if (json_command_field.equalsIgnoreCase("RESET_PNP_STATS")) {
+                    pnpStatsReset();
+                    Serial.println("PnP statistics reset.");
+                }
+                JsonDocument statsDoc;
+                pnpStatsToJson(statsDoc);
+                String output;
+                serializeJson(statsDoc, output);
+                webSendTXT(num, output);
+                return; // Command processed
+            } else if (json_command_field.equalsIgnoreCase("GET_SUPERVISOR") ||
+                       json_command_field.equalsIgnoreCase("RESET_SUPERVISOR")) {
+                if (json_command_field.equalsIgnoreCase("RESET_SUPERVISOR")) {
+                    supervisorReset();
+                    Serial.println("Supervisor statistics reset.");
+                }
+                JsonDocument supervisorDoc;
+                supervisorToJson(supervisorDoc);
+                String output;
+                serializeJson(supervisorDoc, output);
+                webSendTXT(num, output);
+                return; // Command processed
+            } else if (json_command_field.equalsIgnoreCase("GET_LOG_LEVEL") ||
+                       json_command_field.equalsIgnoreCase("SET_LOG_LEVEL")) {
+                if (json_command_field.equalsIgnoreCase("SET_LOG_LEVEL")) {
+                    // Either output may be omitted to keep its level
+                    LogLevel serialLevel = logSerialLevel();
+                    LogLevel webLevel = logWebLevel();
+                    if ((doc["serial"].is<const char*>() && !logParseLevel(doc["serial"].as<const char*>(), serialLevel)) ||
+                        (doc["web"].is<const char*>() && !logParseLevel(doc["web"].as<const char*>(), webLevel))) {
+                        webSendTXT(num, "CMD_ERROR: Log levels are OFF, ERROR, WARN, INFO or DEBUG.");
+                        return;
+                    }
+                    logSetLevels(serialLevel, webLevel);
+                    Serial.printf("Log levels: serial=%s web=%s\n", logLevelName(serialLevel), logLevelName(webLevel));
+                }
+                JsonDocument levelDoc;
+                levelDoc["event"] = "logLevel";
+                levelDoc["serial"] = logLevelName(logSerialLevel());
+                levelDoc["web"] = logLevelName(logWebLevel());
+                String output;
+                serializeJson(levelDoc, output);
+                webSendTXT(num, output);
+                return; // Command processed
+            } else if (json_command_field.equalsIgnoreCase("RUN_PNP_BENCHMARK")) {
+                // Dry run of the active tray; profile fields override the saved settings for this run only
+                PnPBenchmarkConfig config;
+                config.loaded = pnpLoadedProfile();
+                config.unloaded = pnpUnloadedProfile();
+                config.partIntervalMs = 0;
+                if (doc["partIntervalMs"].is<unsigned long>()) config.partIntervalMs = doc["partIntervalMs"].as<unsigned long>();
+                if (doc["pnp_x_speed"].is<float>()) config.unloaded.xSpeed = doc["pnp_x_speed"].as<float>();
+                if (doc["pnp_x_accel"].is<float>()) config.unloaded.xAccel = doc["pnp_x_accel"].as<float>();
+                if (doc["pnp_y_speed"].is<float>()) config.unloaded.ySpeed = doc["pnp_y_speed"].as<float>();
+                if (doc["pnp_y_accel"].is<float>()) config.unloaded.yAccel = doc["pnp_y_accel"].as<float>();
+                if (doc["pnp_loaded_x_speed"].is<float>()) config.loaded.xSpeed = doc["pnp_loaded_x_speed"].as<float>();
+                if (doc["pnp_loaded_x_accel"].is<float>()) config.loaded.xAccel = doc["pnp_loaded_x_accel"].as<float>();
+                if (doc["pnp_loaded_y_speed"].is<float>()) config.loaded.ySpeed = doc["pnp_loaded_y_speed"].as<float>();
+                if (doc["pnp_loaded_y_accel"].is<float>()) config.loaded.yAccel = doc["pnp_loaded_y_accel"].as<float>();
+
+                PnPBenchmarkResult result;
+                pnpBenchmarkRun(config, result);
+                Serial.printf("PnP benchmark: %d parts in %.0f ms (%.0f parts/h), travel X=%.1f in, Y=%.1f in\n",
+                              result.parts, result.totalMs, result.partsPerHour, result.travelXInches, result.travelYInches);
+                JsonDocument benchDoc;
+                pnpBenchmarkToJson(config, result, benchDoc);
+                String output;
+                serializeJson(benchDoc, output);
+                webSendTXT(num, output);
+                return; // Command processed
+            } else if (json_command_field.equalsIgnoreCase("GET_TRAY_LAYOUTS")) {
+                sendTrayLayouts(num);
+                return; // Command processed
+            } else if (json_command_field.equalsIgnoreCase("SET_TRAY_PAINT_OFFSET")) {
+                if (stateMachine && stateMachine->getCurrentState() != stateMachine->getIdleState()) {
+                    webSendTXT(num, "CMD_ERROR: Tray settings can only be changed while IDLE.");
+                    return;
+                }
+                float offsetX = doc["offsetX"].is<float>() ? doc["offsetX"].as<float>() : trayLayouts.paintOffsetX();
+                float offsetY = doc["offsetY"].is<float>() ? doc["offsetY"].as<float>() : trayLayouts.paintOffsetY();
+                trayLayouts.setPaintOffset(offsetX, offsetY);
+                Serial.printf("Tray paint offset: X=%.2f Y=%.2f\n", offsetX, offsetY);
+                sendTrayLayouts(num);
+                return; // Command processed
+            } else if (json_command_field.equalsIgnoreCase("SAVE_TRAY_LAYOUT") ||
+                       json_command_field.equalsIgnoreCase("SELECT_TRAY_LAYOUT")) {
+                if (stateMachine && stateMachine->getCurrentState() != stateMachine->getIdleState()) {
+                    webSendTXT(num, "CMD_ERROR: Tray layouts can only be changed while IDLE.");
+                    return;
+                }
+                int index = doc["index"].is<int>() ? doc["index"].as<int>() : -1;
+                bool ok;
+                if (json_command_field.equalsIgnoreCase("SAVE_TRAY_LAYOUT")) {
+                    TrayLayout layout = {};
+                    String name = doc["name"].is<const char*>() ? doc["name"].as<String>() : String("Layout");
+                    strncpy(layout.name, name.c_str(), TRAY_LAYOUT_NAME_LEN - 1);
+                    if (doc["cols"].is<int>()) layout.cols = doc["cols"].as<int>();
+                    if (doc["rows"].is<int>()) layout.rows = doc["rows"].as<int>();
+                    if (doc["originX"].is<float>()) layout.originX = doc["originX"].as<float>();
+                    if (doc["originY"].is<float>()) layout.originY = doc["originY"].as<float>();
+                    if (doc["pitchX"].is<float>()) layout.pitchX = doc["pitchX"].as<float>();
+                    if (doc["pitchY"].is<float>()) layout.pitchY = doc["pitchY"].as<float>();
+                    if (doc["mask"].is<uint32_t>()) layout.placementMask = doc["mask"].as<uint32_t>();
+                    ok = trayLayouts.saveLayout(index, layout);
+                } else {
+                    ok = trayLayouts.select(index);
+                }
+                if (!ok) {
+                    webSendTXT(num, "CMD_ERROR: Invalid tray layout.");
+                    return;
+                }
+                sendTrayLayouts(num);
+                return; // Command processed
             } else {
                 // It's a different command, but was wrapped in JSON.
                 // Use the value of the "command" field for further parsing.
@@ -278,7 +490,7 @@ void processWebCommand(WebSocketsServer* webSocket, uint8_t num, String commandP
         } else {
              // JSON was valid, but "command" field was missing or not a string.
              Serial.println("[WS] JSON received, but 'command' field is missing, null, or not a string.");
-             webSocket->sendTXT(num, "CMD_ERROR: Malformed JSON command structure.");
+             webSendTXT(num, "CMD_ERROR: Malformed JSON command structure.");
              return; // Reject this
         }
     } else {
@@ -329,11 +541,12 @@ void processWebCommand(WebSocketsServer* webSocket, uint8_t num, String commandP
          baseCommandAction == "PAINT_SIDE_2" || 
          baseCommandAction == "PAINT_SIDE_3" || 
          baseCommandAction == "PAINT_ALL_SIDES" ||
-         baseCommandAction == "PAINT_ALL_SIDES_MULTIPLE")) { // Added PAINT_ALL_SIDES_MULTIPLE here
+         baseCommandAction == "PAINT_ALL_SIDES_MULTIPLE" ||
+         baseCommandAction == "PAINT_TRAY")) { // Added PAINT_ALL_SIDES_MULTIPLE here
         Serial.print("Command ");
         Serial.print(baseCommandAction);
         Serial.println(" rejected. Machine must be in IDLE state.");
-        webSocket->sendTXT(num, "CMD_ERROR: Machine not in IDLE state.");
+        webSendTXT(num, "CMD_ERROR: Machine not in IDLE state.");
         return;
     }
 
@@ -348,54 +561,52 @@ void processWebCommand(WebSocketsServer* webSocket, uint8_t num, String commandP
     else if (baseCommandAction == "HOME_ALL") {
         // Trigger homing state
         if (stateMachine) {
-            // Force stop any running motors first
-            if (stepperX->isRunning()) stepperX->forceStopAndNewPosition(stepperX->getCurrentPosition());
-            if (stepperY_Left->isRunning()) stepperY_Left->forceStopAndNewPosition(stepperY_Left->getCurrentPosition());
-            if (stepperY_Right->isRunning()) stepperY_Right->forceStopAndNewPosition(stepperY_Right->getCurrentPosition());
-            if (stepperZ->isRunning()) stepperZ->forceStopAndNewPosition(stepperZ->getCurrentPosition());
+            // Ramp any running motors down first
+            motionAbortStopAxes();
             
-            // Set the home command received flag to interrupt any ongoing painting operations
-            homeCommandReceived = true;
+            // Request an abort to interrupt any ongoing painting operations
+            motionAbortRequest();
+            paintJobAbort(); // A running or paused paint job cannot be resumed after homing
             
-            // Change to homing state immediately
-            stateMachine->changeState(stateMachine->getHomingState());
-            webSocket->sendTXT(num, "CMD_ACK: Homing sequence initiated.");
+            // Queue the change to homing state
+            stateMachine->requestTransition(STATE_HOMING);
+            webSendTXT(num, "CMD_ACK: Homing sequence initiated.");
         } else {
-             webSocket->sendTXT(num, "CMD_ERROR: StateMachine not available.");
+             webSendTXT(num, "CMD_ERROR: StateMachine not available.");
         }
     }
     else if (baseCommandAction == "START_PNP") { // Changed command name
         // Trigger PnP state via StateMachine - NEW WAY
         Serial.println("Transitioning to PnP State via web command...");
         if (stateMachine) {
-            stateMachine->changeState(stateMachine->getPnpState());
-            webSocket->sendTXT(num, "CMD_ACK: PnP State initiated.");
+            stateMachine->requestTransition(STATE_PNP);
+            webSendTXT(num, "CMD_ACK: PnP State initiated.");
         } else {
-            webSocket->sendTXT(num, "CMD_ERROR: StateMachine not available.");
+            webSendTXT(num, "CMD_ERROR: StateMachine not available.");
         }
     }
     else if (baseCommandAction == "PAINT_GUN_ON") {
         // Turn on paint gun
         paintGun_ON();
-        webSocket->sendTXT(num, "CMD_ACK: Paint Gun ON");
+        webSendTXT(num, "CMD_ACK: Paint Gun ON");
     }
     else if (baseCommandAction == "PAINT_GUN_OFF") {
         // Turn off paint gun
         paintGun_OFF();
-        webSocket->sendTXT(num, "CMD_ACK: Paint Gun OFF");
+        webSendTXT(num, "CMD_ACK: Paint Gun OFF");
     }
     else if (baseCommandAction == "PRESSURE_POT_ON") {
         Serial.println("Turning Pressure Pot ON via web command");
         digitalWrite(PRESSURE_POT_PIN, HIGH);
         // It's good practice to also update an internal state variable if you have one for pressure pot
-        webSocket->sendTXT(num, "PRESSURE_POT_STATUS:ON"); // Send status back to UI
+        webSendTXT(num, "PRESSURE_POT_STATUS:ON"); // Send status back to UI
         Serial.printf("Pressure Pot Pin %d set to HIGH\n", PRESSURE_POT_PIN);
     }
     else if (baseCommandAction == "PRESSURE_POT_OFF") {
         Serial.println("Turning Pressure Pot OFF via web command");
         digitalWrite(PRESSURE_POT_PIN, LOW);
         // Update internal state variable if applicable
-        webSocket->sendTXT(num, "PRESSURE_POT_STATUS:OFF"); // Send status back to UI
+        webSendTXT(num, "PRESSURE_POT_STATUS:OFF"); // Send status back to UI
         Serial.printf("Pressure Pot Pin %d set to LOW\n", PRESSURE_POT_PIN);
     }
     else if (baseCommandAction == "PAINT_SIDE_1") {
@@ -403,7 +614,7 @@ void processWebCommand(WebSocketsServer* webSocket, uint8_t num, String commandP
         paintSide1Pattern(); // Call the function directly
         
         // Simplified: Assume painting starts, homing is handled by state machine or user
-        webSocket->sendTXT(num, "CMD_ACK: Paint Side 1 initiated.");
+        webSendTXT(num, "CMD_ACK: Paint Side 1 initiated.");
         // Transition to Homing state should be handled by the PaintingState or user interaction
     }
     else if (baseCommandAction == "PAINT_SIDE_2") {
@@ -411,42 +622,47 @@ void processWebCommand(WebSocketsServer* webSocket, uint8_t num, String commandP
         paintSide2Pattern(); // Call directly
         
         // Simplified: Assume painting starts, homing is handled by state machine or user
-        webSocket->sendTXT(num, "CMD_ACK: Paint Side 2 initiated.");
+        webSendTXT(num, "CMD_ACK: Paint Side 2 initiated.");
     }
     else if (baseCommandAction == "PAINT_SIDE_3") {
         Serial.println("Painting side 3...");
         paintSide3Pattern(); // Call directly
         
         // Simplified: Assume painting starts, homing is handled by state machine or user
-        webSocket->sendTXT(num, "CMD_ACK: Paint Side 3 initiated.");
+        webSendTXT(num, "CMD_ACK: Paint Side 3 initiated.");
     }
     else if (baseCommandAction == "PAINT_SIDE_4") {
         Serial.println("Painting side 4...");
         paintSide4Pattern(); // Call directly
         
         // Simplified: Assume painting starts, homing is handled by state machine or user
-        webSocket->sendTXT(num, "CMD_ACK: Paint Side 4 initiated.");
+        webSendTXT(num, "CMD_ACK: Paint Side 4 initiated.");
     }
     else if (baseCommandAction == "PAINT_ALL_SIDES") {
         Serial.println("Painting all sides (single coat request)...");
         g_requestedCoats = 1; // Explicitly set 1 coat for this command
+        g_requestedTrayJob = false;
         if (stateMachine) {
-            stateMachine->setTransitioningToPaintAllSides(true); // Set the flag
             if (stateMachine->getCleaningState()) { // Ensure cleaning state exists
                  static_cast<CleaningState*>(stateMachine->getCleaningState())->setShortMode(true); // Set short mode for initial clean
             } else {
                 Serial.println("ERROR: WebDashboard - CleaningState not available to set short mode.");
                 // Optionally, handle this error, e.g., don't proceed or log more verbosely
             }
-            stateMachine->setNextStateOverride(stateMachine->getPaintingState());
-            stateMachine->changeState(stateMachine->getCleaningState()); // Start with cleaning
-            webSocket->sendTXT(num, "CMD_ACK: Single All Sides paint sequence initiated."); // Inform user
+            stateMachine->requestTransition(STATE_CLEANING, STATE_PAINTING, true); // Start with cleaning, then paint all sides
+            webSendTXT(num, "CMD_ACK: Single All Sides paint sequence initiated."); // Inform user
         } else {
             Serial.println("ERROR: StateMachine pointer null. Cannot start Paint All Sides.");
-            webSocket->sendTXT(num, "CMD_ERROR: StateMachine not available."); // Inform user
+            webSendTXT(num, "CMD_ERROR: StateMachine not available."); // Inform user
         }
     }
-    else if (baseCommandAction.equalsIgnoreCase("PAINT_ALL_SIDES_MULTIPLE") || baseCommandAction.equalsIgnoreCase("PAINT_MULTIPLE_COATS")) { 
+    else if (baseCommandAction.equalsIgnoreCase("PAINT_ALL_SIDES_MULTIPLE") || baseCommandAction.equalsIgnoreCase("PAINT_MULTIPLE_COATS") ||
+             baseCommandAction.equalsIgnoreCase("PAINT_TRAY")) { // PAINT_TRAY: same arguments, paints the cells filled by PnP
+        bool trayJob = baseCommandAction.equalsIgnoreCase("PAINT_TRAY");
+        if (trayJob && trayLayouts.occupiedCount() == 0) {
+            webSendTXT(num, "CMD_ERROR: No occupied tray cells. Run PnP first.");
+            return;
+        }
         int numCoats = 1;
         int interCoatDelaySec = 10; // Default delay, matches HTML default
 
@@ -484,28 +700,27 @@ void processWebCommand(WebSocketsServer* webSocket, uint8_t num, String commandP
         Serial.printf("Painting all sides (%d coats, %ds delay request)...\n", numCoats, interCoatDelaySec);
         g_requestedCoats = numCoats;
         g_interCoatDelaySeconds = interCoatDelaySec; 
+        g_requestedTrayJob = trayJob;
 
         if (stateMachine) {
             // Check if machine is IDLE before starting multi-coat
             if (stateMachine->getCurrentState() == stateMachine->getIdleState()) {
-                stateMachine->setTransitioningToPaintAllSides(true); // Set the flag
                 if (stateMachine->getCleaningState()) { // Ensure cleaning state exists
                     static_cast<CleaningState*>(stateMachine->getCleaningState())->setShortMode(true); // Set short mode for initial clean
                 } else {
                     Serial.println("ERROR: WebDashboard - CleaningState not available to set short mode for multiple coats.");
                 }
-                stateMachine->setNextStateOverride(stateMachine->getPaintingState());
-                stateMachine->changeState(stateMachine->getCleaningState()); // Start with cleaning
-                webSocket->sendTXT(num, "CMD_ACK: Multiple All Sides paint sequence initiated (" + String(numCoats) + " coats, " + String(interCoatDelaySec) + "s delay).");
+                stateMachine->requestTransition(STATE_CLEANING, STATE_PAINTING, true); // Start with cleaning, then paint all sides
+                webSendTXT(num, "CMD_ACK: Multiple All Sides paint sequence initiated (" + String(numCoats) + " coats, " + String(interCoatDelaySec) + "s delay).");
             } else {
                  Serial.print("Command ");
                  Serial.print(baseCommandAction);
                  Serial.println(" rejected. Machine must be in IDLE state.");
-                 webSocket->sendTXT(num, "CMD_ERROR: Machine not in IDLE state.");
+                 webSendTXT(num, "CMD_ERROR: Machine not in IDLE state.");
             }
         } else {
             Serial.println("ERROR: StateMachine pointer null. Cannot start Paint All Sides Multiple.");
-            webSocket->sendTXT(num, "CMD_ERROR: StateMachine not available.");
+            webSendTXT(num, "CMD_ERROR: StateMachine not available.");
         }
     }
     else if (baseCommandAction == "CLEAN_GUN") {
@@ -515,10 +730,10 @@ void processWebCommand(WebSocketsServer* webSocket, uint8_t num, String commandP
         // extern void setMachineState(int state); // No need to set directly, state machine handles it
         // setMachineState(MACHINE_CLEANING);
         if (stateMachine) {
-            stateMachine->changeState(stateMachine->getCleaningState());
-            webSocket->sendTXT(num, "CMD_ACK: Entering Cleaning Mode");
+            stateMachine->requestTransition(STATE_CLEANING);
+            webSendTXT(num, "CMD_ACK: Entering Cleaning Mode");
         } else {
-            webSocket->sendTXT(num, "CMD_ERROR: StateMachine not available.");
+            webSendTXT(num, "CMD_ERROR: StateMachine not available.");
         }
     }
     else if (baseCommandAction == "ENTER_PICKPLACE") {
@@ -526,10 +741,10 @@ void processWebCommand(WebSocketsServer* webSocket, uint8_t num, String commandP
         // NEW WAY: Transition using StateMachine
         Serial.println("Websocket: ENTER_PICKPLACE command received. Transitioning to PnPState...");
         if (stateMachine) {
-            stateMachine->changeState(stateMachine->getPnpState());
-            webSocket->sendTXT(num, "CMD_ACK: PnP State initiated.");
+            stateMachine->requestTransition(STATE_PNP);
+            webSendTXT(num, "CMD_ACK: PnP State initiated.");
         } else {
-            webSocket->sendTXT(num, "CMD_ERROR: StateMachine not available.");
+            webSendTXT(num, "CMD_ERROR: StateMachine not available.");
         }
 
         // Note: The actual PnP cycling will be handled by the PnPState update() method.
@@ -538,15 +753,69 @@ void processWebCommand(WebSocketsServer* webSocket, uint8_t num, String commandP
         // Home all axes
         Serial.println("Homing all axes immediately...");
         
-        // Set the home command received flag to interrupt any ongoing painting operations
-        homeCommandReceived = true;
+        // Request an abort to interrupt any ongoing painting operations
+        motionAbortRequest();
+        paintJobAbort(); // A running or paused paint job cannot be resumed after homing
         
-        // Change to homing state immediately
+        // Queue the change to homing state
         if (stateMachine) {
-            stateMachine->changeState(stateMachine->getHomingState());
-            webSocket->sendTXT(num, "CMD_ACK: Homing sequence initiated.");
+            stateMachine->requestTransition(STATE_HOMING);
+            webSendTXT(num, "CMD_ACK: Homing sequence initiated.");
+        } else {
+            webSendTXT(num, "CMD_ERROR: StateMachine not available.");
+        }
+    }
+    else if (baseCommandAction == "PAUSE") {
+        // Pause the All Sides job at the next pass boundary
+        if (stateMachine && stateMachine->getCurrentState() == stateMachine->getPaintingState() && isPaintJobRunning()) {
+            Serial.println("Pause requested. Finishing current pass...");
+            pauseCommandReceived = true;
+            webSendTXT(num, "CMD_ACK: Pausing after current pass.");
+        } else {
+            Serial.println("PAUSE rejected. No All Sides paint job running.");
+            webSendTXT(num, "CMD_ERROR: No paint job running.");
+        }
+    }
+    else if (baseCommandAction == "RESUME") {
+        // Resume a paused job from its checkpoint
+        if (stateMachine && stateMachine->getCurrentState() == stateMachine->getPausedState() && isPaintJobPaused()) {
+            Serial.println("Resume requested.");
+            static_cast<PausedState*>(stateMachine->getPausedState())->requestResume();
+            webSendTXT(num, "CMD_ACK: Resuming paint job.");
+        } else {
+            Serial.println("RESUME rejected. Machine is not paused.");
+            webSendTXT(num, "CMD_ERROR: Machine not in PAUSED state.");
+        }
+    }
+    else if (baseCommandAction == "RESUME_JOB") {
+        // Continue a job interrupted by a reset, after a short pre-paint clean
+        if (!stateMachine || stateMachine->getCurrentState() != stateMachine->getIdleState()) {
+            webSendTXT(num, "CMD_ERROR: Machine not in IDLE state.");
+        } else if (!paintJobRestoreFromJournal()) {
+            webSendTXT(num, "CMD_ERROR: No unfinished job to resume.");
+        } else {
+            paintJobResume();
+            static_cast<PaintingState*>(stateMachine->getPaintingState())->resumePaintJob();
+            static_cast<CleaningState*>(stateMachine->getCleaningState())->setShortMode(true);
+            stateMachine->requestTransition(STATE_CLEANING, STATE_PAINTING);
+            webSendTXT(num, "CMD_ACK: Resuming interrupted paint job.");
+        }
+    }
+    else if (baseCommandAction == "DISCARD_JOB") {
+        progressJournal.discardResumableJob();
+        webBroadcastTXT("RESUME_AVAILABLE:NONE");
+        webSendTXT(num, "CMD_ACK: Unfinished job discarded.");
+    }
+    else if (baseCommandAction == "RESTART") {
+        // Controlled software restart; retained positions let the next boot skip homing
+        if (!stateMachine || stateMachine->getCurrentState() != stateMachine->getIdleState()) {
+            webSendTXT(num, "CMD_ERROR: Machine not in IDLE state.");
         } else {
-            webSocket->sendTXT(num, "CMD_ERROR: StateMachine not available.");
+            bool retained = retainPositionsForRestart();
+            webSendTXT(num, retained ? "CMD_ACK: Restarting (homing will be skipped)."
+                                             : "CMD_ACK: Restarting (homing required).");
+            restartHoldBegin(); // Nothing may move the axes before the reboot
+            webRestartAfterSend();
         }
     }
     else if (baseCommandAction == "MOVE_Z_PREVIEW") {
@@ -561,7 +830,7 @@ void processWebCommand(WebSocketsServer* webSocket, uint8_t num, String commandP
             moveToXYZ(currentX, 1, currentY, 1, z_pos_steps, DEFAULT_Z_SPEED); // Use DEFAULT_Z_SPEED, wait for completion is implicit
         } else {
             Serial.println("Preview move ignored: Machine not idle or in PnP mode.");
-            webSocket->broadcastTXT("STATUS:Preview move ignored: Machine not idle or in PnP mode.");
+            webBroadcastTXT("STATUS:Preview move ignored: Machine not idle or in PnP mode.");
         }
     }
     else if (baseCommandAction == "MOVE_SERVO_PREVIEW") {
@@ -573,17 +842,17 @@ void processWebCommand(WebSocketsServer* webSocket, uint8_t num, String commandP
                  myServo.setAngle(angle);
              } else {
                  Serial.println("Invalid servo angle received for preview.");
-                 webSocket->broadcastTXT("STATUS:Invalid servo angle received for preview.");
+                 webBroadcastTXT("STATUS:Invalid servo angle received for preview.");
              }
         } else {
              Serial.println("Preview move ignored: Machine not idle or in PnP mode.");
-             webSocket->broadcastTXT("STATUS:Preview move ignored: Machine not idle or in PnP mode.");
+             webBroadcastTXT("STATUS:Preview move ignored: Machine not idle or in PnP mode.");
         }
     }
     else if (baseCommandAction == "GET_STATUS") {
         // REMOVED - State updates are handled by StateMachine broadcasts
         Serial.println("GET_STATUS command received - Handler removed (redundant).");
-        webSocket->sendTXT(num, "CMD_NOTE: GET_STATUS is redundant; state is pushed automatically.");
+        webSendTXT(num, "CMD_NOTE: GET_STATUS is redundant; state is pushed automatically.");
     }
     else if (baseCommandAction == "GET_PATTERN_SETTINGS") {
         // Load and send existing pattern settings using persistence
@@ -598,7 +867,7 @@ void processWebCommand(WebSocketsServer* webSocket, uint8_t num, String commandP
         settingsMsg += ",xOverlap=";
         settingsMsg += String(persistence.loadFloat(X_OVERLAP_KEY, 0.2)); // Default 0.2
         // persistence.end();
-        webSocket->broadcastTXT(settingsMsg);
+        webBroadcastTXT(settingsMsg);
         Serial.println("Sent pattern settings: " + settingsMsg);
     }
     else if (baseCommandAction == "GET_SERVO_ANGLES") { // Handle request for servo angles
@@ -613,7 +882,7 @@ void processWebCommand(WebSocketsServer* webSocket, uint8_t num, String commandP
         anglesMsg += ",side2="; // Changed from right
         anglesMsg += String(paintingSettings.getSide2RotationAngle()); // NEW WAY
         // persistence.end(); // Keep open if other operations might follow quickly
-        webSocket->broadcastTXT(anglesMsg);
+        webBroadcastTXT(anglesMsg);
         Serial.println("Sent servo angles: " + anglesMsg);
     }
     else if (baseCommandAction == "SET_PAINT_SPEED") {
@@ -646,7 +915,7 @@ void processWebCommand(WebSocketsServer* webSocket, uint8_t num, String commandP
         paintingSettings.saveSettings(); // Save all settings
         Serial.print("Servo Angle Side 1 set to (and saved): "); // Added debug
         Serial.println(angle);
-        webSocket->sendTXT(num, "CMD_ACK: Servo Angle Side 1 set and saved");
+        webSendTXT(num, "CMD_ACK: Servo Angle Side 1 set and saved");
     }
     else if (baseCommandAction == "SET_SERVO_ANGLE_SIDE2") {
         int angle = valueStr.toInt();
@@ -654,7 +923,7 @@ void processWebCommand(WebSocketsServer* webSocket, uint8_t num, String commandP
         paintingSettings.saveSettings(); // Save all settings
         Serial.print("Servo Angle Side 2 set to (and saved): "); // Added debug
         Serial.println(angle);
-        webSocket->sendTXT(num, "CMD_ACK: Servo Angle Side 2 set and saved");
+        webSendTXT(num, "CMD_ACK: Servo Angle Side 2 set and saved");
     }
     else if (baseCommandAction == "SET_SERVO_ANGLE_SIDE3") {
         int angle = valueStr.toInt();
@@ -662,7 +931,7 @@ void processWebCommand(WebSocketsServer* webSocket, uint8_t num, String commandP
         paintingSettings.saveSettings(); // Save all settings
         Serial.print("Servo Angle Side 3 set to (and saved): "); // Added debug
         Serial.println(angle);
-        webSocket->sendTXT(num, "CMD_ACK: Servo Angle Side 3 set and saved");
+        webSendTXT(num, "CMD_ACK: Servo Angle Side 3 set and saved");
     }
     else if (baseCommandAction == "SET_SERVO_ANGLE_SIDE4") {
         int angle = valueStr.toInt();
@@ -670,7 +939,7 @@ void processWebCommand(WebSocketsServer* webSocket, uint8_t num, String commandP
         paintingSettings.saveSettings(); // Save all settings
         Serial.print("Servo Angle Side 4 set to (and saved): "); // Added debug
         Serial.println(angle);
-        webSocket->sendTXT(num, "CMD_ACK: Servo Angle Side 4 set and saved");
+        webSendTXT(num, "CMD_ACK: Servo Angle Side 4 set and saved");
     }
     else if (baseCommandAction == "SAVE_PAINT_SETTINGS") {
         // Save current settings to NVS
@@ -682,13 +951,13 @@ void processWebCommand(WebSocketsServer* webSocket, uint8_t num, String commandP
         // Send confirmation message to client
         // String message = "STATUS:Settings saved successfully"; // message is already declared
         message = "STATUS:Settings saved successfully"; 
-        webSocket->broadcastTXT(message);
+        webBroadcastTXT(message);
     }
     else if (baseCommandAction == "RESET_PAINT_SETTINGS") {
         // Reset painting settings to defaults
         paintingSettings.resetToDefaults();
         paintingSettings.saveSettings(); // Save defaults immediately
-        webSocket->broadcastTXT("Painting settings reset to defaults");
+        webBroadcastTXT("Painting settings reset to defaults");
         Serial.println("Painting settings reset to defaults");
     }
     else if (baseCommandAction == "SET_PAINTING_OFFSET_X") { 
@@ -999,6 +1268,31 @@ void processWebCommand(WebSocketsServer* webSocket, uint8_t num, String commandP
         Serial.println(paintingSettings.getPostPrintPause());
         paintingSettings.saveSettings(); // Save after setting
     }
+    else if (baseCommandAction.startsWith("SET_FIXTURE")) {
+        // SET_FIXTURE<n>ENABLED:0|1, SET_FIXTURE<n>OFFSETX:<in>, SET_FIXTURE<n>OFFSETY:<in> (n = 2..MAX_FIXTURES)
+        int index = baseCommandAction.substring(11, 12).toInt() - 1;
+        String field = baseCommandAction.substring(12);
+        if (stateMachine && stateMachine->getCurrentState() != stateMachine->getIdleState()) {
+            webSendTXT(num, "CMD_ERROR: Fixtures can only be changed while IDLE.");
+        } else if (index < 1 || index >= MAX_FIXTURES) {
+            webSendTXT(num, "CMD_ERROR: Invalid fixture number.");
+        } else {
+            const Fixture& fixture = getFixture(index);
+            if (field == "ENABLED") {
+                setFixtureEnabled(index, value1 != 0.0f);
+            } else if (field == "OFFSETX") {
+                setFixtureOffset(index, value1, fixture.offsetY);
+            } else if (field == "OFFSETY") {
+                setFixtureOffset(index, fixture.offsetX, value1);
+            } else {
+                webSendTXT(num, "CMD_ERROR: Unknown fixture setting.");
+                return;
+            }
+            saveFixtures();
+            Serial.printf("Fixture %d: %s, offset X=%.2f Y=%.2f\n", index + 1,
+                          fixture.enabled ? "enabled" : "disabled", fixture.offsetX, fixture.offsetY);
+        }
+    }
     else if (baseCommandAction == "GET_PAINT_SETTINGS") {
         // Send all current painting settings to the client
         Serial.println("Sending current painting settings to client");
@@ -1006,116 +1300,125 @@ void processWebCommand(WebSocketsServer* webSocket, uint8_t num, String commandP
         // Paint Gun Offsets
         // String message = "SETTING:paintingOffsetX:" + String(paintingSettings.getPaintingOffsetX(), 2); // message declared above
         message = "SETTING:paintingOffsetX:" + String(paintingSettings.getPaintingOffsetX(), 2);
-        webSocket->broadcastTXT(message);
+        webBroadcastTXT(message);
         message = "SETTING:paintingOffsetY:" + String(paintingSettings.getPaintingOffsetY(), 2);
-        webSocket->broadcastTXT(message);
+        webBroadcastTXT(message);
         
         // Z Heights (Order: 1, 2, 3, 4)
         message = "SETTING:side1ZHeight:" + String(paintingSettings.getSide1ZHeight(), 2);
-        webSocket->broadcastTXT(message);
+        webBroadcastTXT(message);
         message = "SETTING:side2ZHeight:" + String(paintingSettings.getSide2ZHeight(), 2);
-        webSocket->broadcastTXT(message);
+        webBroadcastTXT(message);
         message = "SETTING:side3ZHeight:" + String(paintingSettings.getSide3ZHeight(), 2);
-        webSocket->broadcastTXT(message);
+        webBroadcastTXT(message);
         message = "SETTING:side4ZHeight:" + String(paintingSettings.getSide4ZHeight(), 2);
-        webSocket->broadcastTXT(message);
+        webBroadcastTXT(message);
         
         // Side Z Heights (Order: 1, 2, 3, 4)
         message = "SETTING:side1SideZHeight:" + String(paintingSettings.getSide1SideZHeight(), 2);
-        webSocket->broadcastTXT(message);
+        webBroadcastTXT(message);
         message = "SETTING:side2SideZHeight:" + String(paintingSettings.getSide2SideZHeight(), 2);
-        webSocket->broadcastTXT(message);
+        webBroadcastTXT(message);
         message = "SETTING:side3SideZHeight:" + String(paintingSettings.getSide3SideZHeight(), 2);
-        webSocket->broadcastTXT(message);
+        webBroadcastTXT(message);
         message = "SETTING:side4SideZHeight:" + String(paintingSettings.getSide4SideZHeight(), 2);
-        webSocket->broadcastTXT(message);
+        webBroadcastTXT(message);
         
         // Rotation Angles (Order: 1, 2, 3, 4)
         message = "SETTING:side1RotationAngle:" + String(paintingSettings.getSide1RotationAngle());
-        webSocket->broadcastTXT(message);
+        webBroadcastTXT(message);
         message = "SETTING:side2RotationAngle:" + String(paintingSettings.getSide2RotationAngle());
-        webSocket->broadcastTXT(message);
+        webBroadcastTXT(message);
         message = "SETTING:side3RotationAngle:" + String(paintingSettings.getSide3RotationAngle());
-        webSocket->broadcastTXT(message);
+        webBroadcastTXT(message);
         message = "SETTING:side4RotationAngle:" + String(paintingSettings.getSide4RotationAngle());
-        webSocket->broadcastTXT(message);
+        webBroadcastTXT(message);
         
         // Painting Speeds (Order: 1, 2, 3, 4)
         message = "SETTING:side1PaintingXSpeed:" + String(paintingSettings.getSide1PaintingXSpeed());
-        webSocket->broadcastTXT(message);
+        webBroadcastTXT(message);
         message = "SETTING:side1PaintingYSpeed:" + String(paintingSettings.getSide1PaintingYSpeed());
-        webSocket->broadcastTXT(message);
+        webBroadcastTXT(message);
         message = "SETTING:side2PaintingXSpeed:" + String(paintingSettings.getSide2PaintingXSpeed());
-        webSocket->broadcastTXT(message);
+        webBroadcastTXT(message);
         message = "SETTING:side2PaintingYSpeed:" + String(paintingSettings.getSide2PaintingYSpeed());
-        webSocket->broadcastTXT(message);
+        webBroadcastTXT(message);
         message = "SETTING:side3PaintingXSpeed:" + String(paintingSettings.getSide3PaintingXSpeed());
-        webSocket->broadcastTXT(message);
+        webBroadcastTXT(message);
         message = "SETTING:side3PaintingYSpeed:" + String(paintingSettings.getSide3PaintingYSpeed());
-        webSocket->broadcastTXT(message);
+        webBroadcastTXT(message);
         message = "SETTING:side4PaintingXSpeed:" + String(paintingSettings.getSide4PaintingXSpeed());
-        webSocket->broadcastTXT(message);
+        webBroadcastTXT(message);
         message = "SETTING:side4PaintingYSpeed:" + String(paintingSettings.getSide4PaintingYSpeed());
-        webSocket->broadcastTXT(message);
+        webBroadcastTXT(message);
         
         // Pattern Start Positions (Order: 1, 2, 3, 4)
         message = "SETTING:side1StartX:" + String(paintingSettings.getSide1StartX(), 2);
-        webSocket->broadcastTXT(message);
+        webBroadcastTXT(message);
         message = "SETTING:side1StartY:" + String(paintingSettings.getSide1StartY(), 2);
-        webSocket->broadcastTXT(message);
+        webBroadcastTXT(message);
         message = "SETTING:side2StartX:" + String(paintingSettings.getSide2StartX(), 2);
-        webSocket->broadcastTXT(message);
+        webBroadcastTXT(message);
         message = "SETTING:side2StartY:" + String(paintingSettings.getSide2StartY(), 2);
-        webSocket->broadcastTXT(message);
+        webBroadcastTXT(message);
         message = "SETTING:side3StartX:" + String(paintingSettings.getSide3StartX(), 2);
-        webSocket->broadcastTXT(message);
+        webBroadcastTXT(message);
         message = "SETTING:side3StartY:" + String(paintingSettings.getSide3StartY(), 2);
-        webSocket->broadcastTXT(message);
+        webBroadcastTXT(message);
         message = "SETTING:side4StartX:" + String(paintingSettings.getSide4StartX(), 2);
-        webSocket->broadcastTXT(message);
+        webBroadcastTXT(message);
         message = "SETTING:side4StartY:" + String(paintingSettings.getSide4StartY(), 2);
-        webSocket->broadcastTXT(message);
+        webBroadcastTXT(message);
         
         // Pattern Dimensions (Order: 1, 2, 3, 4)
         message = "SETTING:side1SweepY:" + String(paintingSettings.getSide1SweepY(), 2);
-        webSocket->broadcastTXT(message);
+        webBroadcastTXT(message);
         message = "SETTING:side1ShiftX:" + String(paintingSettings.getSide1ShiftX(), 2);
-        webSocket->broadcastTXT(message);
+        webBroadcastTXT(message);
         message = "SETTING:side2SweepY:" + String(paintingSettings.getSide2SweepY(), 2);
-        webSocket->broadcastTXT(message);
+        webBroadcastTXT(message);
         message = "SETTING:side2ShiftX:" + String(paintingSettings.getSide2ShiftX(), 2);
-        webSocket->broadcastTXT(message);
+        webBroadcastTXT(message);
         message = "SETTING:side3SweepY:" + String(paintingSettings.getSide3SweepY(), 2);
-        webSocket->broadcastTXT(message);
+        webBroadcastTXT(message);
         message = "SETTING:side3ShiftX:" + String(paintingSettings.getSide3ShiftX(), 2);
-        webSocket->broadcastTXT(message);
+        webBroadcastTXT(message);
         message = "SETTING:side4SweepY:" + String(paintingSettings.getSide4SweepY(), 2);
-        webSocket->broadcastTXT(message);
+        webBroadcastTXT(message);
         message = "SETTING:side4ShiftX:" + String(paintingSettings.getSide4ShiftX(), 2);
-        webSocket->broadcastTXT(message);
+        webBroadcastTXT(message);
         
         // Post-Print Pause
         message = "SETTING:postPrintPause:" + String(paintingSettings.getPostPrintPause());
-        webSocket->broadcastTXT(message);
+        webBroadcastTXT(message);
+
+        // Fixtures (fixture 1 is the origin)
+        for (int i = 1; i < MAX_FIXTURES; ++i) {
+            const Fixture& fixture = getFixture(i);
+            String prefix = "SETTING:fixture" + String(i + 1);
+            webBroadcastTXT(prefix + "Enabled:" + String(fixture.enabled ? 1 : 0));
+            webBroadcastTXT(prefix + "OffsetX:" + String(fixture.offsetX, 2));
+            webBroadcastTXT(prefix + "OffsetY:" + String(fixture.offsetY, 2));
+        }
         
         // Servo Angles (Order: 1, 2, 3, 4)
         // NOTE: Originally read directly from NVS using old keys. Changed to use getters 
         // from the paintingSettings object to ensure consistency and fix persistence issue.
         message = "SETTING:servoAngleSide1:" + String(paintingSettings.getServoAngleSide1()); // Use getter
-        webSocket->broadcastTXT(message);
+        webBroadcastTXT(message);
         message = "SETTING:servoAngleSide2:" + String(paintingSettings.getServoAngleSide2()); // Use getter
-        webSocket->broadcastTXT(message);
+        webBroadcastTXT(message);
         message = "SETTING:servoAngleSide3:" + String(paintingSettings.getServoAngleSide3()); // Use getter
-        webSocket->broadcastTXT(message);
+        webBroadcastTXT(message);
         message = "SETTING:servoAngleSide4:" + String(paintingSettings.getServoAngleSide4()); // Use getter
-        webSocket->broadcastTXT(message);
+        webBroadcastTXT(message);
     }
     else if (baseCommandAction == "GOTO_PNP_PICK_LOCATION") {
         // Implement the logic to go to PNP Pick Location
         Serial.println("GOTO_PNP_PICK_LOCATION command received");
         // Example: stateMachine->changeState(stateMachine->getGoToPnpPickLocationState()); // You'll need to create such a state or function
         // For now, just an ACK.
-        webSocket->sendTXT(num, "CMD_ACK: GOTO_PNP_PICK_LOCATION command received (not fully implemented).");
+        webSendTXT(num, "CMD_ACK: GOTO_PNP_PICK_LOCATION command received (not fully implemented).");
     }
     else if (baseCommandAction == "MANUAL_MOVE_TO") {
         if (canPerformManualMove()) {
@@ -1142,14 +1445,14 @@ void processWebCommand(WebSocketsServer* webSocket, uint8_t num, String commandP
                     if (part.length() > 0) targetX_steps = part.toFloat() * STEPS_PER_INCH_XYZ;
                     else {
                         Serial.println("MANUAL_MOVE_TO: X value cannot be empty.");
-                        webSocket->sendTXT(num, "CMD_ERROR: X value for MANUAL_MOVE_TO cannot be empty.");
+                        webSendTXT(num, "CMD_ERROR: X value for MANUAL_MOVE_TO cannot be empty.");
                         return; // Exit if X is empty
                     }
                 } else if (valueCount == 1) { // Y value
                     if (part.length() > 0) targetY_steps = part.toFloat() * STEPS_PER_INCH_XYZ;
                     else {
                         Serial.println("MANUAL_MOVE_TO: Y value cannot be empty.");
-                        webSocket->sendTXT(num, "CMD_ERROR: Y value for MANUAL_MOVE_TO cannot be empty.");
+                        webSendTXT(num, "CMD_ERROR: Y value for MANUAL_MOVE_TO cannot be empty.");
                         return; // Exit if Y is empty
                     }
                 } else if (valueCount == 2) { // Z value
@@ -1166,98 +1469,88 @@ void processWebCommand(WebSocketsServer* webSocket, uint8_t num, String commandP
             // Ensure at least X and Y were processed
             if (valueCount < 2) { // Should have been caught by empty part check, but as a safeguard
                  Serial.println("Invalid format for MANUAL_MOVE_TO. Required: X,Y. Optional: Z,Angle. Input: " + valueStr);
-                 webSocket->sendTXT(num, "CMD_ERROR: Invalid format for MANUAL_MOVE_TO. Required: X,Y. Optional: Z,Angle.");
+                 webSendTXT(num, "CMD_ERROR: Invalid format for MANUAL_MOVE_TO. Required: X,Y. Optional: Z,Angle.");
                  return;
             }
 
             handleManualMoveToPosition(targetX_steps, targetY_steps, targetZ_steps, targetAngle_deg);
-            webSocket->sendTXT(num, "CMD_ACK: Manual move executed.");
+            webSendTXT(num, "CMD_ACK: Manual move executed.");
 
         } else {
             Serial.println("MANUAL_MOVE_TO command ignored: Manual moves not allowed in current state.");
-            webSocket->sendTXT(num, "CMD_ERROR: Manual moves not allowed in current state.");
+            webSendTXT(num, "CMD_ERROR: Manual moves not allowed in current state.");
         }
     }
     else if (baseCommandAction == "MANUAL_ROTATE_CW") {
         if (canPerformManualMove()) {
             handleManualRotateCounterClockwise90(); // Swapped: was handleManualRotateClockwise90()
-            webSocket->sendTXT(num, "CMD_ACK: Manual rotate CW executed (now CCW behavior)."); // Updated ACK message
+            webSendTXT(num, "CMD_ACK: Manual rotate CW executed (now CCW behavior)."); // Updated ACK message
             Serial.println("Manual rotate CW command executed (now CCW behavior).");
         } else {
             Serial.println("MANUAL_ROTATE_CW command ignored: Manual moves not allowed in current state.");
-            webSocket->sendTXT(num, "CMD_ERROR: Manual moves not allowed in current state.");
+            webSendTXT(num, "CMD_ERROR: Manual moves not allowed in current state.");
         }
     }
     else if (baseCommandAction == "MANUAL_ROTATE_CCW") {
         if (canPerformManualMove()) { 
             handleManualRotateClockwise90(); // Swapped: was handleManualRotateCounterClockwise90()
-            webSocket->sendTXT(num, "CMD_ACK: Manual rotate CCW executed (now CW behavior)."); // Updated ACK message
+            webSendTXT(num, "CMD_ACK: Manual rotate CCW executed (now CW behavior)."); // Updated ACK message
             Serial.println("Manual rotate CCW command executed (now CW behavior).");
         } else {
             Serial.println("MANUAL_ROTATE_CCW command ignored: Manual moves not allowed in current state.");
-            webSocket->sendTXT(num, "CMD_ERROR: Manual moves not allowed in current state.");
+            webSendTXT(num, "CMD_ERROR: Manual moves not allowed in current state.");
         }
     }
     else if (baseCommandAction == "PNP_SAVE_POSITION") {
         // Placeholder - Add implementation if needed
         Serial.println("PNP_SAVE_POSITION command received - Not implemented");
-        webSocket->sendTXT(num, "CMD_ERROR: PNP_SAVE_POSITION not implemented");
+        webSendTXT(num, "CMD_ERROR: PNP_SAVE_POSITION not implemented");
     }
     else if (baseCommandAction == "TOGGLE_PRESSURE_POT") {
         // Implement the logic to toggle the pressure pot
         Serial.println("Toggling Pressure Pot via web command");
         digitalWrite(PRESSURE_POT_PIN, !digitalRead(PRESSURE_POT_PIN));
-        webSocket->sendTXT(num, "CMD_ACK: Pressure Pot toggled");
+        webSendTXT(num, "CMD_ACK: Pressure Pot toggled");
     }
     else {
         // Unknown command
         Serial.print("Unknown command received: ");
         Serial.println(commandToProcess); // Log the string that was attempted to be processed
-        webSocket->sendTXT(num, "CMD_ERROR: Unknown command");
+        webSendTXT(num, "CMD_ERROR: Unknown command");
     }
 }
 
-// Function that handles WebSocket events without executing commands
-// This is used during painting to check for HOME commands
-void processWebSocketEvents() {
-  // Process WebSocket events to allow receiving commands
-  // This is called during operations that need to be interruptible
-  webSocket.loop();
-  
-  // Give some time for any WebSocket messages to be processed
-  // This ensures the webSocketEvent handler can set flags like homeCommandReceived
-  for (int i = 0; i < 10; i++) {
-    webSocket.loop();
-    delay(1);
-  }
-}
-
 // Function to check for HOME command during painting operations
-// Returns true if a home command was received
-extern volatile bool homeCommandReceived; // Assume declared globally
+// Returns true if a home command was received. The abort is requested by the
+// network task as the command arrives (see MotionAbort.h); queued commands
+// are not run from here.
 extern FastAccelStepper *stepperX;
 extern FastAccelStepper *stepperY_Left;
 extern FastAccelStepper *stepperY_Right;
 extern FastAccelStepper *stepperZ;
 
 bool checkForHomeCommand() {
-  // Process any pending WebSocket events
-  processWebSocketEvents();
-  
+  // Blocking moves keep the telemetry snapshot current
+  telemetryUpdate();
+
   // Check if a home command was received
-  if (homeCommandReceived) {
+  if (motionAbortPending()) {
+    if (stateMachine && stateMachine->isTransitionQueued(STATE_HOMING)) {
+      // Already handled; homing starts once the blocking code unwinds. Ramp
+      // down anything started since, so nothing is left for homing to hard stop.
+      motionAbortStopAxes();
+      return true;
+    }
     Serial.println("HOME command received - immediately aborting all operations");
+    paintJobAbort();
     
-    // IMMEDIATELY stop all motors
-    if (stepperX->isRunning()) stepperX->forceStopAndNewPosition(stepperX->getCurrentPosition());
-    if (stepperY_Left->isRunning()) stepperY_Left->forceStopAndNewPosition(stepperY_Left->getCurrentPosition());
-    if (stepperY_Right->isRunning()) stepperY_Right->forceStopAndNewPosition(stepperY_Right->getCurrentPosition());
-    if (stepperZ->isRunning()) stepperZ->forceStopAndNewPosition(stepperZ->getCurrentPosition());
+    // Ramp all motors down (homing re-references them anyway)
+    motionAbortStopAxes();
     
-    // If we have a state machine, immediately change to homing state
+    // If we have a state machine, queue the change to homing state
     if (stateMachine) {
-      Serial.println("Changing to homing state immediately due to HOME command");
-      stateMachine->changeState(stateMachine->getHomingState());
+      Serial.println("Requesting homing state due to HOME command");
+      stateMachine->requestTransition(STATE_HOMING);
     }
     
     return true;
@@ -1480,7 +1773,6 @@ void runDashboardServer() {
     
     // Handle WebSocket events
     webSocket.loop();
-    delay(5); // CHANGED FROM 50. Main loop delay for server tasks
 }
 
 void stopDashboardServer() {
@@ -1,6 +1,8 @@
 #include "utils/settings.h"
 #include <Arduino.h>
 
+bool isCylinder_DOWN = false;
+
 //* ************************************************************************
 //* ************************* CYLINDER CONTROL ***************************
 //* ************************************************************************
@@ -12,6 +14,7 @@
  */
 void cylinderDown() {
     digitalWrite(PICK_CYLINDER_PIN, HIGH);
+    isCylinder_DOWN = true;
 }
 
 /**
@@ -21,4 +24,5 @@ void cylinderDown() {
  */
 void cylinderUp() {
     digitalWrite(PICK_CYLINDER_PIN, LOW);
+    isCylinder_DOWN = false;
 } 
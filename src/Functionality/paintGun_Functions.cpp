@@ -3,6 +3,8 @@
 #include "hardware/paintGun_Functions.h" // Corrected path
 // #include "web_command_adapter.h" // Removing this include
 #include <WebSocketsServer.h>
+#include "system/NetworkTask.h" // For webBroadcastTXT()
+#include "system/Logger.h" // Toggled on every pass; printed later by the log task
 
 // External reference to the WebSocket instance in webserver.cpp
 extern WebSocketsServer webSocket;
@@ -23,17 +25,15 @@ void setupPaintGun() {
 void sendWebStatus(WebSocketsServer* webSocket, const char* message) {
     if (webSocket) {
         // Basic implementation: broadcast the message to all connected clients
-        webSocket->broadcastTXT(message);
-        Serial.print("Sent to WebSocket: "); // Debug output
-        Serial.println(message);
+        webBroadcastTXT(message);
+        logDebug("Sent to WebSocket: %s", message); // Callers pass string literals
     }
 }
 
 void paintGun_OFF() {
     pinMode(PAINT_GUN_PIN, OUTPUT);
     digitalWrite(PAINT_GUN_PIN, LOW);
-    Serial.println("Paint gun OFF");
-    Serial.printf("Paint gun pin %d set to LOW\n", PAINT_GUN_PIN);
+    logInfo("Paint gun OFF (pin %d LOW)", PAINT_GUN_PIN);
     
     // Update the state
     isPaintGun_ON = false;
@@ -45,8 +45,7 @@ void paintGun_OFF() {
 void paintGun_ON() {
     pinMode(PAINT_GUN_PIN, OUTPUT);
     digitalWrite(PAINT_GUN_PIN, HIGH);
-    Serial.println("Paint gun ON");
-    Serial.printf("Paint gun pin %d set to HIGH\n", PAINT_GUN_PIN);
+    logInfo("Paint gun ON (pin %d HIGH)", PAINT_GUN_PIN);
     
     // Update the state
     isPaintGun_ON = true;
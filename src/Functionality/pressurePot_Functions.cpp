@@ -3,6 +3,7 @@
 #include "hardware/pressurePot_Functions.h"
 // #include "web_command_adapter.h" // Removing this include
 #include <WebSocketsServer.h>
+#include "system/Logger.h"
 
 // External reference to the WebSocket instance in webserver.cpp
 extern WebSocketsServer webSocket;
@@ -14,7 +15,7 @@ extern void sendWebStatus(WebSocketsServer* webSocket, const char* message);
 void PressurePot_OFF() {
     pinMode(PRESSURE_POT_PIN, OUTPUT);
     digitalWrite(PRESSURE_POT_PIN, LOW);
-    Serial.println("Pressure pot OFF");
+    logInfo("Pressure pot OFF");
 
     isPressurePot_ON = false;
     
@@ -25,7 +26,7 @@ void PressurePot_OFF() {
 void PressurePot_ON() {
     pinMode(PRESSURE_POT_PIN, OUTPUT);
     digitalWrite(PRESSURE_POT_PIN, HIGH);
-    Serial.println("Pressure pot ON"); 
+    logInfo("Pressure pot ON");
 
     isPressurePot_ON = true;
     
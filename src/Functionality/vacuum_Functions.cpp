@@ -1,6 +1,8 @@
 #include "utils/settings.h"
 #include <Arduino.h>
 
+bool isVacuum_ON = false;
+
 //* ************************************************************************
 //* ************************* VACUUM CONTROL ***************************
 //* ************************************************************************
@@ -12,6 +14,7 @@
  * */
 void vacuumOn() {
     digitalWrite(SUCTION_PIN, HIGH);
+    isVacuum_ON = true;
 }
 
 /**
@@ -21,6 +24,7 @@ void vacuumOn() {
  */
 void vacuumOff() {
     digitalWrite(SUCTION_PIN, LOW);
+    isVacuum_ON = false;
 }
 
 /* REMOVED - Logic moved to Setup.cpp
@@ -10,7 +10,12 @@
 #include "storage/PaintingSettings.h"
 
 // Include headers for functions called in loop
-#include "web/Web_Dashboard_Commands.h" // For runDashboardServer()
+#include "web/Web_Dashboard_Commands.h" // For setupWebDashboardCommands()
+#include "system/EventLoop.h" // Sleeps until the next event or deadline
+#include "system/Supervisor.h" // Loop timing and stall watchdog
+#include "system/NetworkTask.h" // WiFi/HTTP/WebSocket/OTA on the other core
+#include "system/Telemetry.h" // Snapshot for the network task
+#include "utils/settings.h" // For MOTION_TASK_PRIORITY
 // Add other headers as needed
 
 extern WebSocketsServer webSocket;
@@ -27,16 +32,14 @@ extern PaintingSettings paintingSettings;
 // State machine
 extern StateMachine* stateMachine;
 
-// Define the global flag previously in machine_state.cpp
-volatile bool homeCommandReceived = false;
-
 //* ************************************************************************
 //* ***************************** MAIN *******************************
 //* ************************************************************************
 
 void setup() {
-  // Initialize state machine *before* system initialization, so it's available
-  stateMachine = new StateMachine();
+  // Initialize state machine *before* system initialization, so it's available.
+  // Static storage, constructed here (not before setup) so states can log.
+  static StateMachine machine; // Sets the global stateMachine pointer
 
   initializeSystem();
   setupWebDashboardCommands(); // Initialize pins and settings for web commands
@@ -47,13 +50,17 @@ void setup() {
   Serial.printf("Servo Initialized at: %d degrees\n", initialServoAngle);
 
   // Any setup code that *must* run after initializeSystem()
+  // Networking moves to its own core; this loop task becomes the motion task
+  eventLoopBegin();
+  supervisorBegin(); // Reports a stall stored before the last reset
+  startNetworkTask();
+  vTaskPrioritySet(NULL, MOTION_TASK_PRIORITY);
   Serial.println("Setup complete. Entering main loop...");
 }
 
 void loop() {
-  // Handle OTA updates
-  ArduinoOTA.handle();
-  
+  supervisorLoopBegin();
+
   // Update machine state
   // updateMachineState();
   
@@ -62,11 +69,14 @@ void loop() {
     stateMachine->update();
   }
   
-  //! Handle web server and WebSocket communication
-  runDashboardServer(); // Handles incoming client connections and WebSocket messages
+  //! Run commands received by the network task
+  processQueuedWebCommands();
+
+  telemetryUpdate(); // Publishes at TELEMETRY_PERIOD_MS
   
   // Add calls to other main loop functions here
   // For example, state machine updates, periodic checks, etc.
   
-  delay(1); // Small delay to prevent tight loop, adjust as necessary
+  supervisorLoopEnd(); // The wait below is not part of the pass
+  eventLoopWait(); // Sleeps until a sensor edge, a queued command or the next deadline
 }
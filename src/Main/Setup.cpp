@@ -5,7 +5,6 @@
 
 // Include necessary libraries and headers
 #include <FastAccelStepper.h>
-#include <Bounce2.h>
 #include <WiFi.h>
 #include <WiFiClient.h>
 #include <ESPmDNS.h>
@@ -16,12 +15,19 @@
 #include "motors/XYZ_Movements.h"
 #include "motors/Rotation_Motor.h"
 #include "persistence/Persistence.h"
+#include "storage/ProgressJournal.h"
+#include "system/Fixtures.h"
+#include "storage/TrayLayouts.h"
+#include "system/RetainedPositions.h"
 #include "persistence/PaintingSettings.h"
 #include "states/HomingState.h"
-#include "states/StateMachine.h"
+#include "system/StateMachine.h"
 #include <Preferences.h>
 #include "web/Web_Dashboard_Commands.h" // For loadPnpSettingsFromNVS
-#include "hardware/GlobalDebouncers.h" // For initializeGlobalDebouncers
+#include "hardware/CycleSensor.h" // For initializeCycleSensor
+#include "hardware/InputSampler.h" // For initializeInputSampler
+#include "system/Supervisor.h" // OTA upload feeds the watchdog
+#include "system/Logger.h" // Deferred logging for hot paths
 
 //* ************************************************************************
 //* ************************* SYSTEM SETUP ***************************
@@ -34,10 +40,6 @@ FastAccelStepper *stepperX = NULL;
 FastAccelStepper *stepperY_Left = NULL;
 FastAccelStepper *stepperY_Right = NULL;
 FastAccelStepper *stepperZ = NULL;
-Bounce debounceX;
-Bounce debounceY_Left;
-Bounce debounceY_Right;
-Bounce debounceZ;
 WiFiServer dashboardServer(80);
 WebSocketsServer webSocket(81);
 bool webSocketServerStarted = false;
@@ -87,17 +89,23 @@ void initializeWebCommunications() {
             type = "filesystem";
         }
         Serial.println("OTA: Start updating " + type);
+        // Motors stay powered through the OTA reboot; hold the controller so the
+        // positions retained when the upload ends are still valid at boot
+        restartHoldBegin();
     });
     
     ArduinoOTA.onEnd([]() {
         Serial.println("\\nOTA: Update complete");
+        restartHoldRetain(); // Skips homing at boot if the controller stayed idle
     });
     
     ArduinoOTA.onProgress([](unsigned int progress, unsigned int total) {
         Serial.printf("OTA: Progress: %u%%\\r", (progress / (total / 100)));
+        supervisorCheck(); // The upload blocks the network task; keep the watchdog fed
     });
     
     ArduinoOTA.onError([](ota_error_t error) {
+        restartHoldCancel(); // No reboot follows; machine keeps running
         Serial.printf("OTA: Error[%u]: ", error);
         if (error == OTA_AUTH_ERROR) Serial.println("Auth Failed");
         else if (error == OTA_BEGIN_ERROR) Serial.println("Begin Failed");
@@ -158,23 +166,13 @@ void initializeMotorsAndSwitches() {
     pinMode(Y_LEFT_HOME_SWITCH, INPUT_PULLDOWN);
     pinMode(Y_RIGHT_HOME_SWITCH, INPUT_PULLDOWN);
     pinMode(Z_HOME_SWITCH, INPUT_PULLDOWN);
-    // pinMode(PNP_CYCLE_SENSOR_PIN, INPUT_PULLUP); // REMOVED: Handled by initializeGlobalDebouncers()
+    // pinMode(PNP_CYCLE_SENSOR_PIN, INPUT_PULLUP); // REMOVED: Handled by initializeCycleSensor()
     
-    // Debouncer Setup
-    debounceX.attach(X_HOME_SWITCH);
-    debounceX.interval(GENERAL_DEBOUNCE_MS);
-    
-    debounceY_Left.attach(Y_LEFT_HOME_SWITCH);
-    debounceY_Left.interval(GENERAL_DEBOUNCE_MS);
-    
-    debounceY_Right.attach(Y_RIGHT_HOME_SWITCH);
-    debounceY_Right.interval(GENERAL_DEBOUNCE_MS);
-
-    debounceZ.attach(Z_HOME_SWITCH);
-    debounceZ.interval(GENERAL_DEBOUNCE_MS);
+    // Home switches are sampled and debounced by a timer
+    initializeInputSampler();
 
-    // Initialize global debouncers (includes PNP Cycle Sensor)
-    initializeGlobalDebouncers(); 
+    // PNP Cycle Sensor (edge interrupt, timestamp debounced)
+    initializeCycleSensor();
 
     // Serial.println("Motors and Switches Initialized.");
 }
@@ -221,6 +219,15 @@ void initializeSettings() {
 
     // Load PNP motion settings from NVS
     loadPnpSettingsFromNVS();
+
+    // Load fixture origins for pipelined jobs
+    loadFixtures();
+
+    // Load PnP tray layouts and build the active step table
+    trayLayouts.begin();
+
+    // Recover the paint job journal (offers resume after homing)
+    progressJournal.begin();
     
     // No need to explicitly close persistence here, 
     // paintingSettings.begin() handles its own NVS operations if needed.
@@ -231,6 +238,7 @@ void initializeSettings() {
 //! Initialize all system components
 void initializeSystem() {
     Serial.begin(115200);
+    startLogTask(); // Hot paths log through the ring from here on
     Serial.println("\\n\\n--- System Initialization Starting ---");
 
     // Connect to WiFi and start WebSocket first
@@ -261,9 +269,13 @@ void initializeSystem() {
     // homeAllAxes will log its completion or errors internally
     
     // Instead of calling homeAllAxes directly, transition to HomingState
-    if (stateMachine) {
+    // A software restart (OTA, RESTART command) with retained positions skips homing
+    if (stateMachine && restoreRetainedPositions()) {
+        Serial.println("Warm restart with retained positions. Skipping homing.");
+        stateMachine->requestTransition(STATE_IDLE);
+    } else if (stateMachine) {
         Serial.println("Initiating homing sequence via State Machine...");
-        stateMachine->changeState(stateMachine->getHomingState());
+        stateMachine->requestTransition(STATE_HOMING);
     } else {
         Serial.println("ERROR: StateMachine pointer is null. Cannot initiate homing!");
         // Consider setting an error state or handling this
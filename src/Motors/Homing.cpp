@@ -1,11 +1,10 @@
 #include "motors/Homing.h"
 #include "motors/XYZ_Movements.h"
 #include <Arduino.h>
-#include <Bounce2.h>
 #include <FastAccelStepper.h>
 #include "utils/settings.h"
 #include "system/machine_state.h" // Include the updated header
-#include "settings/debounce_settings.h" // Added for centralized debounce intervals
+#include "system/EventLoop.h"
 
 // Need access to the global rotation stepper pointer if used
 // This is already included via Rotation_Motor.h in Homing.h
@@ -22,18 +21,7 @@ Homing::Homing(FastAccelStepperEngine& engine,
       _stepperY_Right(stepperY_Right),
       _stepperZ(stepperZ)
 {
-    // Initialize bounce objects here
-    _xHomeSwitch.attach(X_HOME_SWITCH);
-    _xHomeSwitch.interval(HOMING_SWITCH_DEBOUNCE_MS); 
-    
-    _yLeftHomeSwitch.attach(Y_LEFT_HOME_SWITCH);
-    _yLeftHomeSwitch.interval(HOMING_SWITCH_DEBOUNCE_MS); 
-    
-    _yRightHomeSwitch.attach(Y_RIGHT_HOME_SWITCH);
-    _yRightHomeSwitch.interval(HOMING_SWITCH_DEBOUNCE_MS); 
-    
-    _zHomeSwitch.attach(Z_HOME_SWITCH);
-    _zHomeSwitch.interval(HOMING_SWITCH_DEBOUNCE_MS); 
+    // Switches are sampled and debounced by the input sampler (InputSampler.h)
 }
 
 // Utility function implementation (keep it private to this class for now)
@@ -41,6 +29,53 @@ long Homing::inchesToStepsXYZ(float inches) {
     return (long)(inches * STEPS_PER_INCH_XYZ);
 }
 
+// Advances one axis seeking its home switch; returns true once it is homed.
+// The switch interrupt latches the time of first contact: the axis is
+// stopped as soon as the loop wakes, and position 0 is put at the contact
+// point by taking back the steps run since then. The sampler must then
+// confirm the switch; a latched glitch re-arms and resumes the seek.
+bool Homing::seekSwitch(FastAccelStepper* stepper, InputId input, bool forward, unsigned long& latchedAtMs) {
+    if (latchedAtMs == 0) {
+        unsigned long edgeUs;
+        if (inputEdgeLatched(input, edgeUs)) {
+            int32_t speedMilliHz = stepper->getCurrentSpeedInMilliHz(); // Negative when running backward
+            unsigned long sinceEdgeUs = micros() - edgeUs;
+            long pastTrigger = (long)((int64_t)speedMilliHz * (int64_t)sinceEdgeUs / 1000000000LL);
+            stepper->forceStopAndNewPosition(pastTrigger);
+            latchedAtMs = millis();
+            if (latchedAtMs == 0) latchedAtMs = 1;
+            return false;
+        }
+        if (!inputActive(input)) {
+            return false;
+        }
+        // Debounced contact without a latched edge: stop here as before
+        if (stepper->isRunning()) {
+            stepper->forceStopAndNewPosition(0);
+        } else {
+            stepper->setCurrentPosition(0);
+        }
+        inputDisarmEdgeLatch(input);
+        return true;
+    }
+
+    if (inputActive(input)) {
+        inputDisarmEdgeLatch(input);
+        return true;
+    }
+    if (millis() - latchedAtMs > HOMING_LATCH_CONFIRM_MS) {
+        Serial.printf("Homing: Switch input %d not confirmed, resuming seek.\n", input);
+        latchedAtMs = 0;
+        inputArmEdgeLatch(input);
+        if (forward) {
+            stepper->runForward();
+        } else {
+            stepper->runBackward();
+        }
+    }
+    return false;
+}
+
 // Implementation of the homing logic, now as a class method
 bool Homing::homeAllAxes() {
     Serial.println("Starting Home All Axes sequence...");
@@ -53,15 +88,11 @@ bool Homing::homeAllAxes() {
     Serial.println("Homing: Starting homing sequence proper...");
 
     // Log initial switch states before any homing movement
-    Serial.println("Homing: Initial switch states (before movement, after Bounce2 update):");
-    _xHomeSwitch.update();
-    Serial.printf("  X Home Switch (Pin %d): Raw State = %d, Bounce2 State = %d\n", X_HOME_SWITCH, digitalRead(X_HOME_SWITCH), _xHomeSwitch.read());
-    _yLeftHomeSwitch.update();
-    Serial.printf("  Y Left Home Switch (Pin %d): Raw State = %d, Bounce2 State = %d\n", Y_LEFT_HOME_SWITCH, digitalRead(Y_LEFT_HOME_SWITCH), _yLeftHomeSwitch.read());
-    _yRightHomeSwitch.update();
-    Serial.printf("  Y Right Home Switch (Pin %d): Raw State = %d, Bounce2 State = %d\n", Y_RIGHT_HOME_SWITCH, digitalRead(Y_RIGHT_HOME_SWITCH), _yRightHomeSwitch.read());
-    _zHomeSwitch.update();
-    Serial.printf("  Z Home Switch (Pin %d): Raw State = %d, Bounce2 State = %d\n", Z_HOME_SWITCH, digitalRead(Z_HOME_SWITCH), _zHomeSwitch.read());
+    Serial.println("Homing: Initial switch states (before movement):");
+    Serial.printf("  X Home Switch (Pin %d): Raw State = %d, Debounced State = %d\n", X_HOME_SWITCH, digitalRead(X_HOME_SWITCH), inputActive(INPUT_X_HOME));
+    Serial.printf("  Y Left Home Switch (Pin %d): Raw State = %d, Debounced State = %d\n", Y_LEFT_HOME_SWITCH, digitalRead(Y_LEFT_HOME_SWITCH), inputActive(INPUT_Y_LEFT_HOME));
+    Serial.printf("  Y Right Home Switch (Pin %d): Raw State = %d, Debounced State = %d\n", Y_RIGHT_HOME_SWITCH, digitalRead(Y_RIGHT_HOME_SWITCH), inputActive(INPUT_Y_RIGHT_HOME));
+    Serial.printf("  Z Home Switch (Pin %d): Raw State = %d, Debounced State = %d\n", Z_HOME_SWITCH, digitalRead(Z_HOME_SWITCH), inputActive(INPUT_Z_HOME));
 
     //! STEP 2: Configure switch pins (pins attached in constructor)
     
@@ -92,12 +123,12 @@ bool Homing::homeAllAxes() {
     // rotationActuallyHomed will be set later
     // rotationHomed will be evaluated later
 
-    _xHomeSwitch.update(); // Initial read before moving
-    if (_xHomeSwitch.read() != HIGH) {
+    if (!inputActive(INPUT_X_HOME)) {
         Serial.println("  X not at switch, starting X homing movement.");
         // Debug: Check direction pin state BEFORE runBackward()
         pinMode(X_DIR_PIN, OUTPUT); // Ensure pin mode is set if not already
         Serial.printf("  DEBUG: X_DIR_PIN (%d) state before runBackward: %d\n", X_DIR_PIN, digitalRead(X_DIR_PIN));
+        inputArmEdgeLatch(INPUT_X_HOME);
         _stepperX->runBackward(); 
         Serial.printf("  DEBUG: X_DIR_PIN (%d) state AFTER runBackward: %d\n", X_DIR_PIN, digitalRead(X_DIR_PIN));
     } else {
@@ -107,9 +138,9 @@ bool Homing::homeAllAxes() {
         xHomed = true; 
     }
 
-    _yLeftHomeSwitch.update();
-    if (_yLeftHomeSwitch.read() != HIGH) {
+    if (!inputActive(INPUT_Y_LEFT_HOME)) {
         Serial.println("  Y-Left not at switch, starting Y-Left homing movement.");
+        inputArmEdgeLatch(INPUT_Y_LEFT_HOME);
         _stepperY_Left->runBackward();
     } else {
         Serial.println("  Y-Left already at switch, marking as homed.");
@@ -118,9 +149,9 @@ bool Homing::homeAllAxes() {
         yLeftHomed = true;
     }
 
-    _yRightHomeSwitch.update();
-    if (_yRightHomeSwitch.read() != HIGH) {
+    if (!inputActive(INPUT_Y_RIGHT_HOME)) {
         Serial.println("  Y-Right not at switch, starting Y-Right homing movement.");
+        inputArmEdgeLatch(INPUT_Y_RIGHT_HOME);
         _stepperY_Right->runBackward();
     } else {
         Serial.println("  Y-Right already at switch, marking as homed.");
@@ -129,10 +160,10 @@ bool Homing::homeAllAxes() {
         yRightHomed = true;
     }
 
-    _zHomeSwitch.update();
     // Assuming Z home switch is also HIGH when triggered and Z moves UP (forward) to home
-    if (_zHomeSwitch.read() != HIGH) { 
+    if (!inputActive(INPUT_Z_HOME)) { 
         Serial.println("  Z not at switch, starting Z homing movement.");
+        inputArmEdgeLatch(INPUT_Z_HOME);
         _stepperZ->runForward(); 
     } else {
         Serial.println("  Z already at switch, marking as homed.");
@@ -154,8 +185,12 @@ bool Homing::homeAllAxes() {
     bool rotationHomed = (rotationStepper == NULL) || rotationActuallyHomed; // True if no stepper or if homing completed
     
     unsigned long startTime = millis();
+    unsigned long xLatchedAtMs = 0; // Set while stopped on a latched edge awaiting confirmation
+    unsigned long yLeftLatchedAtMs = 0;
+    unsigned long yRightLatchedAtMs = 0;
+    unsigned long zLatchedAtMs = 0;
     
-    //! STEP 6: Monitor all switches simultaneously using Bounce2
+    //! STEP 6: Monitor all switches simultaneously (latched by interrupt, confirmed by the input sampler)
     // Rotation is already handled if present, so loop focuses on X, Y, Z
     while (!xHomed || !yLeftHomed || !yRightHomed || !zHomed) { // Removed !rotationHomed from this condition
         //? Check timeout
@@ -166,6 +201,9 @@ bool Homing::homeAllAxes() {
             if (!yLeftHomed && _stepperY_Left->isRunning()) _stepperY_Left->forceStopAndNewPosition(_stepperY_Left->getCurrentPosition());
             if (!yRightHomed && _stepperY_Right->isRunning()) _stepperY_Right->forceStopAndNewPosition(_stepperY_Right->getCurrentPosition()); // Stop Y Right too
             if (!zHomed && _stepperZ->isRunning()) _stepperZ->forceStopAndNewPosition(_stepperZ->getCurrentPosition());
+            for (int i = 0; i < INPUT_COUNT; i++) {
+                inputDisarmEdgeLatch((InputId)i);
+            }
             // Rotation stepper is already stopped if it was homed, or forceStop if it was stuck in rotateToAngle (though unlikely with its internal timeout)
             if (rotationStepper && rotationStepper->isRunning()) { // Check if it somehow got stuck despite blocking call
                  rotationStepper->forceStopAndNewPosition(rotationStepper->getCurrentPosition());
@@ -174,67 +212,39 @@ bool Homing::homeAllAxes() {
             return false;
         }
         
-        //! Process X switch with Bounce2
+        //! Process X switch
         if (!xHomed) { // Only process if not already marked homed
-            _xHomeSwitch.update();
-            if (_xHomeSwitch.read() == HIGH) { 
-                // _stepperX->forceStopAndNewPosition(0); // Original line
-                if (_stepperX->isRunning()) { // Only stop if it was actually running towards switch
-                    _stepperX->forceStopAndNewPosition(0);
-                } else { // If it wasn't running but switch is high, it means it was pre-homed or an edge case
-                    _stepperX->setCurrentPosition(0); // Ensure logical position is 0
-                }
+            if (seekSwitch(_stepperX, INPUT_X_HOME, false, xLatchedAtMs)) {
                 xHomed = true;
                 Serial.println("X Home switch triggered (during while loop).");
             }
         }
         
-        //! Process Y Left switch with Bounce2
+        //! Process Y Left switch
         if (!yLeftHomed) {
-            _yLeftHomeSwitch.update();
-            if (_yLeftHomeSwitch.read() == HIGH) { 
-                // _stepperY_Left->forceStopAndNewPosition(0); // Original line
-                if (_stepperY_Left->isRunning()) {
-                    _stepperY_Left->forceStopAndNewPosition(0);
-                } else {
-                    _stepperY_Left->setCurrentPosition(0);
-                }
+            if (seekSwitch(_stepperY_Left, INPUT_Y_LEFT_HOME, false, yLeftLatchedAtMs)) {
                 yLeftHomed = true;
                 Serial.println("Y Left Home switch triggered (during while loop).");
             }
         }
         
-        //! Process Y Right switch with Bounce2
+        //! Process Y Right switch
         if (!yRightHomed) {
-            _yRightHomeSwitch.update();
-            if (_yRightHomeSwitch.read() == HIGH) { 
-                // _stepperY_Right->forceStopAndNewPosition(0); // Original line
-                if (_stepperY_Right->isRunning()) {
-                    _stepperY_Right->forceStopAndNewPosition(0);
-                } else {
-                    _stepperY_Right->setCurrentPosition(0);
-                }
+            if (seekSwitch(_stepperY_Right, INPUT_Y_RIGHT_HOME, false, yRightLatchedAtMs)) {
                 yRightHomed = true;
                 Serial.println("Y Right Home switch triggered (during while loop).");
             }
         }
         
-        //! Process Z switch with Bounce2
+        //! Process Z switch
         if (!zHomed) {
-            _zHomeSwitch.update();
-            if (_zHomeSwitch.read() == HIGH) { 
-                // _stepperZ->forceStopAndNewPosition(0); // Original line
-                if (_stepperZ->isRunning()) {
-                    _stepperZ->forceStopAndNewPosition(0);
-                } else {
-                    _stepperZ->setCurrentPosition(0);
-                }
+            if (seekSwitch(_stepperZ, INPUT_Z_HOME, true, zLatchedAtMs)) {
                 zHomed = true;
                 Serial.println("Z Home switch triggered (during while loop).");
             }
         }
         
-        yield(); // Allow other tasks to run
+        eventLoopSleep(EVENT_LOOP_MOTION_POLL_MS); // Woken at once by a latched switch edge
     }
     
     //! STEP 7: All switches triggered
@@ -0,0 +1,42 @@
+#include "motors/MotionProfile.h"
+#include <math.h>
+
+//* ************************************************************************
+//* ************************* MOTION PROFILE *******************************
+//* ************************************************************************
+
+MotionProfile computeTrapezoid(long distanceSteps, float maxSpeed, float accel) {
+    MotionProfile profile = {};
+    profile.distance = fabsf((float)distanceSteps);
+    profile.accel = accel;
+    if (profile.distance <= 0.0f || maxSpeed <= 0.0f || accel <= 0.0f) {
+        return profile; // No motion
+    }
+
+    float fullRampDistance = (maxSpeed * maxSpeed) / (2.0f * accel);
+    if (2.0f * fullRampDistance >= profile.distance) {
+        // Triangular: never reaches maxSpeed
+        profile.rampDistance = profile.distance / 2.0f;
+        profile.peakSpeed = sqrtf(accel * profile.distance);
+    } else {
+        profile.rampDistance = fullRampDistance;
+        profile.peakSpeed = maxSpeed;
+    }
+    profile.rampTime = profile.peakSpeed / accel;
+    float cruiseDistance = profile.distance - 2.0f * profile.rampDistance;
+    profile.totalTime = 2.0f * profile.rampTime + cruiseDistance / profile.peakSpeed;
+    return profile;
+}
+
+float profileTimeForEdgeDistance(const MotionProfile& profile, float steps) {
+    if (profile.totalTime <= 0.0f || steps <= 0.0f) {
+        return 0.0f;
+    }
+    float t;
+    if (steps <= profile.rampDistance) {
+        t = sqrtf(2.0f * steps / profile.accel);
+    } else {
+        t = profile.rampTime + (steps - profile.rampDistance) / profile.peakSpeed;
+    }
+    return t < profile.totalTime ? t : profile.totalTime;
+}
@@ -1,5 +1,9 @@
 #include "motors/Rotation_Motor.h"
 #include "utils/settings.h"
+#include "system/EventLoop.h"
+#include "system/Supervisor.h"
+#include "system/Logger.h"
+#include "system/MotionAbort.h"
 
 // Define the global rotation stepper pointer
 FastAccelStepper *rotationStepper = NULL;
@@ -32,6 +36,10 @@ void rotateToAngle(float angle) {
         Serial.println("ERROR: Rotation stepper not initialized!");
         return;
     }
+    if (motionAbortPending()) {
+        logWarn("HOME pending - rotation skipped");
+        return; // Unwinding to homing
+    }
 
     // Get current position and angle
     long currentPosition = rotationStepper->getCurrentPosition();
@@ -50,8 +58,8 @@ void rotateToAngle(float angle) {
     // Calculate the target absolute angle for logging purposes (optional, but helpful)
     float targetAngleNormalized = currentAngle + deltaAngle;
 
-    Serial.printf("Current Angle: %.2f, Target Angle: %.2f, Delta: %.2f degrees\n", currentAngle, angle, deltaAngle);
-    Serial.printf("Rotating by %ld steps (relative) to reach %.2f degrees\n", relativeSteps, targetAngleNormalized);
+    logInfo("Current Angle: %.2f, Target Angle: %.2f, Delta: %.2f degrees", currentAngle, angle, deltaAngle);
+    logInfo("Rotating by %ld steps (relative) to reach %.2f degrees", relativeSteps, targetAngleNormalized);
 
     // Set speed and acceleration (optional, can be set once during setup if constant)
     rotationStepper->setSpeedInHz(DEFAULT_ROT_SPEED);
@@ -59,21 +67,34 @@ void rotateToAngle(float angle) {
 
     // Add stopMove() before move()
     rotationStepper->stopMove(); 
-    Serial.println("DEBUG: Called stopMove() before rotationStepper->move()");
+    logDebug("Called stopMove() before rotationStepper->move()");
 
     // Move the stepper relatively
+    supervisorSegmentBegin("rotateToAngle", ROTATION_MOVE_TIMEOUT_MS);
+    unsigned long startMs = millis();
     rotationStepper->move(relativeSteps);
 
     // Wait for rotation to complete
+    bool aborted = false;
     while (rotationStepper->isRunning()) {
-        // Yield or delay briefly to allow background tasks and prevent busy-waiting
-        delay(10); 
+        if (!aborted && motionAbortPending()) {
+            logWarn("HOME command received during rotation - ramping down");
+            rotationStepper->stopMove(); // Then wait out the deceleration
+            aborted = true;
+        }
+        if (millis() - startMs > ROTATION_MOVE_TIMEOUT_MS) {
+            logError("ERROR: Rotation timeout! Stopping rotation motor.");
+            rotationStepper->forceStop();
+            break;
+        }
+        eventLoopSleep(EVENT_LOOP_MOTION_POLL_MS);
     }
+    supervisorSegmentEnd();
     
     // Recalculate final angle based on actual final position for accuracy
     long finalPosition = rotationStepper->getCurrentPosition();
     float finalAngle = (float)finalPosition / STEPS_PER_DEGREE;
-    Serial.printf("Rotation complete - Final Position: %ld steps (%.2f degrees)\n", finalPosition, finalAngle);
+    logInfo("Rotation complete - Final Position: %ld steps (%.2f degrees)", finalPosition, finalAngle);
 }
 
 // Implement other rotation-specific functions here if needed 
\ No newline at end of file
@@ -5,8 +5,12 @@
 
 // Include motor control library
 #include <FastAccelStepper.h>
-#include <Bounce2.h>   // For debouncing limit switches
+#include "hardware/InputSampler.h" // Timer debounced limit switches
 #include "web/Web_Dashboard_Commands.h" // For checking home commands
+#include "system/EventLoop.h" // Wait loops sleep until the next event
+#include "system/Supervisor.h" // Moves are timed against a budget
+#include "system/Logger.h" // Per-move and per-poll messages are deferred
+#include "system/MotionAbort.h" // No new move while HOME is pending
 
 // Define stepper engine and steppers (example)
 extern FastAccelStepperEngine engine; // Use the global one from Setup.cpp
@@ -15,14 +19,6 @@ extern FastAccelStepper *stepperY_Left; // Renamed from stepperY
 extern FastAccelStepper *stepperY_Right; // Added second Y motor
 extern FastAccelStepper *stepperZ;
 
-// Switch debouncing objects
-extern Bounce debounceX;
-extern Bounce debounceY_Left; // Renamed from debounceY
-extern Bounce debounceY_Right; // Added second Y debouncer
-extern Bounce debounceZ;
-
-extern volatile bool homeCommandReceived; // For direct access to the flag
-
 //* ************************************************************************
 //* ************************* XYZ MOVEMENTS **************************
 //* ************************************************************************
@@ -64,12 +60,27 @@ void setupMotors() {
 }
 */
 
+// Supervisor budget for a move: the slowest axis decides
+static unsigned long moveBudgetMs(long x, unsigned int xSpeed, long y, unsigned int ySpeed, long z, unsigned int zSpeed) {
+    unsigned long budgetMs = supervisorMoveBudgetMs(x - stepperX->getCurrentPosition(), xSpeed);
+    budgetMs = max(budgetMs, supervisorMoveBudgetMs(y - stepperY_Left->getCurrentPosition(), ySpeed));
+    budgetMs = max(budgetMs, supervisorMoveBudgetMs(y - stepperY_Right->getCurrentPosition(), ySpeed));
+    return max(budgetMs, supervisorMoveBudgetMs(z - stepperZ->getCurrentPosition(), zSpeed));
+}
+
 void moveToXYZ(long x, unsigned int xSpeed, long y, unsigned int ySpeed, long z, unsigned int zSpeed) {
+    // Code unwinding from a HOME abort must not start a new move
+    if (motionAbortPending()) {
+        checkForHomeCommand(); // Ramps down anything still running
+        return;
+    }
+
     // Set speed for each stepper individually
     stepperX->setSpeedInHz(xSpeed);
     stepperY_Left->setSpeedInHz(ySpeed); // Renamed
     stepperY_Right->setSpeedInHz(ySpeed); // Added second Y motor speed
     stepperZ->setSpeedInHz(zSpeed);
+    supervisorSegmentBegin("moveToXYZ", moveBudgetMs(x, xSpeed, y, ySpeed, z, zSpeed));
     
     // Command the move to the absolute position
     stepperX->moveTo(x);
@@ -78,37 +89,42 @@ void moveToXYZ(long x, unsigned int xSpeed, long y, unsigned int ySpeed, long z,
     stepperZ->moveTo(z);
     
     // Wait until all steppers have completed their movements
+    bool aborted = false;
     while (stepperX->isRunning() || stepperY_Left->isRunning() || stepperY_Right->isRunning() || stepperZ->isRunning()) { // Updated condition
         // Check for limit switches while running
         checkMotors();
         
-        // Also check for home command during movement
+        // Also check for home command during movement (axes are ramped down by the check)
         if (checkForHomeCommand()) {
-            // Home command received, stop all motors immediately
-            Serial.println("HOME command received during movement - aborting movement");
-            stepperX->forceStopAndNewPosition(stepperX->getCurrentPosition());
-            stepperY_Left->forceStopAndNewPosition(stepperY_Left->getCurrentPosition());
-            stepperY_Right->forceStopAndNewPosition(stepperY_Right->getCurrentPosition());
-            stepperZ->forceStopAndNewPosition(stepperZ->getCurrentPosition());
+            logWarn("HOME command received during movement - aborting movement");
+            aborted = true;
             break; // Exit the wait loop
         }
         
-        delay(5); // Reduced delay to check more frequently
+        eventLoopSleep(EVENT_LOOP_MOTION_POLL_MS); // Wakes early on HOME
     }
+    supervisorSegmentEnd();
     
-    if (!homeCommandReceived) {
-        Serial.printf("Move complete - Position: X:%ld Y_L:%ld Y_R:%ld Z:%ld\n", stepperX->getCurrentPosition(), stepperY_Left->getCurrentPosition(), stepperY_Right->getCurrentPosition(), stepperZ->getCurrentPosition()); // Updated printf
+    if (!aborted) {
+        logInfo("Move complete - Position: X:%ld Y_L:%ld Y_R:%ld Z:%ld", stepperX->getCurrentPosition(), stepperY_Left->getCurrentPosition(), stepperY_Right->getCurrentPosition(), stepperZ->getCurrentPosition());
     }
 }
 
 // New function that checks for home command during movement
 // Returns true if movement completed, false if aborted due to home command
 bool moveToXYZ_HomeCheck(long x, unsigned int xSpeed, long y, unsigned int ySpeed, long z, unsigned int zSpeed) {
+    // Code unwinding from a HOME abort must not start a new move
+    if (motionAbortPending()) {
+        checkForHomeCommand(); // Ramps down anything still running
+        return false;
+    }
+
     // Set speed for each stepper individually
     stepperX->setSpeedInHz(xSpeed);
     stepperY_Left->setSpeedInHz(ySpeed);
     stepperY_Right->setSpeedInHz(ySpeed);
     stepperZ->setSpeedInHz(zSpeed);
+    supervisorSegmentBegin("moveToXYZ", moveBudgetMs(x, xSpeed, y, ySpeed, z, zSpeed));
     
     // Command the move to the absolute position
     stepperX->moveTo(x);
@@ -121,21 +137,18 @@ bool moveToXYZ_HomeCheck(long x, unsigned int xSpeed, long y, unsigned int ySpee
         // Check for limit switches while running
         checkMotors();
         
-        // Also check for home command during movement
+        // Also check for home command during movement (axes are ramped down by the check)
         if (checkForHomeCommand()) {
-            // Home command received, stop all motors immediately
-            Serial.println("HOME command received during movement - aborting movement");
-            stepperX->forceStopAndNewPosition(stepperX->getCurrentPosition());
-            stepperY_Left->forceStopAndNewPosition(stepperY_Left->getCurrentPosition());
-            stepperY_Right->forceStopAndNewPosition(stepperY_Right->getCurrentPosition());
-            stepperZ->forceStopAndNewPosition(stepperZ->getCurrentPosition());
+            logWarn("HOME command received during movement - aborting movement");
+            supervisorSegmentEnd();
             return false; // Movement aborted
         }
         
-        delay(5); // Reduced delay to check more frequently
+        eventLoopSleep(EVENT_LOOP_MOTION_POLL_MS); // Wakes early on HOME
     }
+    supervisorSegmentEnd();
     
-    Serial.printf("Move complete - Position: X:%ld Y_L:%ld Y_R:%ld Z:%ld\n", 
+    logInfo("Move complete - Position: X:%ld Y_L:%ld Y_R:%ld Z:%ld", 
                  stepperX->getCurrentPosition(), 
                  stepperY_Left->getCurrentPosition(), 
                  stepperY_Right->getCurrentPosition(), 
@@ -145,40 +158,34 @@ bool moveToXYZ_HomeCheck(long x, unsigned int xSpeed, long y, unsigned int ySpee
 
 // This function replaces checkSwitches from Functionality.cpp
 void checkMotors() {
-    // Update debouncers
-    debounceX.update();
-    debounceY_Left.update(); // Renamed
-    debounceY_Right.update(); // Added second Y debouncer update
-    debounceZ.update();
-
-    // Read switch states
-    bool limitX = debounceX.read() == HIGH; // HIGH when triggered (assuming active high)
-    bool limitY_Left = debounceY_Left.read() == HIGH; // Renamed & active high
-    bool limitY_Right = debounceY_Right.read() == HIGH; // Added second Y switch read & active high
-    bool limitZ = debounceZ.read() == HIGH; // active high
+    // Read debounced switch states (sampled by the input timer)
+    bool limitX = inputActive(INPUT_X_HOME);
+    bool limitY_Left = inputActive(INPUT_Y_LEFT_HOME);
+    bool limitY_Right = inputActive(INPUT_Y_RIGHT_HOME);
+    bool limitZ = inputActive(INPUT_Z_HOME);
     
     // Example of using switch readings (add your own logic)
     if (limitX) {
-        Serial.println("X limit switch triggered");
+        logDebug("X limit switch triggered"); // Every poll while held
         // Take action like stopping X motor
         // stepperX->forceStop(); // Example action
     }
     
     // Similar handling for Y and Z
     if (limitY_Left) {
-        Serial.println("Y Left limit switch triggered");
+        logDebug("Y Left limit switch triggered"); // Every poll while held
         // Take action like stopping Y motors during homing or if unexpected
         // stepperY_Left->forceStop(); // Example action
         // stepperY_Right->forceStop(); // Example action (if gantry safety requires stopping both)
     }
     if (limitY_Right) {
-        Serial.println("Y Right limit switch triggered");
+        logDebug("Y Right limit switch triggered"); // Every poll while held
         // Take action like stopping Y motors during homing or if unexpected
         // stepperY_Left->forceStop(); // Example action (if gantry safety requires stopping both)
         // stepperY_Right->forceStop(); // Example action
     }
     if (limitZ) {
-        Serial.println("Z limit switch triggered");
+        logDebug("Z limit switch triggered"); // Every poll while held
         // Take action like stopping Z motor
         // stepperZ->forceStop(); // Example action
     }
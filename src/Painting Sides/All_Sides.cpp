@@ -9,6 +9,12 @@
 #include <FastAccelStepper.h>    // Added for stepper extern declarations
 #include "motors/Homing.h"      // For Homing class and homeAllAxes()
 #include "motors/Rotation_Motor.h" // For rotation motor reset
+#include "system/PaintProgress.h" // For pass-level pause/resume
+#include "system/DryWindow.h"     // Work scheduled into the inter-coat delay
+#include "system/Fixtures.h"      // Fixture origins for interleaved coats
+#include "storage/TrayLayouts.h"  // Occupied cells for tray jobs
+#include "system/EventLoop.h"      // Waits that end early on HOME
+#include "system/MotionAbort.h"    // HOME during the final rotation reset
 
 extern ServoMotor myServo; // Added for cleaning burst
 extern FastAccelStepper *stepperX;      // Added for Z move
@@ -21,16 +27,18 @@ extern FastAccelStepper *rotationStepper; // ADDED for rotation motor reset
 
 // Global variable definition for requested coats
 int g_requestedCoats = 3; // Default to 3 coats
+bool g_requestedTrayJob = false; // Next job paints the occupied tray cells
 int g_interCoatDelaySeconds = 10; // ADDED: Default 10 seconds delay
 
 //* ************************************************************************
 //* ********************** ALL SIDES PAINTING ************************
 //* ************************************************************************
 // This file handles the sequence of painting all sides of the piece in three runs
-// Each run follows the same pattern (sides 4, 3, 2) with a loading bar animation
-// between runs to show progress during the delay time.
-// This file handles the sequence of painting all sides of the piece in a single run
-// painting sides 4, 3, and 2.
+// Each run follows the same pattern (sides 4, 3, 2) with a dry window between
+// runs that is used for cleaning and checks (see DryWindow.h). With several
+// fixtures enabled the runs are interleaved so one part dries while the next
+// is painted (see Fixtures.h). A tray job paints every part PnP placed,
+// side by side across the tray (see _paintTrayCoats).
 
 // Cleaning parameters
 const float CLEANING_X_INCH = 0.0;
@@ -42,9 +50,19 @@ const unsigned int CLEANING_Z_SPEED = 4000;
 
 // const unsigned long ALL_SIDES_REPEAT_DELAY_MS = 10 * 1000; // REMOVED: Replaced by g_interCoatDelaySeconds
 
-// Define the loading bar X position as a constant to ensure consistency
-const float LOADING_BAR_X_START = 24.0f;
-const float LOADING_BAR_X_END = 0.0f;
+// Order in which the sides are painted within one coat
+struct PaintSideStep {
+    int side;
+    void (*pattern)();
+    const char* label;
+};
+
+static const PaintSideStep PAINT_SIDE_SEQUENCE[] = {
+    {4, paintSide4Pattern, "Left Side (Side 4)"},
+    {3, paintSide3Pattern, "Back Side (Side 3)"},
+    {2, paintSide2Pattern, "Right Side (Side 2)"},
+    {1, paintSide1Pattern, "Front Side (Side 1)"}
+};
 
 // Helper function to prepare for the next painting sequence
 // This only does minimal preparation to ensure consistent painting
@@ -62,7 +80,7 @@ void _prepareForPaintingSequence() {
 }
 
 // Helper function for a single painting sequence
-// Returns true if completed, false if aborted by home command
+// Returns true if completed, false if aborted by home command or paused
 bool _executeSinglePaintAllSidesSequence(const char* runLabel) {
     Serial.print("Starting All Sides Painting Sequence (");
     Serial.print(runLabel);
@@ -78,36 +96,31 @@ bool _executeSinglePaintAllSidesSequence(const char* runLabel) {
     Serial.println(")");
     // Note: Servo angle should be set by individual side patterns as needed.
     
-    //! STEP 1: Paint left side (Side 4)
-    Serial.print("Starting Left Side (Side 4) ("); Serial.print(runLabel); Serial.println(")");
-    paintSide4Pattern();
-    if (checkForHomeCommand()) {
-        Serial.print("All Sides Painting ABORTED ("); Serial.print(runLabel); Serial.println(", after left side)");
-        return false;
-    }
+    //! STEPS 1-4: Paint sides 4, 3, 2, 1
+    for (size_t i = 0; i < sizeof(PAINT_SIDE_SEQUENCE) / sizeof(PAINT_SIDE_SEQUENCE[0]); ++i) {
+        const PaintSideStep& step = PAINT_SIDE_SEQUENCE[i];
+
+        if (paintJobShouldSkipSide(step.side)) {
+            Serial.print("Skipping "); Serial.print(step.label); Serial.print(" (already painted before pause) (");
+            Serial.print(runLabel); Serial.println(")");
+            continue;
+        }
 
-    //! STEP 2: Paint back side (Side 3)
-    Serial.print("Starting Back Side (Side 3) ("); Serial.print(runLabel); Serial.println(")");
-    paintSide3Pattern();
-    if (checkForHomeCommand()) {
-        Serial.print("All Sides Painting ABORTED ("); Serial.print(runLabel); Serial.println(", after back side)");
-        return false;
-    }
+        // Side boundary: a pending PAUSE checkpoints at pass 0 of this side
+        paintJobBeginSide(step.side);
+        if (paintJobStopRequested()) {
+            Serial.print("All Sides Painting STOPPED before "); Serial.print(step.label);
+            Serial.print(" ("); Serial.print(runLabel); Serial.println(")");
+            return false;
+        }
 
-    //! STEP 3: Paint right side (Side 2)
-    Serial.print("Starting Right Side (Side 2) ("); Serial.print(runLabel); Serial.println(")");
-    paintSide2Pattern();
-    if (checkForHomeCommand()) {
-        Serial.print("All Sides Painting ABORTED ("); Serial.print(runLabel); Serial.println(", after right side)");
-        return false;
-    }
-    
-    //! STEP 4: Paint front side (Side 1)
-    Serial.print("Starting Front Side (Side 1) ("); Serial.print(runLabel); Serial.println(")");
-    paintSide1Pattern();
-    if (checkForHomeCommand()) {
-        Serial.print("All Sides Painting ABORTED ("); Serial.print(runLabel); Serial.println(", after front side)");
-        return false;
+        Serial.print("Starting "); Serial.print(step.label); Serial.print(" ("); Serial.print(runLabel); Serial.println(")");
+        step.pattern();
+        if (checkForHomeCommand() || !isPaintJobRunning()) {
+            Serial.print("All Sides Painting STOPPED ("); Serial.print(runLabel); Serial.print(", after ");
+            Serial.print(step.label); Serial.println(")");
+            return false;
+        }
     }
 
     //! Check if pressure pot needs to be turned on
@@ -126,7 +139,8 @@ bool _executeSinglePaintAllSidesSequence(const char* runLabel) {
                 Serial.println(", during pressure pot pressurization)");
                 return false;
             }
-            delay(10); // Short delay between checks
+            unsigned long waited = millis() - pressureStartTime;
+            eventLoopSleep(waited < 1000 ? 1000 - waited : 0); // Wakes early on HOME
         }
         
         Serial.print("Pressurization complete. (");
@@ -145,160 +159,262 @@ bool _executeSinglePaintAllSidesSequence(const char* runLabel) {
     return true;
 } 
 
-// Main function to be called externally
-void paintAllSides() {
-    Serial.printf("Initiating All Sides Painting Process for %d coat(s).\n", g_requestedCoats);
-    int totalCoats = g_requestedCoats; // Capture the requested coats
-    g_requestedCoats = 1; // Reset global for next time, unless set again by command
+// Handles a run that stopped early. Returns after a pause (job kept) or
+// aborts the job.
+static void _handleStoppedRun(const char* runLabel) {
+    if (isPaintJobPaused()) {
+        Serial.printf("Painting %s paused. Waiting for RESUME.\n", runLabel);
+        return; // Keep the job and its checkpoint
+    }
+    Serial.printf("Painting %s aborted. Process terminated.\n", runLabel);
+    paintJobAbort();
+}
+
+//! Coat scheduler: coats are interleaved across the enabled fixtures
+// (A1 B1 A2 B2 ...), so one part is painted while the others dry. Before
+// each coat the part's own dry time is enforced; whatever is left of it
+// runs as a dry window. With a single fixture this is the plain
+// coat / delay / coat sequence. Returns false if the job stopped.
+static bool _paintFixtureCoats(int startCoat, int totalCoats) {
+    unsigned long dryTimeMs = (unsigned long)g_interCoatDelaySeconds * 1000UL;
+    unsigned long coatDoneAt[MAX_FIXTURES] = {};
+    bool hasWetCoat[MAX_FIXTURES] = {};
+
+    if (isPaintJobResuming()) {
+        // When the previous coats finished is not known after a pause or
+        // reset: give every part that already has paint on it a full dry time.
+        const PaintCheckpoint& cp = paintJobCheckpoint();
+        for (int fixture = 0; fixture < MAX_FIXTURES; ++fixture) {
+            if (fixture != cp.fixture && (startCoat > 1 || fixture < cp.fixture)) {
+                coatDoneAt[fixture] = millis();
+                hasWetCoat[fixture] = true;
+            }
+        }
+    }
+    Serial.printf("Painting on %d fixture(s), minimum dry time %lu ms.\n", enabledFixtureCount(), dryTimeMs);
+
+    for (int coat = startCoat; coat <= totalCoats; ++coat) {
+        paintJobBeginCoat(coat);
 
-    for (int coat = 1; coat <= totalCoats; ++coat) {
-        char runLabel[10];
-        snprintf(runLabel, sizeof(runLabel), "Run %d", coat);
-        Serial.printf("Starting %s of %d\n", runLabel, totalCoats);
+        for (int fixture = 0; fixture < MAX_FIXTURES; ++fixture) {
+            if (!getFixture(fixture).enabled || paintJobShouldSkipFixture(fixture)) {
+                continue;
+            }
+
+            char runLabel[20];
+            snprintf(runLabel, sizeof(runLabel), "Run %d, Fixture %d", coat, fixture + 1);
+
+            // --- Inter-coat Dry Window ---
+            // The part dries while background work (gun clean, drift check)
+            // runs; progress is shown on the dashboard. Patterns position themselves.
+            if (hasWetCoat[fixture]) {
+                unsigned long sinceCoat = millis() - coatDoneAt[fixture];
+                if (sinceCoat < dryTimeMs && !runDryWindow(dryTimeMs - sinceCoat, coat)) {
+                    Serial.printf("Home command during dry window before %s. Process terminated.\n", runLabel);
+                    return false;
+                }
+            }
+
+            Serial.printf("Starting %s (%d coat(s))\n", runLabel, totalCoats);
+            paintJobBeginFixture(fixture);
 
-        if (!_executeSinglePaintAllSidesSequence(runLabel)) {
-            Serial.printf("Painting %s aborted. Process terminated.\n", runLabel);
-            return; // Abort if the run was cancelled
+            if (!_executeSinglePaintAllSidesSequence(runLabel)) {
+                _handleStoppedRun(runLabel);
+                return false; // Abort if the run was cancelled
+            }
+
+            coatDoneAt[fixture] = millis();
+            hasWetCoat[fixture] = true;
+            Serial.printf("%s finished.\n", runLabel);
         }
+    }
+    return true;
+}
 
-        Serial.printf("%s finished.\n", runLabel);
+// Orders the occupied tray cells as a nearest-neighbour tour, starting with
+// the cell closest to fixture 1. Travel time between cells is estimated from
+// the per-axis distance at the default speeds. The order depends only on the
+// layout and occupancy, so a resumed job sees the same sequence.
+static int _buildTrayPaintOrder(int order[MAX_TRAY_CELLS]) {
+    int cells[MAX_TRAY_CELLS];
+    int count = 0;
+    for (int cell = 0; cell < trayLayouts.cellCount(); ++cell) {
+        if (trayLayouts.occupiedCells() & (1UL << cell)) {
+            cells[count++] = cell;
+        }
+    }
 
-        // If this was the last coat, skip the delay/loading bar
-        if (coat == totalCoats) {
-            break; 
+    long currentX = 0; // Fixture 1 reference
+    long currentY = 0;
+    for (int n = 0; n < count; ++n) {
+        int best = n;
+        float bestTime = 0.0f;
+        for (int i = n; i < count; ++i) {
+            float dx = fabsf((float)(trayLayouts.cellPaintOffsetXSteps(cells[i]) - currentX)) / DEFAULT_X_SPEED;
+            float dy = fabsf((float)(trayLayouts.cellPaintOffsetYSteps(cells[i]) - currentY)) / DEFAULT_Y_SPEED;
+            float time = max(dx, dy);
+            if (i == n || time < bestTime) {
+                bestTime = time;
+                best = i;
+            }
         }
+        int cell = cells[best];
+        cells[best] = cells[n];
+        cells[n] = cell;
+        order[n] = cell;
+        currentX = trayLayouts.cellPaintOffsetXSteps(cell);
+        currentY = trayLayouts.cellPaintOffsetYSteps(cell);
+    }
+    return count;
+}
 
-        // --- Inter-coat Delay and Loading Bar --- 
-        Serial.println("Preparing for inter-coat delay: Moving X to loading bar start position.");
-        long target_x_start_loading_bar_steps = (long)(LOADING_BAR_X_START * STEPS_PER_INCH_XYZ);
-        stepperX->setSpeedInHz(DEFAULT_X_SPEED); // Use standard speed for this move
-        stepperX->setAcceleration(DEFAULT_X_ACCEL);
-        stepperX->moveTo(target_x_start_loading_bar_steps);
-        
-        while (stepperX->isRunning()) {
-            if (checkForHomeCommand()) {
-                Serial.printf("Home command during move to loading bar start before coat %d. Process terminated.\n", coat + 1);
-                stepperX->forceStopAndNewPosition(stepperX->getCurrentPosition());
-                return;
+// Tour direction of a side: it alternates from side to side and carries on
+// across coats, so a side starts next to where the previous one ended and a
+// new coat starts with the cell that finished the last one first (and has
+// dried longest).
+static bool _trayTourForward(int coat, int sideIndex, int sideCount) {
+    return ((coat - 1) * (sideCount - 1) + sideIndex) % 2 == 0;
+}
+
+//! Tray scheduler: each coat paints one side on every occupied cell before
+// moving to the next side. The patterns run in cell mode (see Fixtures.h):
+// rotation, servo and pressure pot are set up on the first cell of a side
+// and the gun goes straight from part to part. A cell's coat is done after
+// its last side; before a cell is painted again its dry time is enforced as
+// a dry window. Returns false if the job stopped.
+static bool _paintTrayCoats(int startCoat, int totalCoats) {
+    int order[MAX_TRAY_CELLS];
+    int count = _buildTrayPaintOrder(order);
+    const int sideCount = sizeof(PAINT_SIDE_SEQUENCE) / sizeof(PAINT_SIDE_SEQUENCE[0]);
+    unsigned long dryTimeMs = (unsigned long)g_interCoatDelaySeconds * 1000UL;
+    unsigned long coatDoneAt[MAX_TRAY_CELLS] = {};
+    bool hasWetCoat[MAX_TRAY_CELLS] = {};
+
+    if (count == 0) {
+        Serial.println("Tray job: no occupied cells recorded. Run PnP first.");
+        return true;
+    }
+    if (isPaintJobResuming() && startCoat > 1) {
+        // Only cells the first side has not reached yet still carry the
+        // previous coat (finish time unknown: full dry time). The checkpoint
+        // cell and the cells before it already started this coat.
+        const PaintCheckpoint& checkpoint = paintJobCheckpoint();
+        bool onFirstSide = checkpoint.side == PAINT_SIDE_SEQUENCE[0].side;
+        bool forward = _trayTourForward(startCoat, 0, sideCount);
+        bool reached = false;
+        for (int i = 0; onFirstSide && i < count; ++i) {
+            int cell = forward ? order[i] : order[count - 1 - i];
+            if (reached) {
+                coatDoneAt[cell] = millis();
+                hasWetCoat[cell] = true;
+            }
+            if (cell == checkpoint.fixture) {
+                reached = true;
             }
-            delay(1);
         }
-        Serial.println("Reached loading bar start position.");
-
-        // --- START: Custom servo and X-axis movement during inter-coat delay ---
-        // Serial.println("Inter-coat: Moving X to 5 inches from home.");
-        // long five_inches_from_home_steps = (long)(5.0f * STEPS_PER_INCH_XYZ);
-        // stepperX->moveTo(five_inches_from_home_steps);
-        // while (stepperX->isRunning()) {
-        //     if (checkForHomeCommand()) {
-        //         Serial.printf("Home command during X move to 5in before coat %d. Process terminated.\n", coat + 1);
-        //         stepperX->forceStopAndNewPosition(stepperX->getCurrentPosition());
-        //         return;
-        //     }
-        //     delay(1);
-        // }
-
-        // Serial.println("Inter-coat: Moving X to home (0 inches).");
-        // stepperX->moveTo(0); // Move to 0 (home)
-        // while (stepperX->isRunning()) {
-        //     if (checkForHomeCommand()) {
-        //         Serial.printf("Home command during X move to 0in before coat %d. Process terminated.\n", coat + 1);
-        //         stepperX->forceStopAndNewPosition(stepperX->getCurrentPosition());
-        //         return;
-        //     }
-        //     delay(1);
-        // }
-
-        // Serial.println("Inter-coat: Setting servo to 180 degrees.");
-        // myServo.setAngle(180);
-        // --- END: Custom servo and X-axis movement during inter-coat delay ---
-
-        Serial.println("Starting X-axis loading bar movement for delay.");
-        long target_x_end_loading_bar_steps = (long)(LOADING_BAR_X_END * STEPS_PER_INCH_XYZ);
-        float duration_seconds = (float)g_interCoatDelaySeconds; // NEW
-        long current_x_actual_start_steps = stepperX->getCurrentPosition(); // Should be LOADING_BAR_X_START
-
-        if (duration_seconds < 0.1f) { 
-            Serial.printf("Loading bar (%d) fallback: Simple timed wait for %d s.\n", coat, g_interCoatDelaySeconds);
-            unsigned long simpleDelayStartTime = millis();
-            while (millis() - simpleDelayStartTime < (unsigned long)g_interCoatDelaySeconds * 1000) { // NEW
-                if (checkForHomeCommand()) {
-                    Serial.printf("Home command during fallback wait (%d). Process terminated.\n", coat);
-                    return;
-                }
-                delay(10); 
+    }
+    Serial.printf("Painting %d tray cell(s) of '%s', minimum dry time %lu ms.\n",
+                  count, trayLayouts.active().name, dryTimeMs);
+
+    for (int coat = startCoat; coat <= totalCoats; ++coat) {
+        paintJobBeginCoat(coat);
+        _prepareForPaintingSequence();
+
+        for (int s = 0; s < sideCount; ++s) {
+            const PaintSideStep& step = PAINT_SIDE_SEQUENCE[s];
+            if (paintJobShouldSkipSide(step.side)) {
+                continue;
             }
-        } else {
-            long distance_steps = abs(target_x_end_loading_bar_steps - current_x_actual_start_steps);
-            float calculated_speed_hz = (distance_steps > 0 && duration_seconds > 0) ? ((float)distance_steps / duration_seconds) : 1.0f;
-            unsigned int speed_to_set_hz = (unsigned int)max(1.0f, calculated_speed_hz);
-
-            Serial.printf("Loading Bar (%d): Moving X from %.2f to %.2f over %.2f s (Speed: %u Hz).\n",
-                          coat, (float)current_x_actual_start_steps / STEPS_PER_INCH_XYZ, LOADING_BAR_X_END, duration_seconds, speed_to_set_hz);
-
-            stepperX->setSpeedInHz(speed_to_set_hz);
-            stepperX->setAcceleration(DEFAULT_X_ACCEL); 
-            stepperX->moveTo(target_x_end_loading_bar_steps);
-
-            while (stepperX->isRunning()) {
-                if (checkForHomeCommand()) {
-                    Serial.printf("Home command during loading bar (%d). Process terminated.\n", coat);
-                    stepperX->forceStopAndNewPosition(stepperX->getCurrentPosition());
-                    return;
+
+            bool forward = _trayTourForward(coat, s, sideCount);
+            setPatternCellMode(PATTERN_CELL_FIRST);
+            for (int i = 0; i < count; ++i) {
+                int cell = forward ? order[i] : order[count - 1 - i];
+                if (paintJobShouldSkipFixture(cell)) {
+                    continue;
+                }
+
+                char runLabel[32];
+                snprintf(runLabel, sizeof(runLabel), "Run %d, Side %d, Cell %d", coat, step.side, cell);
+
+                if (hasWetCoat[cell]) {
+                    unsigned long sinceCoat = millis() - coatDoneAt[cell];
+                    if (sinceCoat < dryTimeMs && !runDryWindow(dryTimeMs - sinceCoat, coat)) {
+                        Serial.printf("Home command during dry window before %s. Process terminated.\n", runLabel);
+                        return false;
+                    }
+                    if (sinceCoat < dryTimeMs) {
+                        setPatternCellMode(PATTERN_CELL_FIRST); // The window moved the gun away
+                    }
+                    hasWetCoat[cell] = false; // Dried; the rest of this coat needs no wait
+                }
+
+                paintJobBeginFixture(cell);
+                paintJobBeginSide(step.side);
+                if (paintJobStopRequested()) {
+                    _handleStoppedRun(runLabel);
+                    return false;
+                }
+
+                Serial.printf("Starting %s\n", runLabel);
+                step.pattern();
+                if (checkForHomeCommand() || !isPaintJobRunning()) {
+                    _handleStoppedRun(runLabel);
+                    return false;
+                }
+                setPatternCellMode(PATTERN_CELL_NEXT);
+
+                if (s == sideCount - 1) {
+                    coatDoneAt[cell] = millis();
+                    hasWetCoat[cell] = true;
                 }
-                delay(1);
             }
-            Serial.printf("Loading bar movement (%d) complete.\n", coat);
         }
-        
-        // At the end of the delay (and loading bar movement), X is at LOADING_BAR_X_END.
-        // For the next coat, the painting sequence will begin.
-        // The _executeSinglePaintAllSidesSequence might require X to be at a specific starting point or 0.
-        // For now, we assume the individual paintSideXPattern functions handle their initial positioning from wherever X is.
-        // If they need X at 0,0, then a move to 0,0 (or at least X=0) should happen before the next call to _executeSinglePaintAllSidesSequence.
-        // The current _prepareForPaintingSequence in _executeSinglePaintAllSidesSequence does not move X/Y/Z.
-        // This is acceptable for now, individual patterns should manage their start.
-
-        Serial.printf("Finished inter-coat delay for coat %d. Ready for coat %d.\n", coat, coat + 1);
+        Serial.printf("Tray coat %d finished.\n", coat);
+    }
+    return true;
+}
+
+// Main function to be called externally
+void paintAllSides() {
+    int totalCoats;
+    int startCoat = 1;
+    if (isPaintJobResuming()) {
+        // Continue a paused job from its checkpoint
+        totalCoats = paintJobTotalCoats();
+        startCoat = paintJobResumeCoat();
+        Serial.printf("Resuming All Sides Painting Process at coat %d of %d.\n", startCoat, totalCoats);
+    } else {
+        Serial.printf("Initiating All Sides Painting Process for %d coat(s).\n", g_requestedCoats);
+        totalCoats = g_requestedCoats; // Capture the requested coats
+        paintJobBegin(totalCoats, g_requestedTrayJob ? PAINT_JOB_TRAY : PAINT_JOB_FIXTURES);
+    }
+    g_requestedCoats = 1; // Reset global for next time, unless set again by command
+    g_requestedTrayJob = false;
+
+    bool completed = (paintJobMode() == PAINT_JOB_TRAY) ? _paintTrayCoats(startCoat, totalCoats)
+                                                         : _paintFixtureCoats(startCoat, totalCoats);
+    setPatternCellMode(PATTERN_STANDALONE); // Single side commands return to rest again
+    if (!completed) {
+        return;
     }
 
     Serial.println("All Sides Painting Process Fully Completed.");
+    paintJobEnd();
 
     //! Move to final resting position (3,3)
     Serial.println("Moving to final resting position (X=3 inches, Y=3 inches).");
     long target_x_final_steps = (long)(3.0f * STEPS_PER_INCH_XYZ);
     long target_y_final_steps = (long)(3.0f * STEPS_PER_INCH_XYZ);
 
-    stepperX->setSpeedInHz(DEFAULT_X_SPEED);
     stepperX->setAcceleration(DEFAULT_X_ACCEL);
-    stepperX->moveTo(target_x_final_steps);
-
-    stepperY_Left->setSpeedInHz(DEFAULT_Y_SPEED); // Assuming DEFAULT_Y_SPEED is defined
-    stepperY_Left->setAcceleration(DEFAULT_Y_ACCEL); // Assuming DEFAULT_Y_ACCEL is defined
-    stepperY_Left->moveTo(target_y_final_steps);
-
-    // Wait for X to complete
-    while (stepperX->isRunning()) {
-        if (checkForHomeCommand()) {
-            Serial.println("Home command received during final X move. Stopping.");
-            stepperX->forceStopAndNewPosition(stepperX->getCurrentPosition());
-            if (stepperY_Left->isRunning()) { // Also stop Y if it's running
-                 stepperY_Left->forceStopAndNewPosition(stepperY_Left->getCurrentPosition());
-            }
-            return; // Exit the function
-        }
-        delay(1);
-    }
-
-    // Wait for Y to complete
-    while (stepperY_Left->isRunning()) {
-        if (checkForHomeCommand()) {
-            Serial.println("Home command received during final Y move. Stopping.");
-            stepperY_Left->forceStopAndNewPosition(stepperY_Left->getCurrentPosition());
-            // X would have already stopped or completed
-            return; // Exit the function
-        }
-        delay(1);
+    stepperY_Left->setAcceleration(DEFAULT_Y_ACCEL);
+    stepperY_Right->setAcceleration(DEFAULT_Y_ACCEL);
+    // Both Y motors move together; HOME ramps the axes down through the abort channel
+    if (!moveToXYZ_HomeCheck(target_x_final_steps, DEFAULT_X_SPEED, target_y_final_steps, DEFAULT_Y_SPEED,
+                             stepperZ->getCurrentPosition(), DEFAULT_Z_SPEED)) {
+        Serial.println("Home command received during final move. Stopping.");
+        return;
     }
 
     Serial.println("Reached final resting position (X=3, Y=3).");
@@ -306,22 +422,10 @@ void paintAllSides() {
     //! Reset rotation motor to 0 degrees
     if (rotationStepper) {
         Serial.println("Resetting rotation motor to 0 degrees.");
-        rotateToAngle(0); // Assuming this function is available from Rotation_Motor.h
-        
-        // Wait for rotation to complete
-        unsigned long rotationStartTime = millis();
-        while (rotationStepper->isRunning()) {
-            if (checkForHomeCommand()) {
-                Serial.println("Home command received during final rotation motor reset. Stopping.");
-                rotationStepper->forceStopAndNewPosition(rotationStepper->getCurrentPosition());
-                return; // Exit the function
-            }
-            if (millis() - rotationStartTime > 15000) { // 15-second timeout for rotation
-                Serial.println("ERROR: Timeout resetting rotation motor!");
-                rotationStepper->forceStopAndNewPosition(rotationStepper->getCurrentPosition());
-                return; // Exit the function
-            }
-            delay(1);
+        rotateToAngle(0); // Waits for the move, ramps down on HOME
+        if (motionAbortPending()) {
+            Serial.println("Home command received during final rotation motor reset. Stopping.");
+            return;
         }
         Serial.println("Rotation motor reset to 0 degrees.");
     } else {
@@ -12,6 +12,8 @@
 #include "settings/pins.h"        // Keep this one
 #include "../../include/web/Web_Dashboard_Commands.h" // For checkForHomeCommand
 #include "../../include/system/StateMachine.h" // Include StateMachine header
+#include "../../include/system/PaintProgress.h" // For pass-level pause/resume
+#include "../../include/system/Fixtures.h"      // Offset of the fixture being painted
 
 // External references to stepper motors
 extern FastAccelStepper *stepperX;
@@ -38,48 +40,50 @@ bool paintSide1Pattern() {
         return false;
     }
 
-    //! Set Servo Angle FIRST
-    myServo.setAngle(servoAngle);
-    Serial.println("Servo set to: " + String(servoAngle) + " degrees for Side 1 side");
-
-    //! STEP 0: Turn on pressure pot
-    PressurePot_ON();
-    
-    // Check for home command after servo and pressure
-    if (checkForHomeCommand()) {
-        Serial.println("Side 1 Pattern Painting ABORTED due to home command (after prep)");
-        return false;
-    }
-
-    //! STEP 1: Move to side 1 painting Z height
-    // Use constants directly from settings/painting.h
     long zPos = (long)(paintingSettings.getSide1ZHeight() * STEPS_PER_INCH_XYZ); // Use getter
     long sideZPos = (long)(paintingSettings.getSide1SideZHeight() * STEPS_PER_INCH_XYZ); // Use getter
 
-    // Use constants from utils/settings.h for default speeds
-    moveToXYZ(stepperX->getCurrentPosition(), DEFAULT_X_SPEED,
-              stepperY_Left->getCurrentPosition(), DEFAULT_Y_SPEED,
-              sideZPos, DEFAULT_Z_SPEED);
-              
-    // Check for home command after Z move
-    if (checkForHomeCommand()) {
-        Serial.println("Side 1 Pattern Painting ABORTED due to home command (after initial Z)");
-        return false;
-    }
-
-    //! STEP 2: Rotate to the side 1 position
-    rotateToAngle(SIDE1_ROTATION_ANGLE); // Speed likely handled within rotateToAngle
-    Serial.println("Rotated to side 1 position");
-    
-    // Check for home command after rotation
-    if (checkForHomeCommand()) {
-        Serial.println("Side 1 Pattern Painting ABORTED due to home command (after rotation)");
-        return false;
+    // Later cells of a tray job reuse the setup of the side's first cell
+    if (patternCellMode() != PATTERN_CELL_NEXT) {
+        //! Set Servo Angle FIRST
+        myServo.setAngle(servoAngle);
+        Serial.println("Servo set to: " + String(servoAngle) + " degrees for Side 1 side");
+
+        //! STEP 0: Turn on pressure pot
+        PressurePot_ON();
+
+        // Check for home command after servo and pressure
+        if (checkForHomeCommand()) {
+            Serial.println("Side 1 Pattern Painting ABORTED due to home command (after prep)");
+            return false;
+        }
+
+        //! STEP 1: Move to side 1 safe Z height
+        // Use constants from utils/settings.h for default speeds
+        moveToXYZ(stepperX->getCurrentPosition(), DEFAULT_X_SPEED,
+                  stepperY_Left->getCurrentPosition(), DEFAULT_Y_SPEED,
+                  sideZPos, DEFAULT_Z_SPEED);
+
+        // Check for home command after Z move
+        if (checkForHomeCommand()) {
+            Serial.println("Side 1 Pattern Painting ABORTED due to home command (after initial Z)");
+            return false;
+        }
+
+        //! STEP 2: Rotate to the side 1 position
+        rotateToAngle(SIDE1_ROTATION_ANGLE); // Speed likely handled within rotateToAngle
+        Serial.println("Rotated to side 1 position");
+
+        // Check for home command after rotation
+        if (checkForHomeCommand()) {
+            Serial.println("Side 1 Pattern Painting ABORTED due to home command (after rotation)");
+            return false;
+        }
     }
 
     //! STEP 3: Move to start position (P2)
-    long startX = (long)(paintingSettings.getSide1StartX() * STEPS_PER_INCH_XYZ); // Use getter
-    long startY = (long)(paintingSettings.getSide1StartY() * STEPS_PER_INCH_XYZ); // Use getter
+    long startX = (long)(paintingSettings.getSide1StartX() * STEPS_PER_INCH_XYZ) + fixtureOffsetXSteps(); // Use getter
+    long startY = (long)(paintingSettings.getSide1StartY() * STEPS_PER_INCH_XYZ) + fixtureOffsetYSteps(); // Use getter
     moveToXYZ(startX, DEFAULT_X_SPEED, startY, DEFAULT_Y_SPEED, sideZPos, DEFAULT_Z_SPEED);
     Serial.println("Moved to side 1 pattern start position (P2)");
     
@@ -101,6 +105,8 @@ bool paintSide1Pattern() {
     }
 
     //! STEP 5: Execute simplified side 1 painting pattern (Single X Shift)
+    // Side 1 is a single pass, so a resumed job always restarts it from the beginning
+    paintJobTakeResumePass(1);
     long currentX = startX;
     long currentY = startY;
     long shiftXDistance = (long)(paintingSettings.getSide1ShiftX() * STEPS_PER_INCH_XYZ); // Use getter for shift distance
@@ -132,9 +138,17 @@ bool paintSide1Pattern() {
         return false;
     }
 
+    paintJobPassComplete(1, 0);
+
     //! STEP 6: Raise to safe Z height (Was STEP 8)
     moveToXYZ(finalX, DEFAULT_X_SPEED, currentY, DEFAULT_Y_SPEED, sideZPos, DEFAULT_Z_SPEED);
 
+    // A tray job goes on to the next cell from here
+    if (patternCellMode() != PATTERN_STANDALONE) {
+        Serial.println("Side 1 painting complete on this cell.");
+        return true;
+    }
+
     //! STEP 7: Move to position (3,3) before homing
     Serial.println("Moving to position (3,3,0) before homing...");
     long xHoming = (long)(3.0 * STEPS_PER_INCH_XYZ);
@@ -143,9 +157,13 @@ bool paintSide1Pattern() {
     moveToXYZ(xHoming, DEFAULT_X_SPEED, yHoming, DEFAULT_Y_SPEED, zHoming, DEFAULT_Z_SPEED);
     Serial.println("Reached position (3,3,0).");
 
-    //! Stage 5: Transition back to Homing State after completion
+    //! Stage 5: Transition back to Homing State after completion (an All Sides job homes once at its end)
+    if (isPaintJobActive()) {
+        Serial.println("Side 1 painting complete. Continuing paint job.");
+        return true;
+    }
     Serial.println("Side 1 painting complete. Transitioning to Homing State...");
-    stateMachine->changeState(stateMachine->getHomingState()); // Corrected state change call
+    stateMachine->requestTransition(STATE_HOMING); // Corrected state change call
 
     return true;
 }
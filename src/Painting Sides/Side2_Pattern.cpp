@@ -10,6 +10,8 @@
 #include "../../include/motors/ServoMotor.h"
 #include "../../include/web/Web_Dashboard_Commands.h"
 #include "../../include/system/StateMachine.h"
+#include "../../include/system/PaintProgress.h"
+#include "../../include/system/Fixtures.h"
 
 // External references to stepper motors
 extern FastAccelStepper *stepperX;
@@ -38,43 +40,64 @@ void paintSide2Pattern() {
     int servoAngle = paintingSettings.getServoAngleSide2(); // Use Side 2 settings
     long zPos = (long)(paintingSettings.getSide2ZHeight() * STEPS_PER_INCH_XYZ); // Use Side 2 settings
     long sideZPos = (long)(paintingSettings.getSide2SideZHeight() * STEPS_PER_INCH_XYZ); // Use Side 2 settings
-    long startX_steps = (long)(paintingSettings.getSide2StartX() * STEPS_PER_INCH_XYZ); // Use Side 2 settings
-    long startY_steps = (long)(paintingSettings.getSide2StartY() * STEPS_PER_INCH_XYZ); // Use Side 2 settings
+    long startX_steps = (long)(paintingSettings.getSide2StartX() * STEPS_PER_INCH_XYZ) + fixtureOffsetXSteps(); // Use Side 2 settings
+    long startY_steps = (long)(paintingSettings.getSide2StartY() * STEPS_PER_INCH_XYZ) + fixtureOffsetYSteps(); // Use Side 2 settings
     long sweepYDistance = (long)(paintingSettings.getSide2SweepY() * STEPS_PER_INCH_XYZ); // Use Side 2 settings
     long shiftXDistance = (long)(paintingSettings.getSide2ShiftX() * STEPS_PER_INCH_XYZ); // Use Side 2 settings - ensure this is positive
     long paint_x_speed = paintingSettings.getSide2PaintingXSpeed(); // Use Side 2 settings
     long paint_y_speed = paintingSettings.getSide2PaintingYSpeed(); // Use Side 2 settings
     long first_sweep_paint_y_speed_side2 = (long)(paint_y_speed * 0.75f);
 
-    //! Set Servo Angle FIRST
-    myServo.setAngle(servoAngle);
-    Serial.println("Servo set to: " + String(servoAngle) + " degrees for Side 2");
+    // Later cells of a tray job reuse the setup of the side's first cell
+    if (patternCellMode() != PATTERN_CELL_NEXT) {
+        //! Set Servo Angle FIRST
+        myServo.setAngle(servoAngle);
+        Serial.println("Servo set to: " + String(servoAngle) + " degrees for Side 2");
 
-    //! STEP 0: Turn on pressure pot
-    PressurePot_ON();
+        //! STEP 0: Turn on pressure pot
+        PressurePot_ON();
 
-    //! STEP 1: Move to Side 2 safe Z height at current X, Y
-    moveToXYZ(stepperX->getCurrentPosition(), DEFAULT_X_SPEED,
-              stepperY_Left->getCurrentPosition(), DEFAULT_Y_SPEED,
-              sideZPos, DEFAULT_Z_SPEED);
+        //! STEP 1: Move to Side 2 safe Z height at current X, Y
+        moveToXYZ(stepperX->getCurrentPosition(), DEFAULT_X_SPEED,
+                  stepperY_Left->getCurrentPosition(), DEFAULT_Y_SPEED,
+                  sideZPos, DEFAULT_Z_SPEED);
 
-    //! STEP 2: Rotate to the Side 2 position
-    rotateToAngle(SIDE2_ROTATION_ANGLE); // Use Side 2 angle
-    Serial.println("Rotated to Side 2 position");
+        //! STEP 2: Rotate to the Side 2 position
+        rotateToAngle(SIDE2_ROTATION_ANGLE); // Use Side 2 angle
+        Serial.println("Rotated to Side 2 position");
+    }
+
+    long currentX = startX_steps;
+    long currentY = startY_steps;
+    const int num_y_sweeps = 5; // 5 Y-sweeps results in 4 X-shifts
+
+    //! Resuming a paused job: advance the pattern position past already painted passes
+    int firstPass = paintJobTakeResumePass(2);
+    for (int i = 0; i < firstPass && i < num_y_sweeps; ++i) {
+        currentY += (i % 2 == 0) ? -sweepYDistance : sweepYDistance;
+        if (i < num_y_sweeps - 1) {
+            currentX -= shiftXDistance;
+        }
+    }
+    if (firstPass > 0) {
+        Serial.printf("Side 2 Pattern: Resuming at pass %d\n", firstPass + 1);
+    }
 
     //! STEP 3: Move to user-defined start X, Y for Side 2 at safe Z height
-    moveToXYZ(startX_steps, DEFAULT_X_SPEED, startY_steps, DEFAULT_Y_SPEED, sideZPos, DEFAULT_Z_SPEED);
+    moveToXYZ(currentX, DEFAULT_X_SPEED, currentY, DEFAULT_Y_SPEED, sideZPos, DEFAULT_Z_SPEED);
     Serial.println("Moved to Side 2 Start X, Y at safe Z.");
 
     //! STEP 4: Lower to painting Z height
-    moveToXYZ(startX_steps, DEFAULT_X_SPEED, startY_steps, DEFAULT_Y_SPEED, zPos, DEFAULT_Z_SPEED);
+    moveToXYZ(currentX, DEFAULT_X_SPEED, currentY, DEFAULT_Y_SPEED, zPos, DEFAULT_Z_SPEED);
     Serial.println("Lowered to painting Z for Side 2.");
 
-    long currentX = startX_steps;
-    long currentY = startY_steps;
-    const int num_y_sweeps = 5; // 5 Y-sweeps results in 4 X-shifts
+    for (int i = firstPass; i < num_y_sweeps; ++i) {
+        if (i > firstPass && paintJobStopRequested()) {
+            moveToXYZ(currentX, DEFAULT_X_SPEED, currentY, DEFAULT_Y_SPEED, sideZPos, DEFAULT_Z_SPEED);
+            Serial.printf("Side 2 Pattern Painting stopped before sweep %d (paused or aborted)\n", i + 1);
+            return;
+        }
 
-    for (int i = 0; i < num_y_sweeps; ++i) {
         bool isNegativeYSweep = (i % 2 == 0); // 0th, 2nd, 4th sweeps are -Y
         long current_paint_y_speed = paint_y_speed;
 
@@ -114,6 +137,15 @@ void paintSide2Pattern() {
                  return;
             }
         }
+
+        paintJobPassComplete(2, i);
+    }
+
+    //! End sequence counts as the last pass (index num_y_sweeps)
+    if (num_y_sweeps > firstPass && paintJobStopRequested()) {
+        moveToXYZ(currentX, DEFAULT_X_SPEED, currentY, DEFAULT_Y_SPEED, sideZPos, DEFAULT_Z_SPEED);
+        Serial.println("Side 2 Pattern Painting stopped before end sequence (paused or aborted)");
+        return;
     }
 
     //! NEW: Perform additional movements at the end of the pattern
@@ -155,10 +187,18 @@ void paintSide2Pattern() {
         return;
     }
     Serial.println("Side 2 Pattern: End sequence movements completed.");
+    paintJobPassComplete(2, num_y_sweeps);
 
     // Move Z to safe height
     moveToXYZ(currentX, DEFAULT_X_SPEED, currentY, DEFAULT_Y_SPEED, sideZPos, DEFAULT_Z_SPEED);
 
+    // A tray job goes on to the next cell from here
+    if (patternCellMode() != PATTERN_STANDALONE) {
+        myServo.setAngle(servoAngle); // Back from the final X pass angle for the next cell
+        Serial.println("Side 2 painting complete on this cell.");
+        return;
+    }
+
     //! Move to position (3,3) before homing
     Serial.println("Moving to position (3,3,0) before homing...");
     long xHoming = (long)(3.0 * STEPS_PER_INCH_XYZ);
@@ -167,7 +207,11 @@ void paintSide2Pattern() {
     moveToXYZ(xHoming, DEFAULT_X_SPEED, yHoming, DEFAULT_Y_SPEED, zHoming, DEFAULT_Z_SPEED);
     Serial.println("Reached position (3,3,0).");
 
-    //! Transition to Homing State
+    //! Transition to Homing State (an All Sides job homes once at its end)
+    if (isPaintJobActive()) {
+        Serial.println("Side 2 painting complete. Continuing paint job.");
+        return;
+    }
     Serial.println("Side 2 painting complete. Transitioning to Homing State...");
-    stateMachine->changeState(stateMachine->getHomingState()); // Corrected state change call
+    stateMachine->requestTransition(STATE_HOMING); // Corrected state change call
 }
\ No newline at end of file
@@ -10,6 +10,8 @@
 #include "../../include/motors/ServoMotor.h"         // For ServoMotor class
 #include "../../include/web/Web_Dashboard_Commands.h" // For checkForHomeCommand
 #include "../../include/system/StateMachine.h" // Include StateMachine header
+#include "../../include/system/PaintProgress.h" // For pass-level pause/resume
+#include "../../include/system/Fixtures.h"      // Offset of the fixture being painted
 
 // External references to stepper motors
 extern FastAccelStepper *stepperX;
@@ -47,36 +49,31 @@ void paintSide3Pattern() {
     Serial.println("Starting Side 3 Pattern Painting (Horizontal Sweeps)");
 
     int servoAngle = paintingSettings.getServoAngleSide3();
-
-    //! Set Servo Angle FIRST
-    myServo.setAngle(servoAngle);
-    Serial.println("Servo set to: " + String(servoAngle) + " degrees for Side 3 side");
-
-    //! STEP 0: Turn on pressure pot
-    PressurePot_ON();
-
-    //! STEP 1: Move to side 3 painting Z height
     long zPos = (long)(paintingSettings.getSide3ZHeight() * STEPS_PER_INCH_XYZ);
     long sideZPos = (long)(paintingSettings.getSide3SideZHeight() * STEPS_PER_INCH_XYZ);
 
-    moveToXYZ(stepperX->getCurrentPosition(), DEFAULT_X_SPEED,
-              stepperY_Left->getCurrentPosition(), DEFAULT_Y_SPEED,
-              sideZPos, DEFAULT_Z_SPEED);
+    // Later cells of a tray job reuse the setup of the side's first cell
+    if (patternCellMode() != PATTERN_CELL_NEXT) {
+        //! Set Servo Angle FIRST
+        myServo.setAngle(servoAngle);
+        Serial.println("Servo set to: " + String(servoAngle) + " degrees for Side 3 side");
 
-    //! STEP 2: Rotate to the side 3 position
-    rotateToAngle(SIDE3_ROTATION_ANGLE);
-    Serial.println("Rotated to side 3 position");
+        //! STEP 0: Turn on pressure pot
+        PressurePot_ON();
 
-    //! STEP 3: Move to start position (Top Right - P1 assumed)
-    long startX_steps = (long)(paintingSettings.getSide3StartX() * STEPS_PER_INCH_XYZ);
-    long startY_steps = (long)(paintingSettings.getSide3StartY() * STEPS_PER_INCH_XYZ);
-    moveToXYZ(startX_steps, DEFAULT_X_SPEED, startY_steps, DEFAULT_Y_SPEED, sideZPos, DEFAULT_Z_SPEED);
-    Serial.println("Moved to side 3 pattern start position (Top Right)");
+        //! STEP 1: Move to side 3 safe Z height
+        moveToXYZ(stepperX->getCurrentPosition(), DEFAULT_X_SPEED,
+                  stepperY_Left->getCurrentPosition(), DEFAULT_Y_SPEED,
+                  sideZPos, DEFAULT_Z_SPEED);
 
-    //! STEP 4: Lower to painting Z height
-    moveToXYZ(startX_steps, DEFAULT_X_SPEED, startY_steps, DEFAULT_Y_SPEED, zPos, DEFAULT_Z_SPEED);
+        //! STEP 2: Rotate to the side 3 position
+        rotateToAngle(SIDE3_ROTATION_ANGLE);
+        Serial.println("Rotated to side 3 position");
+    }
 
-    //! STEP 5: Execute side 3 horizontal painting pattern
+    //! STEP 3: Move to start position (Top Right - P1 assumed)
+    long startX_steps = (long)(paintingSettings.getSide3StartX() * STEPS_PER_INCH_XYZ) + fixtureOffsetXSteps();
+    long startY_steps = (long)(paintingSettings.getSide3StartY() * STEPS_PER_INCH_XYZ) + fixtureOffsetYSteps();
     long currentX = startX_steps;
     long currentY = startY_steps;
     long sweepX_steps = (long)(paintingSettings.getSide3ShiftX() * STEPS_PER_INCH_XYZ); 
@@ -85,96 +82,73 @@ void paintSide3Pattern() {
     long paint_x_speed = paintingSettings.getSide3PaintingXSpeed();
     long paint_y_speed = paintingSettings.getSide3PaintingYSpeed();
     long final_sweep_paint_x_speed_side3 = (long)(paint_x_speed * 0.5f);
-
-    // First sweep: X- direction
-    Serial.println("Side 3 Pattern: First sweep X-");
-    paintGun_ON();
-    currentX -= sweepX_steps;
-    moveToXYZ(currentX, paint_x_speed, currentY, paint_y_speed, zPos, DEFAULT_Z_SPEED);
-    paintGun_OFF();
-
-    if (checkForHomeCommand()) {
-        moveToXYZ(currentX, DEFAULT_X_SPEED, currentY, DEFAULT_Y_SPEED, sideZPos, DEFAULT_Z_SPEED);
-        Serial.println("Side 3 Pattern Painting ABORTED due to home command");
-        return;
+    const int num_x_sweeps = 5; // X- / X+ alternating, Y- shift between sweeps
+
+    //! Resuming a paused job: advance the pattern position past already painted passes
+    int firstPass = paintJobTakeResumePass(3);
+    for (int i = 0; i < firstPass && i < num_x_sweeps; ++i) {
+        currentX += (i % 2 == 0) ? -sweepX_steps : sweepX_steps;
+        if (i < num_x_sweeps - 1) {
+            currentY -= shiftY_steps;
+        }
     }
-
-    // First shift: Y- direction
-    Serial.println("Side 3 Pattern: Shift Y-");
-    currentY -= shiftY_steps;
-    moveToXYZ(currentX, DEFAULT_X_SPEED, currentY, DEFAULT_Y_SPEED, zPos, DEFAULT_Z_SPEED);
-
-    // Second sweep: X+ direction
-    Serial.println("Side 3 Pattern: Second sweep X+");
-    paintGun_ON();
-    currentX += sweepX_steps;
-    moveToXYZ(currentX, paint_x_speed, currentY, paint_y_speed, zPos, DEFAULT_Z_SPEED);
-    paintGun_OFF();
-
-    if (checkForHomeCommand()) {
-        moveToXYZ(currentX, DEFAULT_X_SPEED, currentY, DEFAULT_Y_SPEED, sideZPos, DEFAULT_Z_SPEED);
-        Serial.println("Side 3 Pattern Painting ABORTED due to home command");
-        return;
+    if (firstPass > 0) {
+        Serial.printf("Side 3 Pattern: Resuming at pass %d\n", firstPass + 1);
     }
 
-    // Second shift: Y- direction
-    Serial.println("Side 3 Pattern: Shift Y-");
-    currentY -= shiftY_steps;
-    moveToXYZ(currentX, DEFAULT_X_SPEED, currentY, DEFAULT_Y_SPEED, zPos, DEFAULT_Z_SPEED);
-
-    // Third sweep: X- direction
-    Serial.println("Side 3 Pattern: Third sweep X-");
-    paintGun_ON();
-    currentX -= sweepX_steps;
-    moveToXYZ(currentX, paint_x_speed, currentY, paint_y_speed, zPos, DEFAULT_Z_SPEED);
-    paintGun_OFF();
-
-    if (checkForHomeCommand()) {
-        moveToXYZ(currentX, DEFAULT_X_SPEED, currentY, DEFAULT_Y_SPEED, sideZPos, DEFAULT_Z_SPEED);
-        Serial.println("Side 3 Pattern Painting ABORTED due to home command");
-        return;
-    }
+    moveToXYZ(currentX, DEFAULT_X_SPEED, currentY, DEFAULT_Y_SPEED, sideZPos, DEFAULT_Z_SPEED);
+    Serial.println("Moved to side 3 pattern start position (Top Right)");
 
-    // Third shift: Y- direction
-    Serial.println("Side 3 Pattern: Shift Y-");
-    currentY -= shiftY_steps;
+    //! STEP 4: Lower to painting Z height
     moveToXYZ(currentX, DEFAULT_X_SPEED, currentY, DEFAULT_Y_SPEED, zPos, DEFAULT_Z_SPEED);
 
-    // Fourth sweep: X+ direction
-    Serial.println("Side 3 Pattern: Fourth sweep X+");
-    paintGun_ON();
-    currentX += sweepX_steps;
-    moveToXYZ(currentX, paint_x_speed, currentY, paint_y_speed, zPos, DEFAULT_Z_SPEED);
-    paintGun_OFF();
-
-    if (checkForHomeCommand()) {
-        moveToXYZ(currentX, DEFAULT_X_SPEED, currentY, DEFAULT_Y_SPEED, sideZPos, DEFAULT_Z_SPEED);
-        Serial.println("Side 3 Pattern Painting ABORTED due to home command");
-        return;
+    //! STEP 5: Execute side 3 horizontal painting pattern
+    for (int i = firstPass; i < num_x_sweeps; ++i) {
+        if (i > firstPass && paintJobStopRequested()) {
+            moveToXYZ(currentX, DEFAULT_X_SPEED, currentY, DEFAULT_Y_SPEED, sideZPos, DEFAULT_Z_SPEED);
+            Serial.printf("Side 3 Pattern Painting stopped before sweep %d (paused or aborted)\n", i + 1);
+            return;
+        }
+
+        bool isNegativeXSweep = (i % 2 == 0); // 1st, 3rd, 5th sweeps are X-
+        long current_paint_x_speed = paint_x_speed;
+
+        if (i == num_x_sweeps - 1) { // Final X painting movement
+            current_paint_x_speed = final_sweep_paint_x_speed_side3;
+            Serial.printf("Side 3 Pattern: Applying 50%% speed for final X sweep: %ld\n", current_paint_x_speed);
+        }
+
+        Serial.printf("Side 3 Pattern: Sweep %d (%s)\n", i + 1, isNegativeXSweep ? "X-" : "X+");
+        paintGun_ON();
+        currentX += isNegativeXSweep ? -sweepX_steps : sweepX_steps;
+        moveToXYZ(currentX, current_paint_x_speed, currentY, paint_y_speed, zPos, DEFAULT_Z_SPEED);
+        paintGun_OFF();
+
+        if (checkForHomeCommand()) {
+            moveToXYZ(currentX, DEFAULT_X_SPEED, currentY, DEFAULT_Y_SPEED, sideZPos, DEFAULT_Z_SPEED);
+            Serial.println("Side 3 Pattern Painting ABORTED due to home command");
+            return;
+        }
+
+        // Shift Y- between sweeps
+        if (i < num_x_sweeps - 1) {
+            Serial.println("Side 3 Pattern: Shift Y-");
+            currentY -= shiftY_steps;
+            moveToXYZ(currentX, DEFAULT_X_SPEED, currentY, DEFAULT_Y_SPEED, zPos, DEFAULT_Z_SPEED);
+        }
+
+        paintJobPassComplete(3, i);
     }
 
-    // Fourth shift: Y- direction
-    Serial.println("Side 3 Pattern: Shift Y-"); // Should this be after a home check? Assuming not based on pattern.
-    currentY -= shiftY_steps;
-    moveToXYZ(currentX, DEFAULT_X_SPEED, currentY, DEFAULT_Y_SPEED, zPos, DEFAULT_Z_SPEED);
+    //! STEP 8: Raise to safe Z height
+    moveToXYZ(currentX, DEFAULT_X_SPEED, currentY, DEFAULT_Y_SPEED, sideZPos, DEFAULT_Z_SPEED);
 
-    // Fifth sweep: X- direction (Final X painting movement)
-    Serial.println("Side 3 Pattern: Fifth sweep X-");
-    Serial.printf("Side 3 Pattern: Applying 75%% speed for final X sweep: %ld\n", final_sweep_paint_x_speed_side3);
-    paintGun_ON();
-    currentX -= sweepX_steps;
-    moveToXYZ(currentX, final_sweep_paint_x_speed_side3, currentY, paint_y_speed, zPos, DEFAULT_Z_SPEED);
-    paintGun_OFF();
-
-    if (checkForHomeCommand()) {
-        moveToXYZ(currentX, DEFAULT_X_SPEED, currentY, DEFAULT_Y_SPEED, sideZPos, DEFAULT_Z_SPEED);
-        Serial.println("Side 3 Pattern Painting ABORTED due to home command");
+    // A tray job goes on to the next cell from here
+    if (patternCellMode() != PATTERN_STANDALONE) {
+        Serial.println("Side 3 painting complete on this cell.");
         return;
     }
 
-    //! STEP 8: Raise to safe Z height
-    moveToXYZ(currentX, DEFAULT_X_SPEED, currentY, DEFAULT_Y_SPEED, sideZPos, DEFAULT_Z_SPEED);
-
     //! Move to position (3,3) before homing
     Serial.println("Moving to position (3,3,0) before homing...");
     long xHoming = (long)(3.0 * STEPS_PER_INCH_XYZ);
@@ -183,8 +157,12 @@ void paintSide3Pattern() {
     moveToXYZ(xHoming, DEFAULT_X_SPEED, yHoming, DEFAULT_Y_SPEED, zHoming, DEFAULT_Z_SPEED);
     Serial.println("Reached position (3,3,0).");
 
-    //! Transition to Homing State
+    //! Transition to Homing State (an All Sides job homes once at its end)
+    if (isPaintJobActive()) {
+        Serial.println("Side 3 painting complete. Continuing paint job.");
+        return;
+    }
     Serial.println("Side 3 painting complete. Transitioning to Homing State...");
-    stateMachine->changeState(stateMachine->getHomingState()); // Corrected state change call
+    stateMachine->requestTransition(STATE_HOMING); // Corrected state change call
     // No return needed as function is void
 } 
\ No newline at end of file
@@ -0,0 +1,100 @@
+#include "hardware/CycleSensor.h"
+#include "settings/pins.h" // For PNP_CYCLE_SENSOR_PIN
+#include "settings/debounce_settings.h" // For PNP_CYCLE_SENSOR_DEBOUNCE_MS
+#include "system/EventLoop.h" // Edges wake the loop task
+
+//* ************************************************************************
+//* ************************* PNP CYCLE SENSOR *****************************
+//* ************************************************************************
+
+// The ISR reads the input register directly (digitalRead is not IRAM safe)
+static_assert(PNP_CYCLE_SENSOR_PIN < 32, "Cycle sensor ISR reads GPIO_IN_REG (pins 0-31)");
+
+static const unsigned long DEBOUNCE_US = PNP_CYCLE_SENSOR_DEBOUNCE_MS * 1000UL;
+
+static portMUX_TYPE sensorMux = portMUX_INITIALIZER_UNLOCKED;
+static volatile int stableLevel = HIGH;            // Debounced level
+static volatile unsigned long lastAcceptedUs = 0;  // Time of the last accepted edge
+static volatile unsigned long lastArrivalUs = 0;   // Time of the last falling edge
+static volatile uint32_t arrivalCount = 0;
+static uint32_t consumedArrivals = 0;
+
+// Applies a raw level observed at 'nowUs'. Caller holds sensorMux.
+static bool IRAM_ATTR acceptLevel(int level, unsigned long nowUs) {
+    if (level == stableLevel || (nowUs - lastAcceptedUs) < DEBOUNCE_US) {
+        return false;
+    }
+    stableLevel = level;
+    lastAcceptedUs = nowUs;
+    if (level == LOW) {
+        lastArrivalUs = nowUs;
+        arrivalCount++;
+    }
+    return true;
+}
+
+static void IRAM_ATTR onCycleSensorEdge() {
+    unsigned long nowUs = micros();
+    int level = (REG_READ(GPIO_IN_REG) >> PNP_CYCLE_SENSOR_PIN) & 1;
+
+    portENTER_CRITICAL_ISR(&sensorMux);
+    bool accepted = acceptLevel(level, nowUs);
+    portEXIT_CRITICAL_ISR(&sensorMux);
+
+    if (accepted) {
+        eventLoopNotifyFromISR();
+    }
+}
+
+void initializeCycleSensor() {
+    // Active LOW IR sensor: pull-up keeps the pin HIGH when idle
+    pinMode(PNP_CYCLE_SENSOR_PIN, INPUT_PULLUP);
+    stableLevel = digitalRead(PNP_CYCLE_SENSOR_PIN);
+    lastAcceptedUs = micros();
+    attachInterrupt(digitalPinToInterrupt(PNP_CYCLE_SENSOR_PIN), onCycleSensorEdge, CHANGE);
+    Serial.printf("Cycle sensor interrupt attached (pin %d, %s).\n", PNP_CYCLE_SENSOR_PIN,
+                  stableLevel == LOW ? "active" : "idle");
+}
+
+bool cycleSensorActive() {
+    // Catch a level left changed by a bounce inside the lockout window
+    int level = digitalRead(PNP_CYCLE_SENSOR_PIN);
+    portENTER_CRITICAL(&sensorMux);
+    unsigned long nowUs = micros();
+    acceptLevel(level, nowUs);
+    bool active = (stableLevel == LOW);
+    bool settling = (level != stableLevel);
+    unsigned long lockoutLeftUs = DEBOUNCE_US - (nowUs - lastAcceptedUs);
+    portEXIT_CRITICAL(&sensorMux);
+    if (settling) {
+        // Come back once the lockout has passed to accept the new level
+        eventLoopWakeAt(millis() + lockoutLeftUs / 1000 + 1);
+    }
+    return active;
+}
+
+bool cycleSensorConsumeArrival() {
+    cycleSensorActive(); // Resync first
+    portENTER_CRITICAL(&sensorMux);
+    bool arrived = (arrivalCount != consumedArrivals);
+    consumedArrivals = arrivalCount;
+    portEXIT_CRITICAL(&sensorMux);
+    return arrived;
+}
+
+unsigned long cycleSensorLastArrivalUs() {
+    portENTER_CRITICAL(&sensorMux);
+    unsigned long arrivalUs = lastArrivalUs;
+    portEXIT_CRITICAL(&sensorMux);
+    return arrivalUs;
+}
+
+uint32_t cycleSensorArrivalCount(unsigned long* lastArrivalUsOut) {
+    portENTER_CRITICAL(&sensorMux);
+    uint32_t count = arrivalCount;
+    if (lastArrivalUsOut) {
+        *lastArrivalUsOut = lastArrivalUs;
+    }
+    portEXIT_CRITICAL(&sensorMux);
+    return count;
+}
@@ -0,0 +1,168 @@
+#include "hardware/InputSampler.h"
+#include <esp_timer.h>
+#include "settings/pins.h" // For the home switch pins
+#include "settings/debounce_settings.h" // For INPUT_SAMPLE_PERIOD_US, HOMING_SWITCH_DEBOUNCE_MS
+#include "system/EventLoop.h" // Changes wake the loop task
+
+//* ************************************************************************
+//* ************************** INPUT SAMPLER *******************************
+//* ************************************************************************
+
+static const uint8_t HOME_SWITCH_SAMPLES = HOMING_SWITCH_DEBOUNCE_MS * 1000UL / INPUT_SAMPLE_PERIOD_US;
+static_assert(HOMING_SWITCH_DEBOUNCE_MS * 1000UL / INPUT_SAMPLE_PERIOD_US >= 1 &&
+              HOMING_SWITCH_DEBOUNCE_MS * 1000UL / INPUT_SAMPLE_PERIOD_US <= 255,
+              "Home switch integrator must be 1-255 samples");
+
+struct InputChannel {
+    uint8_t pin;
+    bool activeHigh;
+    uint8_t samples;      // Integrator length
+};
+
+// Indexed by InputId. Home switches read HIGH when triggered (pull-down).
+static const InputChannel CHANNELS[INPUT_COUNT] = {
+    {X_HOME_SWITCH, true, HOME_SWITCH_SAMPLES},
+    {Y_LEFT_HOME_SWITCH, true, HOME_SWITCH_SAMPLES},
+    {Y_RIGHT_HOME_SWITCH, true, HOME_SWITCH_SAMPLES},
+    {Z_HOME_SWITCH, true, HOME_SWITCH_SAMPLES}
+};
+
+struct InputState {
+    uint8_t integrator;           // 0 = inactive rail, samples = active rail
+    bool active;                  // Debounced state
+    unsigned long changeStartUs;  // First sample off the current rail
+    unsigned long lastEdgeUs;
+    uint32_t edgeCount;
+};
+
+struct EdgeLatch {
+    volatile bool armed;
+    volatile bool latched;
+    volatile unsigned long edgeUs;
+};
+
+static portMUX_TYPE inputMux = portMUX_INITIALIZER_UNLOCKED;
+static InputState inputs[INPUT_COUNT];
+static EdgeLatch latches[INPUT_COUNT];
+static esp_timer_handle_t sampleTimer = nullptr;
+
+static bool rawActive(const InputChannel& channel, uint32_t in0, uint32_t in1) {
+    bool high = channel.pin < 32 ? (in0 >> channel.pin) & 1 : (in1 >> (channel.pin - 32)) & 1;
+    return high == channel.activeHigh;
+}
+
+// esp_timer task: one register snapshot, then every integrator advances
+static void sampleInputs(void*) {
+    uint32_t in0 = REG_READ(GPIO_IN_REG);
+    uint32_t in1 = REG_READ(GPIO_IN1_REG);
+    unsigned long nowUs = micros();
+    bool changed = false;
+
+    portENTER_CRITICAL(&inputMux);
+    for (int i = 0; i < INPUT_COUNT; i++) {
+        const InputChannel& channel = CHANNELS[i];
+        InputState& s = inputs[i];
+        if (rawActive(channel, in0, in1)) {
+            if (s.integrator < channel.samples) {
+                if (s.integrator == 0) s.changeStartUs = nowUs;
+                s.integrator++;
+            }
+        } else if (s.integrator > 0) {
+            if (s.integrator == channel.samples) s.changeStartUs = nowUs;
+            s.integrator--;
+        }
+
+        bool active = s.active;
+        if (s.integrator == channel.samples) active = true;
+        else if (s.integrator == 0) active = false;
+        if (active != s.active) {
+            s.active = active;
+            s.lastEdgeUs = s.changeStartUs;
+            s.edgeCount++;
+            changed = true;
+        }
+    }
+    portEXIT_CRITICAL(&inputMux);
+
+    if (changed) {
+        eventLoopNotify();
+    }
+}
+
+void initializeInputSampler() {
+    uint32_t in0 = REG_READ(GPIO_IN_REG);
+    uint32_t in1 = REG_READ(GPIO_IN1_REG);
+    for (int i = 0; i < INPUT_COUNT; i++) {
+        bool active = rawActive(CHANNELS[i], in0, in1);
+        inputs[i].active = active;
+        inputs[i].integrator = active ? CHANNELS[i].samples : 0;
+    }
+
+    esp_timer_create_args_t args = {};
+    args.callback = sampleInputs;
+    args.dispatch_method = ESP_TIMER_TASK;
+    args.name = "inputs";
+    args.skip_unhandled_events = true; // Never run catch-up samples in a burst
+    if (esp_timer_create(&args, &sampleTimer) != ESP_OK ||
+        esp_timer_start_periodic(sampleTimer, INPUT_SAMPLE_PERIOD_US) != ESP_OK) {
+        Serial.println("ERROR: Failed to start the input sampler timer!");
+        return;
+    }
+    Serial.printf("Input sampler started (%d inputs every %lu us).\n", INPUT_COUNT, INPUT_SAMPLE_PERIOD_US);
+}
+
+bool inputActive(InputId id) {
+    portENTER_CRITICAL(&inputMux);
+    bool active = inputs[id].active;
+    portEXIT_CRITICAL(&inputMux);
+    return active;
+}
+
+unsigned long inputLastEdgeUs(InputId id) {
+    portENTER_CRITICAL(&inputMux);
+    unsigned long edgeUs = inputs[id].lastEdgeUs;
+    portEXIT_CRITICAL(&inputMux);
+    return edgeUs;
+}
+
+uint32_t inputEdgeCount(InputId id) {
+    portENTER_CRITICAL(&inputMux);
+    uint32_t count = inputs[id].edgeCount;
+    portEXIT_CRITICAL(&inputMux);
+    return count;
+}
+
+static void IRAM_ATTR onLatchEdge(void* arg) {
+    EdgeLatch* latch = (EdgeLatch*)arg;
+    if (!latch->armed || latch->latched) {
+        return;
+    }
+    latch->edgeUs = micros();
+    latch->latched = true;
+    eventLoopNotifyFromISR();
+}
+
+void inputArmEdgeLatch(InputId id) {
+    const InputChannel& channel = CHANNELS[id];
+    inputDisarmEdgeLatch(id);
+    latches[id].latched = false;
+    latches[id].armed = true;
+    attachInterruptArg(digitalPinToInterrupt(channel.pin), onLatchEdge, &latches[id],
+                       channel.activeHigh ? RISING : FALLING);
+}
+
+void inputDisarmEdgeLatch(InputId id) {
+    if (!latches[id].armed) {
+        return;
+    }
+    detachInterrupt(digitalPinToInterrupt(CHANNELS[id].pin));
+    latches[id].armed = false;
+}
+
+bool inputEdgeLatched(InputId id, unsigned long& edgeUs) {
+    portENTER_CRITICAL(&inputMux); // The ISR runs on this core: no edge in between
+    bool latched = latches[id].latched;
+    edgeUs = latches[id].edgeUs;
+    portEXIT_CRITICAL(&inputMux);
+    return latched;
+}
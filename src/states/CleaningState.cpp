@@ -41,6 +41,50 @@ const unsigned long SHORT_PRESSURE_POT_INIT_DELAY = 100;
 const unsigned long NORMAL_PAINT_GUN_ON_DELAY = 150;
 const unsigned long SHORT_PAINT_GUN_ON_DELAY = 75; // Half of normal
 
+// Gun clean cycle shared with the inter-coat dry window. With abortOnHome the
+// moves poll the HOME command and the cycle returns false as soon as it arrives.
+bool runCleaningCycle(bool shortMode, bool abortOnHome) {
+    unsigned long pressurePotInitDelay = shortMode ? SHORT_PRESSURE_POT_INIT_DELAY : NORMAL_PRESSURE_POT_INIT_DELAY;
+    unsigned long paintGunOnDelay = shortMode ? SHORT_PAINT_GUN_ON_DELAY : NORMAL_PAINT_GUN_ON_DELAY;
+
+    //! Step 1: Turn on pressure pot and initialize
+    PressurePot_ON();
+    delay(pressurePotInitDelay); 
+
+    //! Step 3: Move to clean station
+    long cleaningX = 0.8 * STEPS_PER_INCH_XYZ;
+    long cleaningY = 4.1* STEPS_PER_INCH_XYZ;
+    long cleaningZ = -3.0 * STEPS_PER_INCH_XYZ;
+    if (abortOnHome) {
+        if (!moveToXYZ_HomeCheck(cleaningX, CLEANING_X_SPEED, cleaningY, CLEANING_Y_SPEED, cleaningZ, CLEANING_Z_SPEED)) return false;
+    } else {
+        moveToXYZ(cleaningX, CLEANING_X_SPEED, cleaningY, CLEANING_Y_SPEED, cleaningZ, CLEANING_Z_SPEED);
+    }
+    
+    //! Step 4: Activate paint gun for specified duration
+    Serial.println("Activating paint gun...");
+    paintGun_ON();
+    delay(paintGunOnDelay);
+    paintGun_OFF();
+    
+    //! Step 5: Return to home position
+    Serial.println("Returning to home position...");
+    if (abortOnHome) {
+        // Retract the paint gun, then move back to home position
+        if (!moveToXYZ_HomeCheck(cleaningX, CLEANING_X_SPEED, cleaningY, CLEANING_Y_SPEED, 0, CLEANING_Z_SPEED)) return false;
+        if (!moveToXYZ_HomeCheck(0, CLEANING_X_SPEED, 0, CLEANING_Y_SPEED, 0, CLEANING_Z_SPEED)) return false;
+    } else {
+        // Retract the paint gun
+        moveToXYZ(cleaningX, CLEANING_X_SPEED, cleaningY, CLEANING_Y_SPEED, 0, CLEANING_Z_SPEED);
+        // Move back to home position
+        moveToXYZ(0, CLEANING_X_SPEED, 0, CLEANING_Y_SPEED, 0, CLEANING_Z_SPEED);
+    }
+    
+    //! Step 6: Complete cleaning cycle
+    Serial.println("Cleaning Cycle Complete.");
+    return true;
+}
+
 CleaningState::CleaningState() : 
     _isCleaning(false),
     _cleaningComplete(false),
@@ -68,7 +112,7 @@ void CleaningState::enter() {
     // This is called here assuming 'paintAllSides' will always start with Side 4 after cleaning.
     // If cleaning is used for other purposes, this might need more sophisticated logic
     // to determine which angle to rotate to, or if rotation is needed at all.
-    if (stateMachine && stateMachine->isTransitioningToPaintAllSides()) { // Hypothetical check
+    if (stateMachine && stateMachine->getEntryTransition().paintAllSides) {
         Serial.println("CleaningState: Initiating rotation to Side 4 angle during cleaning prep.");
         rotateToAngle(SIDE4_ROTATION_ANGLE); // Rotate for the first side of 'paintAllSides'
     } else {
@@ -87,35 +131,8 @@ void CleaningState::update() {
     if (_isCleaning && !_cleaningComplete) {
         Serial.println("Executing Cleaning Cycle...");
         
-        unsigned long pressurePotInitDelay = shortMode ? SHORT_PRESSURE_POT_INIT_DELAY : NORMAL_PRESSURE_POT_INIT_DELAY;
-        unsigned long paintGunOnDelay = shortMode ? SHORT_PAINT_GUN_ON_DELAY : NORMAL_PAINT_GUN_ON_DELAY;
-
-        //! Step 1: Turn on pressure pot and initialize
-        PressurePot_ON();
-        delay(pressurePotInitDelay); 
+        runCleaningCycle(shortMode, false);
 
-        //! Step 3: Move to clean station
-        long cleaningX = 0.8 * STEPS_PER_INCH_XYZ;
-        long cleaningY = 4.1* STEPS_PER_INCH_XYZ;
-        long cleaningZ = -3.0 * STEPS_PER_INCH_XYZ;
-        moveToXYZ(cleaningX, CLEANING_X_SPEED, cleaningY, CLEANING_Y_SPEED, cleaningZ, CLEANING_Z_SPEED);
-        
-        //! Step 4: Activate paint gun for specified duration
-        Serial.println("Activating paint gun...");
-        paintGun_ON();
-        delay(paintGunOnDelay);
-        paintGun_OFF();
-        
-        //! Step 5: Return to home position
-        Serial.println("Returning to home position...");
-        // Retract the paint gun
-        moveToXYZ(cleaningX, CLEANING_X_SPEED, cleaningY, CLEANING_Y_SPEED, 0, CLEANING_Z_SPEED);
-        // Move back to home position
-        moveToXYZ(0, CLEANING_X_SPEED, 0, CLEANING_Y_SPEED, 0, CLEANING_Z_SPEED);
-        
-        //! Step 6: Complete cleaning cycle
-        Serial.println("Cleaning Cycle Complete.");
-        
         // Mark cleaning as complete
         _cleaningComplete = true;
         _isCleaning = false;
@@ -123,20 +140,21 @@ void CleaningState::update() {
     
     // If cleaning is marked as complete, transition
     if (_cleaningComplete) {
-        State* overrideState = nullptr;
+        // The transition into Cleaning says where to continue
+        StateTransition entry = {STATE_NONE, STATE_CLEANING, STATE_NONE, false};
         if (stateMachine) { // Check stateMachine first
-            overrideState = stateMachine->getNextStateOverrideAndClear();
+            entry = stateMachine->getEntryTransition();
         }
 
-        if (overrideState) {
-            Serial.println("CleaningState: Short clean complete. Transitioning to override state.");
+        if (entry.then != STATE_NONE) {
+            Serial.println("CleaningState: Short clean complete. Transitioning to follow-up state.");
             // shortMode = false; // Reset mode before leaving - already in exit()
-            if(stateMachine) stateMachine->changeState(overrideState);
+            if(stateMachine) stateMachine->requestTransition(entry.then, STATE_NONE, entry.paintAllSides);
         } else {
             Serial.println("CleaningState: Normal clean complete. Transitioning to Idle State.");
             // shortMode = false; // Reset mode before leaving - already in exit()
             if (stateMachine) {
-                 stateMachine->changeState(stateMachine->getIdleState());
+                 stateMachine->requestTransition(STATE_IDLE);
             } else {
                 Serial.println("ERROR: StateMachine pointer null. Cannot transition to Idle.");
             }
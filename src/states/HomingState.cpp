@@ -7,9 +7,10 @@
 #include "system/StateMachine.h" 
 // #include "motors/XYZ_Movements.h" // XYZ_Movements likely included via Homing.h if needed
 #include "motors/Homing.h" // Include the new Homing class header
+#include "system/RetainedPositions.h" // For tracking referenced axes
+#include "system/MotionAbort.h"
+#include "system/Supervisor.h"
 
-// Add extern declaration for homeCommandReceived
-extern volatile bool homeCommandReceived;
 
 // // Declare global variables used by the homing state
 // const unsigned long HOMING_SWITCH_DEBOUNCE_MS = 3; // Moved to Homing class
@@ -69,8 +70,11 @@ HomingState::~HomingState() {
 void HomingState::enter() {
     Serial.println("Entering Homing State");
     
-    // Reset the home command flag since we're now processing it
-    homeCommandReceived = false;
+    // Reset the abort request since we're now processing it
+    motionAbortClear();
+
+    // Positions are meaningless until homing succeeds
+    setAxesReferenced(false);
     
     // Prepare for homing
     delete _homingController; // Delete previous instance if any
@@ -88,7 +92,10 @@ void HomingState::update() {
     if (_isHoming && !_homingComplete) {
         if (_homingController) {
             Serial.println("Executing Homing::homeAllAxes()...");
+            supervisorSegmentBegin("homeAllAxes", HOMING_SUPERVISOR_BUDGET_MS);
             _homingSuccess = _homingController->homeAllAxes(); // BLOCKING CALL
+            supervisorSegmentEnd();
+            setAxesReferenced(_homingSuccess);
             _homingComplete = true; // Mark as complete
             _isHoming = false;      // No longer actively homing
             Serial.println("Homing::homeAllAxes() finished.");
@@ -110,7 +117,7 @@ void HomingState::update() {
         }
         
         if (stateMachine) {
-            stateMachine->changeState(stateMachine->getIdleState()); 
+            stateMachine->requestTransition(STATE_IDLE); 
             // Reset flag for next entry after transition
             _homingComplete = false; 
         } else {
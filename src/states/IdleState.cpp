@@ -1,11 +1,15 @@
 #include "states/IdleState.h"
 #include <Arduino.h>
-// #include <Bounce2.h> // No longer needed here, included via GlobalDebouncers.h
+// #include <Bounce2.h> // No longer needed here
 #include "utils/settings.h" // Include for PNP_CYCLE_SENSOR_PIN
 #include "system/StateMachine.h" // Include for state machine access
 #include "states/PnPState.h" // Include the new PnPState
 #include "motors/ServoMotor.h" // Include for servo control
-// GlobalDebouncers.h is already included via IdleState.h
+#include "system/PaintProgress.h" // For clearing aborted paint jobs
+#include "storage/ProgressJournal.h" // For offering interrupted job resume
+#include "web/Web_Dashboard_Commands.h" // For sendResumeAvailable
+#include "system/RetainedPositions.h" // Held during firmware updates
+// CycleSensor.h is already included via IdleState.h
 
 // Reference to the global state machine instance
 extern StateMachine* stateMachine;
@@ -40,7 +44,7 @@ void IdleState::enter() {
     // pinMode(PNP_CYCLE_SENSOR_PIN, INPUT_PULLUP);
 
     // Setup debouncer for PNP Cycle Sensor
-    // pnpCycleSwitch.attach(PNP_CYCLE_SENSOR_PIN); // REMOVED: Using global g_pnpCycleSensorDebouncer
+    // pnpCycleSwitch.attach(PNP_CYCLE_SENSOR_PIN); // REMOVED: Sensor is interrupt driven (CycleSensor.h)
     // pnpCycleSwitch.interval(20); // REMOVED
     Serial.println("PNP Cycle Sensor debouncer is global and initialized in Setup.");
 
@@ -48,6 +52,17 @@ void IdleState::enter() {
     myServo.setAngle(180);
     Serial.println("Servo set to 180 degrees in Idle State.");
 
+    // A paint job aborted by HOME is fully unwound by now
+    paintJobEnd();
+
+    // Offer to continue a job interrupted by a reset (after boot homing)
+    if (progressJournal.hasResumableJob()) {
+        const JournalRecord& job = progressJournal.resumableJob();
+        Serial.printf("Unfinished paint job available: coat %u/%u, side %u, pass %u. Send RESUME_JOB or DISCARD_JOB.\n",
+                      job.coat, job.totalCoats, job.side, job.pass + 1);
+        sendResumeAvailable(-1);
+    }
+
     Serial.println("Idle state active. Press PnP cycle sensor to enter PnP mode."); 
 }
 
@@ -55,12 +70,9 @@ void IdleState::update() {
     // Monitor for events that trigger state changes
     // e.g., check for button presses, web commands, sensor triggers
 
-    // Update the debouncer
-    g_pnpCycleSensorDebouncer.update(); // MODIFIED: Update the global debouncer
-
     // Example: Check for a start button press
     // if (digitalRead(START_BUTTON_PIN) == HIGH) {
-    //     stateMachine->changeState(stateMachine->getHomingState()); 
+    //     stateMachine->requestTransition(STATE_HOMING); 
     // }
 
     // Example: Check for incoming web command (handled elsewhere, but could be checked here)
@@ -75,19 +87,16 @@ void IdleState::update() {
     // Update the debouncer
     // pnpCycleSensor.update(); // REMOVED for direct read
 
-    // Debug: Print sensor value every second
-    static unsigned long lastDebugTime = 0;
-    if (millis() - lastDebugTime > 1000) {
-        int sensorValue = g_pnpCycleSensorDebouncer.read(); // MODIFIED: Use global debounced read
-        // Serial.printf("PNP Cycle Sensor (debounced) value in IdleState: %d (Active when LOW)\n", sensorValue); // REMOVED
-        lastDebugTime = millis();
+    // Held for a firmware update: no PnP cycle may start before the reboot
+    if (restartHoldActive()) {
+        return;
     }
 
-    // Check if the PnP cycle sensor is pressed (active LOW, detected by falling edge)
-    if (g_pnpCycleSensorDebouncer.fell()) { // MODIFIED: Check for falling edge on global debouncer
+    // Check if a part arrived at the PnP cycle sensor (active LOW, timestamped falling edge)
+    if (cycleSensorConsumeArrival() && cycleSensorActive()) {
         Serial.println("PnP Cycle Sensor activated (falling edge) in IdleState. Transitioning to PnPState...");
         if (stateMachine) { // Check if stateMachine exists
-            stateMachine->changeState(stateMachine->getPnpState()); // Use getter
+            stateMachine->requestTransition(STATE_PNP); // Use getter
         } else {
             Serial.println("ERROR: StateMachine pointer is null in IdleState!");
         }
@@ -10,6 +10,7 @@
 #include "hardware/paintGun_Functions.h" // Added include for paintGun_OFF
 #include "motors/XYZ_Movements.h"      // ADDED: For moveToXYZ
 #include "utils/settings.h"            // ADDED: For default speeds
+#include "system/PaintProgress.h"      // For pause/resume of All Sides jobs
 
 // Define necessary variables or includes specific to PaintingState if known
 // #include "settings.h"
@@ -37,10 +38,9 @@ void PaintingState::enter() {
     Serial.println(currentStep); // Log its value *before* the if. Add specific name if possible later.
     
     // Check if we are in the special "Paint All Sides" transition
-    if (stateMachine && stateMachine->isTransitioningToPaintAllSides()) {
+    if (stateMachine && stateMachine->getEntryTransition().paintAllSides) {
         Serial.println("PaintingState: Detected 'Paint All Sides' transition. Skipping pre-paint clean request and starting 'All Sides' directly.");
         currentStep = PS_PERFORM_ALL_SIDES_PAINTING; // Set step to perform all sides painting
-        stateMachine->clearTransitioningToPaintAllSidesFlag(); // Clear the flag as it has been handled
     } else if (currentStep == PS_IDLE) {
         Serial.println("PaintingState: enter() - Normal entry or not 'Paint All Sides' specific transition. Setting to PS_REQUEST_PRE_PAINT_CLEAN.");
         currentStep = PS_REQUEST_PRE_PAINT_CLEAN; // Start the normal sequence (request clean)
@@ -62,9 +62,8 @@ void PaintingState::update() {
             Serial.println("PaintingState: Requesting short pre-paint clean.");
             if (stateMachine && stateMachine->getCleaningState()) {
                 static_cast<CleaningState*>(stateMachine->getCleaningState())->setShortMode(true);
-                stateMachine->setNextStateOverride(this); // Return to PaintingState
                 currentStep = PS_PERFORM_ALL_SIDES_PAINTING; // Set next step for when we return
-                stateMachine->changeState(stateMachine->getCleaningState());
+                stateMachine->requestTransition(STATE_CLEANING, STATE_PAINTING); // Return to PaintingState
                 // PaintingState is no longer active until CleaningState returns.
             } else {
                 Serial.println("ERROR: PaintingState - Cannot initiate cleaning, SM or CleaningState not available.");
@@ -75,6 +74,15 @@ void PaintingState::update() {
         case PS_PERFORM_ALL_SIDES_PAINTING:
             Serial.println("PaintingState: Pre-paint clean complete. Starting all sides painting routine.");
             paintAllSides(); // This is assumed to be a blocking call
+            if (isPaintJobPaused()) {
+                Serial.println("PaintingState: Paint job paused at a pass boundary. Transitioning to Paused State.");
+                currentStep = PS_IDLE;
+                if (stateMachine && stateMachine->getPausedState()) {
+                    stateMachine->requestTransition(STATE_PAUSED);
+                }
+                break;
+            }
+            paintJobEnd(); // Completed or aborted; drop any progress
             Serial.println("PaintingState: All Sides Painting routine finished.");
             currentStep = PS_MOVE_TO_POSITION_BEFORE_HOMING;
             break;
@@ -94,11 +102,11 @@ void PaintingState::update() {
         case PS_REQUEST_HOMING:
             Serial.println("PaintingState: Sequence complete. Requesting Homing State.");
             if (stateMachine && stateMachine->getHomingState()) {
-                stateMachine->changeState(stateMachine->getHomingState());
+                stateMachine->requestTransition(STATE_HOMING);
             } else {
                 Serial.println("ERROR: PaintingState - Cannot transition to HomingState.");
                 if (stateMachine && stateMachine->getIdleState()) {
-                   stateMachine->changeState(stateMachine->getIdleState());
+                   stateMachine->requestTransition(STATE_IDLE);
                 }
             }
             currentStep = PS_IDLE; // Reset for next entry into PaintingState
@@ -110,6 +118,12 @@ void PaintingState::update() {
     }
 }
 
+void PaintingState::resumePaintJob() {
+    // Skip the pre-paint clean; paintAllSides() continues from the checkpoint
+    Serial.println("PaintingState: Resuming paused paint job.");
+    currentStep = PS_PERFORM_ALL_SIDES_PAINTING;
+}
+
 void PaintingState::exit() {
     Serial.println("Exiting Painting State (All Sides)");
     // setMachineState(MachineState::UNKNOWN); // REMOVED
@@ -1,33 +1,115 @@
 #include "states/PausedState.h"
 #include <Arduino.h>
-// #include "system/machine_state.h" // No longer needed
+#include <WebSocketsServer.h>
+#include "system/StateMachine.h"
+#include "system/PaintProgress.h"
+#include "system/NetworkTask.h" // For webBroadcastTXT()
+#include "system/EventLoop.h"
+#include "hardware/paintGun_Functions.h"
+#include "hardware/pressurePot_Functions.h"
+#include "motors/ServoMotor.h"
 
-// Define necessary variables or includes specific to PausedState if known
-// #include "settings.h"
+extern StateMachine* stateMachine;
+extern WebSocketsServer webSocket;
+extern ServoMotor myServo;
 
-PausedState::PausedState() {
+// Time to re-pressurize the pot before painting resumes
+const unsigned long RESUME_PRESSURIZE_MS = 1000;
+
+//* ************************************************************************
+//* ************************** PAUSED STATE ******************************
+//* ************************************************************************
+// Entered when an All Sides job is paused at a pass boundary. The pattern has
+// already raised Z; here the tools are made safe and the checkpoint is
+// reported. RESUME restores the tool state and re-enters PaintingState, which
+// continues paintAllSides() from the recorded pass.
+
+PausedState::PausedState() :
+    currentStep(PAUSED_WAITING),
+    resumeRequested(false),
+    pressurizeStartTime(0)
+{
     // Constructor implementation
 }
 
 void PausedState::enter() {
     Serial.println("Entering Paused State");
-    // Code to run once when entering the paused state
+    currentStep = PAUSED_WAITING;
+    resumeRequested = false;
+
+    // Nothing sprays while paused
+    paintGun_OFF();
+    PressurePot_OFF();
+
+    const PaintCheckpoint& cp = paintJobCheckpoint();
+    if (cp.valid) {
+        Serial.printf("PausedState: Job paused at coat %d/%d, side %d, pass %d.\n",
+                      cp.coat, cp.totalCoats, cp.side, cp.pass + 1);
+        String msg = "PAUSED_AT:" + String(cp.coat) + "," + String(cp.totalCoats) + "," +
+                     String(cp.side) + "," + String(cp.pass + 1);
+        webBroadcastTXT(msg);
+    } else {
+        Serial.println("PausedState: No valid checkpoint. Use HOME to leave this state.");
+    }
 }
 
 void PausedState::update() {
-    // Code to run repeatedly during the paused state
-    // e.g., wait for resume command
+    const PaintCheckpoint& cp = paintJobCheckpoint();
+
+    switch (currentStep) {
+        case PAUSED_WAITING:
+            if (!resumeRequested) {
+                break;
+            }
+            resumeRequested = false;
+            if (!cp.valid) {
+                Serial.println("PausedState: Resume ignored, no valid checkpoint.");
+                break;
+            }
+            //! Restore tool state recorded at the checkpoint
+            myServo.setAngle(cp.servoAngle);
+            if (cp.pressurePotOn) {
+                PressurePot_ON();
+                pressurizeStartTime = millis();
+                currentStep = PAUSED_PRESSURIZING;
+            } else {
+                currentStep = PAUSED_RESUMING;
+            }
+            break;
+
+        case PAUSED_PRESSURIZING:
+            if (millis() - pressurizeStartTime >= RESUME_PRESSURIZE_MS) {
+                currentStep = PAUSED_RESUMING;
+            } else {
+                eventLoopWakeAt(pressurizeStartTime + RESUME_PRESSURIZE_MS);
+            }
+            break;
+
+        case PAUSED_RESUMING:
+            paintJobResume();
+            if (stateMachine && stateMachine->getPaintingState()) {
+                static_cast<PaintingState*>(stateMachine->getPaintingState())->resumePaintJob();
+                stateMachine->requestTransition(STATE_PAINTING);
+            }
+            break;
+    }
 }
 
 void PausedState::exit() {
     Serial.println("Exiting Paused State");
-    // Code to run once when exiting the paused state
-    // setMachineState(MachineState::UNKNOWN); // REMOVED
+    if (currentStep != PAUSED_RESUMING) {
+        // Leaving without RESUME (e.g. HOME): the checkpoint no longer matches the machine
+        Serial.println("PausedState: Paused job discarded.");
+        paintJobEnd();
+    }
+    currentStep = PAUSED_WAITING;
+    resumeRequested = false;
+}
+
+void PausedState::requestResume() {
+    resumeRequested = true;
 }
 
 const char* PausedState::getName() const {
     return "PAUSED";
 }
-
-// REMOVED Banner comment from the end of the file to avoid parsing issues.
-// It should ideally be placed after includes.
\ No newline at end of file
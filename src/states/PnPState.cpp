@@ -13,7 +13,12 @@
 #include "motors/Homing.h" // For homeAllAxes if needed, or a HomingState
 #include "states/HomingState.h" // Include HomingState
 #include "states/PaintingState.h" // ADDED: Include PaintingState for transition
-#include "hardware/GlobalDebouncers.h" // For g_pnpCycleSensorDebouncer
+#include "hardware/CycleSensor.h" // Interrupt timestamped cycle sensor
+#include "system/PnPTiming.h" // Placement order and actuation lead times during travel
+#include "system/EventLoop.h" // Wake at the end of timed sub-steps
+#include <WebSocketsServer.h>
+#include "system/NetworkTask.h" // For webBroadcastTXT()
+#include <ArduinoJson.h>
 
 // Reference to the global state machine instance (already declared as extern in PnPState.h)
 // extern StateMachine* stateMachine; 
@@ -23,29 +28,55 @@ extern FastAccelStepperEngine engine;
 extern FastAccelStepper *stepperX;
 extern FastAccelStepper *stepperY_Left;
 extern FastAccelStepper *stepperY_Right;
+extern FastAccelStepper *stepperZ;
 
 // External global variables for PNP settings (defined in Web_Dashboard_Commands.cpp)
+// Unloaded profile: moves to the pick location and verify moves
 extern float g_pnp_x_speed;
 extern float g_pnp_x_accel;
 extern float g_pnp_y_speed;
 extern float g_pnp_y_accel;
+// Loaded profile: pick to place with the part on the vacuum cup
+extern float g_pnp_loaded_x_speed;
+extern float g_pnp_loaded_x_accel;
+extern float g_pnp_loaded_y_speed;
+extern float g_pnp_loaded_y_accel;
+
+extern WebSocketsServer webSocket;
 
 //* ************************************************************************
 //* ************************** PnP STATE **********************************
 //* ************************************************************************
 
 PnPState::PnPState() : 
+    placementCount(0),
+    currentPlacement(0),
     currentPnPGridPosition(0), 
+    placedCells(0),
     pnpCycleIsComplete(false), 
     pnp_step(0), 
     lastCycleTime(0),
     pickLocationX_steps(0), // Added for storing pick location
     pickLocationY_steps(0),  // Added for storing pick location
     cycleTimeoutMs(0),
-    cycleStartTimeMs(0)
+    cycleStartTimeMs(0),
+    cycleStep(CYCLE_DONE),
+    cycleStepDeadline(0),
+    placeX_steps(0),
+    placeY_steps(0),
+    placeYSpeed(DEFAULT_PNP_LOADED_Y_SPEED),
+    travelStartMs(0),
+    pickRetractOverlapMs(0),
+    placeExtendLeadMs(0),
+    travelDurationMs(0),
+    placeExtendStartMs(0),
+    lastArrivalToPickUs(0),
+    phaseStartUs(0),
+    nextPartArmed(false),
+    pickArrivalCount(0)
 {
-    // Constructor: Initialize members. Debouncer needs attach in enter().
-    calculateGridPositions();
+    // Constructor: Initialize members. The cycle sensor is set up in initializeSystem().
+    // Placement order is built in enter(), once tray layouts are loaded.
     // initializeHardware(); // Called in enter() instead
 
     // Calculate pick location in steps
@@ -61,39 +92,24 @@ void PnPState::enter() {
     // setMachineState(MachineState::PNP); // REMOVED
 
     // Initialize PnP specific things
-    calculateGridPositions();
     initializeHardware();
 
     // Calculate pick location in steps
     pickLocationX_steps = (long)(PICK_LOCATION_X * STEPS_PER_INCH_XYZ);
     pickLocationY_steps = (long)(PICK_LOCATION_Y * STEPS_PER_INCH_XYZ);
     Serial.printf("Pick Location Steps: X=%ld, Y=%ld\n", pickLocationX_steps, pickLocationY_steps);
+    buildPlacementOrder();
 
     // Reset state variables
-    currentPnPGridPosition = 1; // MODIFIED: Start at the second square (index 1)
+    currentPlacement = 0;
+    currentPnPGridPosition = placementCount > 0 ? placementOrder[0] : -1;
+    placedCells = 0;
+    nextPartArmed = false;
+    cycleSensorConsumeArrival(); // Drop pulses from before this run; a present part is seen by level
     pnpCycleIsComplete = false;
     pnp_step = 0; // Start with initial move to pick location
+    cycleStep = CYCLE_DONE;
 
-    /* --- TEMPORARY MODIFICATION: Only process bottom two rows ---
-    int startRow = GRID_ROWS - 2;
-    if (startRow < 0) { // Ensure startRow is not negative if GRID_ROWS < 2
-        startRow = 0;
-    }
-    currentPnPGridPosition = startRow * GRID_COLS;
-    int totalOriginalPositions = GRID_ROWS * GRID_COLS;
-    int endPositionForThisRun = totalOriginalPositions -1; 
-
-    Serial.println("!!! TEMPORARY PnP MODE ACTIVE !!!");
-    if (GRID_ROWS < 2 && GRID_ROWS > 0) {
-        Serial.printf("NOTE: Processing only the single available row (Row 0), positions %d to %d.\n", currentPnPGridPosition, endPositionForThisRun);
-    } else if (GRID_ROWS <= 0) {
-        Serial.println("NOTE: No rows to process in PnP.");
-         pnpCycleIsComplete = true; // No positions to process
-    } else {
-        Serial.printf("NOTE: Temporarily processing only bottom two rows (starting at Row %d, positions %d to %d of %d total original positions).\n", startRow, currentPnPGridPosition, endPositionForThisRun, totalOriginalPositions);
-    }
-    Serial.println("Original full grid processing is effectively commented out by starting later.");
-    --- END TEMPORARY MODIFICATION ---*/
 
 
     // --- Initiate FIRST Move to Pick Location (Non-Blocking) ---
@@ -106,8 +122,6 @@ void PnPState::enter() {
 
 void PnPState::update() {
     // Main update loop for PnP state
-    
-    g_pnpCycleSensorDebouncer.update(); // Update the global debouncer each cycle
 
     // Check if the cycle has a timeout set and has exceeded it
     if (cycleTimeoutMs > 0 && (millis() - cycleStartTimeMs > cycleTimeoutMs)) {
@@ -124,8 +138,7 @@ void PnPState::update() {
     if (pnp_step == 1) { // Only when waiting for sensor activation
         static unsigned long lastDebugTime = 0;
         if (millis() - lastDebugTime > 500) { // Print every 0.5 seconds during this phase
-            // MODIFIED: Use debouncer's state and update log message
-            Serial.printf("PnP Cycle Sensor (debounced) value in PnPState: %d (Active when LOW)\n", g_pnpCycleSensorDebouncer.read());
+            Serial.printf("PnP Cycle Sensor (debounced) active in PnPState: %d\n", cycleSensorActive());
             lastDebugTime = millis();
         }
     }
@@ -140,51 +153,36 @@ void PnPState::update() {
             {
                 Serial.println("Initial move complete. Reached pick location.");
                 Serial.println("Now waiting for cycle sensor activation...");
+                phaseStartUs = micros();
                 pnp_step = 1; // Transition to waiting state
             }
             // Otherwise, still moving, do nothing else this loop iteration
             break;
 
         case 1: // Waiting at Pick Location for Sensor Activation
-            // Sensor is active LOW. We need to check if it *is* LOW.
-            if (g_pnpCycleSensorDebouncer.read() == LOW) { // MODIFIED: Check direct debounced state (LOW = active)
-                Serial.println("Cycle sensor active (LOW) at pick location. Proceeding...");
-
-                // Check if all positions were already completed
-                if (currentPnPGridPosition >= (GRID_ROWS * GRID_COLS)) {
-                    Serial.println("All positions already completed. Setting complete flag.");
-                    pnpCycleIsComplete = true;
-                    pnp_step = 4; // Go to completion state
-                } else {
-                    Serial.printf("Proceeding to process cycle for position %d.\n", currentPnPGridPosition);
-                    pnp_step = 2; // Move to processing state
-                }
-            }
-            // If switch not pressed, do nothing, stay in step 1.
+            // Part present (sensor LOW) or a pulse latched since the last pick
+            tryStartNextCycle();
+            // If no part, do nothing, stay in step 1.
             break;
 
-        case 2: // Process Single PnP Cycle (Blocking Pick->Move->Place)
-            // Check bounds just in case before processing
-            if (currentPnPGridPosition < 0 || currentPnPGridPosition >= (GRID_ROWS * GRID_COLS)) {
-                Serial.printf("ERROR: Invalid currentPnPGridPosition before processing cycle: %d\n", currentPnPGridPosition);
-                pnpCycleIsComplete = true; // Force exit
-                pnp_step = 4;
-                break; // Exit switch statement
+        case 2: // Process Single PnP Cycle (Pick->Move->Place, one sub-step per update)
+            if (!updatePnpCycle()) {
+                break; // Still moving or waiting on an actuator
             }
 
-            // --- Start the Blocking Cycle for the current position ---
-            Serial.printf("Starting PnP cycle for position %d...\n", currentPnPGridPosition);
-            process_single_pnp_cycle(); // This function blocks until done
-
             // --- Cycle Finished for this position ---
-            currentPnPGridPosition += 2; // MODIFIED: Increment by 2 to process every other square
-            Serial.printf("Cycle actions complete. Next logical position is %d.\n", currentPnPGridPosition);
+            endPhase(PNP_PHASE_PLACE);
+            placedCells |= (1UL << currentPnPGridPosition);
+            currentPlacement++;
+            currentPnPGridPosition = currentPlacement < placementCount ? placementOrder[currentPlacement] : -1;
+            Serial.printf("Cycle actions complete. Next cell is %d (%d of %d placed).\n",
+                          currentPnPGridPosition, currentPlacement, placementCount);
             
             // Update the last cycle timestamp
             // lastCycleTime = millis(); // REMOVED
 
             // --- Decision Point: Check if all positions are now completed ---
-            if (currentPnPGridPosition >= (GRID_ROWS * GRID_COLS)) {
+            if (currentPlacement >= placementCount) {
                 Serial.println("All PnP positions are now completed.");
                 pnpCycleIsComplete = true;
                 // Move back to pick location one last time (non-blocking) before completing
@@ -205,16 +203,25 @@ void PnPState::update() {
                 !stepperY_Left->isRunning() &&
                 !stepperY_Right->isRunning())
             {
+                endPhase(PNP_PHASE_RETURN_TRAVEL);
+                pnpStatsCycleComplete();
                 if (pnpCycleIsComplete) {
                      Serial.println("Returned to pick location. PnP process complete.");
                      pnp_step = 4; // Transition to completion state
                 } else {
                      Serial.println("Returned to pick location.");
-                     Serial.println("Now waiting for cycle sensor activation for next position...");
                      pnp_step = 1; // Transition back to waiting state
+                     // Continuous flow: a part that is already waiting is picked in this same update
+                     if (!tryStartNextCycle()) {
+                         Serial.println("Now waiting for cycle sensor activation for next position...");
+                     }
                 }
+            } else if (!pnpCycleIsComplete && !nextPartArmed &&
+                       (cycleSensorConsumeArrival() || cycleSensorActive())) {
+                // Still moving: watch the sensor so an early part is not missed
+                nextPartArmed = true;
+                Serial.println("Next part detected during return move. Pick armed.");
             }
-            // Otherwise, still moving, do nothing else this loop iteration
             break;
 
         case 4: // Completion state
@@ -224,13 +231,13 @@ void PnPState::update() {
             // MODIFIED: Transition to Homing State instead of relying on other logic or Idle directly
             if (stateMachine) {
                 Serial.println("PnP Cycle complete. Transitioning to Homing State.");
-                stateMachine->changeState(stateMachine->getHomingState()); // Assuming getHomingState() exists
+                stateMachine->requestTransition(STATE_HOMING); // Assuming getHomingState() exists
             } else {
                 Serial.println("ERROR: StateMachine pointer is null in PnPState! Cannot transition to Homing.");
                 // Fallback or error handling: maybe try to go to Idle or just log heavily
                 // For now, let's assume stateMachine is valid and try to go to Idle as a last resort if homing fails.
                 // This part might need more robust error handling depending on system design.
-                if (stateMachine) stateMachine->changeState(stateMachine->getIdleState());
+                if (stateMachine) stateMachine->requestTransition(STATE_IDLE);
             }
             break;
 
@@ -248,6 +255,18 @@ void PnPState::update() {
 void PnPState::exit() {
     // setMachineState(MachineState::UNKNOWN); // REMOVED
     Serial.println("Exiting PnP State");
+    // Left mid-cycle (e.g. HOME): make the tool safe before the next state moves
+    if (pnp_step == 2 && cycleStep != CYCLE_DONE) {
+        Serial.println("PnP cycle interrupted. Vacuum off, cylinder up.");
+        vacuumOff();
+        cylinderUp();
+    }
+    cycleStep = CYCLE_DONE;
+    // Remember which cells hold parts for a tray paint job
+    if (placedCells != 0) {
+        trayLayouts.setOccupiedCells(placedCells);
+        Serial.printf("PnP placed %d part(s); tray occupancy saved.\n", trayLayouts.occupiedCount());
+    }
     // Restore speeds if they were changed
     // Turn off any PnP specific indicators
 }
@@ -273,7 +292,7 @@ void PnPState::resetStateAndReturnToIdle() {
     
     // Transition to idle
     if (stateMachine) {
-        stateMachine->changeState(stateMachine->getIdleState());
+        stateMachine->requestTransition(STATE_IDLE);
     } else {
         Serial.println("ERROR: StateMachine pointer is null in PnPState! Cannot return to idle.");
     }
@@ -281,22 +300,88 @@ void PnPState::resetStateAndReturnToIdle() {
 
 // --- Private Helper Methods ---
 
-void PnPState::calculateGridPositions() {
-    Serial.println("Calculating grid positions...");
-    const float X_SHIFT = 4.7f; // Inches between columns
-    const float Y_SHIFT = 5.0f;  // Inches between rows
-    for (int row = 0; row < GRID_ROWS; row++) {
-        for (int col = 0; col < GRID_COLS; col++) {
-            int index = row * GRID_COLS + col;
-            gridPositionsX[index] = GRID_ORIGIN_X - (col * X_SHIFT);
-            gridPositionsY[index] = GRID_ORIGIN_Y - (row * Y_SHIFT);
-        }
+// Orders the placements of the active tray layout for the least cycle time
+// (see pnpPlanPlacementOrder) and reports the plan as a "pnp_plan" event.
+void PnPState::buildPlacementOrder() {
+    const TrayLayout& layout = trayLayouts.active();
+    float totalTravel;
+    placementCount = pnpPlanPlacementOrder(pickLocationX_steps, pickLocationY_steps, pnpLoadedProfile(),
+                                           pnpUnloadedProfile(), placementOrder, totalTravel);
+    Serial.printf("Tray layout '%s' (%dx%d): %d placement(s).\n",
+                  layout.name, layout.cols, layout.rows, placementCount);
+    if (placementCount == 0) {
+        return;
+    }
+
+    unsigned long totalMs = (unsigned long)(totalTravel * 1000.0f) + placementCount * PNP_ACTUATION_MS;
+    Serial.printf("PnP plan: %d placements, final cell %d, expected %lu ms (%lu ms per cycle).\n",
+                  placementCount, placementOrder[placementCount - 1], totalMs, totalMs / placementCount);
+
+    JsonDocument plan;
+    plan["event"] = "pnp_plan";
+    plan["layout"] = trayLayouts.active().name;
+    JsonArray order = plan["order"].to<JsonArray>();
+    for (int i = 0; i < placementCount; ++i) {
+        order.add(placementOrder[i]);
+    }
+    plan["totalMs"] = totalMs;
+    plan["cycleMs"] = totalMs / placementCount;
+    String output;
+    serializeJson(plan, output);
+    webBroadcastTXT(output);
+}
+
+// Time from the part arriving at the sensor (ISR timestamp) to the cycle
+// starting. Includes any wait while the gantry was still returning. Only
+// recorded when an arrival was seen since the previous pick; otherwise the
+// timestamp belongs to an earlier part.
+void PnPState::recordArrivalToPickLatency() {
+    unsigned long arrivalUs = 0;
+    uint32_t arrivalCount = cycleSensorArrivalCount(&arrivalUs);
+    cycleSensorConsumeArrival();
+    bool newArrival = arrivalCount != pickArrivalCount;
+    pickArrivalCount = arrivalCount;
+    if (!newArrival) {
+        lastArrivalToPickUs = 0; // Part was present without a new edge (e.g. left at the sensor)
+        return;
+    }
+    lastArrivalToPickUs = micros() - arrivalUs;
+    pnpStatsRecord(PNP_PHASE_ARRIVAL_LATENCY, lastArrivalToPickUs);
+    Serial.printf("PnP arrival-to-pick latency: %lu us\n", lastArrivalToPickUs);
+}
+
+// Starts the next cycle if a part is waiting: the sensor is active now, or a
+// pulse was seen (and latched) since the previous pick. The first cycle
+// sub-step runs right away, so a ready part costs no extra update.
+bool PnPState::tryStartNextCycle() {
+    if (!nextPartArmed && !cycleSensorConsumeArrival() && !cycleSensorActive()) {
+        return false;
+    }
+    nextPartArmed = false;
+    Serial.println("Part present at pick location. Proceeding...");
+    endPhase(PNP_PHASE_WAIT_SENSOR);
+    recordArrivalToPickLatency();
+
+    // Check if all positions were already completed
+    if (currentPlacement >= placementCount) {
+        Serial.println("All positions already completed. Setting complete flag.");
+        pnpCycleIsComplete = true;
+        pnp_step = 4; // Go to completion state
+    } else if (startPnpCycle()) {
+        Serial.printf("Proceeding to process cycle for position %d.\n", currentPnPGridPosition);
+        pnp_step = 2; // Move to processing state
+        updatePnpCycle(); // Already at the pick location: skip straight past the verify move
+    } else {
+        pnpCycleIsComplete = true; // Invalid position, force exit
+        pnp_step = 4;
     }
-    Serial.println("Grid positions calculated.");
-    // Optional: Print grid for verification
-    // for(int i=0; i<GRID_ROWS*GRID_COLS; ++i) {
-    //     Serial.printf("Pos %d: (%.2f, %.2f)\n", i, gridPositionsX[i], gridPositionsY[i]); // Fixed printf
-    // }
+    return true;
+}
+
+void PnPState::endPhase(PnPPhase phase) {
+    unsigned long nowUs = micros();
+    pnpStatsRecord(phase, nowUs - phaseStartUs);
+    phaseStartUs = nowUs;
 }
 
 void PnPState::initializeHardware() {
@@ -309,7 +394,7 @@ void PnPState::initializeHardware() {
     // Assumes PNP_CYCLE_SENSOR_PIN is already configured (e.g., INPUT_PULLUP in main setup)
     // pnpCycleSensorDebouncer.attach(PNP_CYCLE_SENSOR_PIN); // REMOVED: Using global debouncer
     // pnpCycleSensorDebouncer.; // REMOVED: Using global debouncer
-    Serial.println("PNP Cycle Sensor debouncer is now global and initialized in Setup.");
+    Serial.println("PNP Cycle Sensor is interrupt driven and initialized in Setup.");
 
     // Initialize hardware to safe state
     vacuumOff();
@@ -323,7 +408,7 @@ void PnPState::moveToPickLocation(bool initialMove) {
     Serial.println(" to pick location...");
     
     if (stepperX && stepperY_Left && stepperY_Right) {
-        // Use PNP specific speeds and accelerations
+        // Use the unloaded PNP speeds and accelerations
         stepperX->setAcceleration(g_pnp_x_accel);
         stepperY_Left->setAcceleration(g_pnp_y_accel);
         stepperY_Right->setAcceleration(g_pnp_y_accel); // Assuming Y-axis PNP accel is the same for both
@@ -346,97 +431,189 @@ void PnPState::moveToPickLocation(bool initialMove) {
     }
 }
 
-// Performs actions for the current 'currentPnPGridPosition' (BLOCKING)
-void PnPState::process_single_pnp_cycle() {
-    // Check bounds just in case
-    if (currentPnPGridPosition < 0 || currentPnPGridPosition >= (GRID_ROWS * GRID_COLS)) {
-         Serial.printf("ERROR: Invalid currentPnPGridPosition in process_single_pnp_cycle: %d\n", currentPnPGridPosition);
-         pnpCycleIsComplete = true; // Force exit in update loop
-         // Don't set pnp_step here, let the update loop handle error transition
-         return; // Exit this function early
+// Starts a non-blocking move of the gantry; Z is kept at home (0)
+void PnPState::startMoveTo(long x, float xSpeed, float xAccel, long y, float ySpeed, float yAccel) {
+    stepperX->setAcceleration(xAccel);
+    stepperY_Left->setAcceleration(yAccel);
+    stepperY_Right->setAcceleration(yAccel);
+    stepperX->setSpeedInHz(xSpeed);
+    stepperY_Left->setSpeedInHz(ySpeed);
+    stepperY_Right->setSpeedInHz(ySpeed);
+    stepperZ->setSpeedInHz(DEFAULT_Z_SPEED);
+
+    stepperX->moveTo(x);
+    stepperY_Left->moveTo(y);
+    stepperY_Right->moveTo(y);
+    stepperZ->moveTo(0);
+}
+
+bool PnPState::axesIdle() {
+    return !stepperX->isRunning() && !stepperY_Left->isRunning() &&
+           !stepperY_Right->isRunning() && !stepperZ->isRunning();
+}
+
+void PnPState::startTimedStep(PnPCycleStep step, unsigned long durationMs) {
+    cycleStep = step;
+    cycleStepDeadline = millis() + durationMs;
+}
+
+// Works out the place move for the current position and how much actuator
+// time can overlap with it (see pnpPlanPlaceMove).
+void PnPState::planPlaceMove() {
+    //! STEP 3: Get target grid position coordinates
+    placeX_steps = trayLayouts.cellXSteps(currentPnPGridPosition);
+    placeY_steps = trayLayouts.cellYSteps(currentPnPGridPosition);
+
+    int row = currentPnPGridPosition / trayLayouts.active().cols;
+    int col = currentPnPGridPosition % trayLayouts.active().cols;
+    Serial.printf("Moving to grid position [%d][%d] (%d): X=%.2f (%ld steps), Y=%.2f (%ld steps)\n",
+                  row, col, currentPnPGridPosition, placeX_steps / STEPS_PER_INCH_XYZ, placeX_steps,
+                  placeY_steps / STEPS_PER_INCH_XYZ, placeY_steps);
+
+    // Check if the current PnP position is the last one that will be processed before completion.
+    bool isThisTheFinalPlacement = (currentPlacement + 1 >= placementCount);
+    PnPMoveProfile loaded = pnpLoadedProfile();
+    placeYSpeed = pnpPlaceMoveYSpeed(loaded, isThisTheFinalPlacement);
+    if (isThisTheFinalPlacement) {
+        Serial.println("INFO: This is the final PnP placement. Reducing Y speed by half for this move.");
     }
 
-    // Ensure motors are stopped before starting blocking moves (should be already stopped if coming from wait state)
-    if (stepperX && stepperX->isRunning()) stepperX->stopMove();
-    if (stepperY_Left && stepperY_Left->isRunning()) stepperY_Left->stopMove();
-    if (stepperY_Right && stepperY_Right->isRunning()) stepperY_Right->stopMove();
+    PnPPlaceTiming timing = pnpPlanPlaceMove(placeX_steps - stepperX->getCurrentPosition(),
+                                             placeY_steps - stepperY_Left->getCurrentPosition(),
+                                             loaded, isThisTheFinalPlacement);
+    travelDurationMs = timing.travelMs;
+    pickRetractOverlapMs = timing.retractOverlapMs;
+    placeExtendLeadMs = timing.extendLeadMs;
+    if (pickRetractOverlapMs > 0 || placeExtendLeadMs > 0) {
+        Serial.printf("PnP overlap: travel %lu ms, retract overlap %lu ms, extend lead %lu ms\n",
+                      travelDurationMs, pickRetractOverlapMs, placeExtendLeadMs);
+    }
+}
+
+// Starts the cycle for the current 'currentPnPGridPosition'. Returns false if
+// the position is out of range.
+bool PnPState::startPnpCycle() {
+    // Check bounds just in case
+    if (currentPlacement >= placementCount || !trayLayouts.isPlacementCell(currentPnPGridPosition)) {
+         Serial.printf("ERROR: Invalid currentPnPGridPosition in startPnpCycle: %d\n", currentPnPGridPosition);
+         cycleStep = CYCLE_DONE;
+         return false;
+    }
 
     Serial.printf("Processing PnP position %d (%d of %d)\n",
-                  currentPnPGridPosition, currentPnPGridPosition + 1, GRID_ROWS * GRID_COLS);
+                  currentPnPGridPosition, currentPlacement + 1, placementCount);
 
     //! STEP 1: Confirm already at pick location (or move if somehow drifted - should not happen in normal flow)
     // Since we always return to pick location now, this move *should* be instantaneous or very small
-    // Can be removed if confident state machine always ensures starting at pick location
     Serial.println("Verifying at pick location...");
-     moveToXYZ(
-         pickLocationX_steps, DEFAULT_X_SPEED,
-         pickLocationY_steps, DEFAULT_Y_SPEED,
-         0, DEFAULT_Z_SPEED // Z assumed at home/0
-     );
-    Serial.println("Confirmed at pick location.");
-
-
-    //! STEP 2: Extend cylinder, activate vacuum, retract cylinder
-    Serial.println("Extending cylinder...");
-    cylinderDown();
-    delay(PNP_PICK_DELAY_AFTER_CYLINDER_EXTEND); // CORRECTED
-    Serial.println("Activating vacuum...");
-    vacuumOn();
-    delay(PNP_PICK_DELAY_AFTER_VACUUM_ON + 50); // CORRECTED (and kept +50)
-    Serial.println("Retracting cylinder...");
-    cylinderUp();
-    delay(PNP_PICK_DELAY_AFTER_CYLINDER_RETRACT); // CORRECTED
-    Serial.println("Pick sequence complete.");
+    startMoveTo(pickLocationX_steps, g_pnp_x_speed, g_pnp_x_accel, pickLocationY_steps, g_pnp_y_speed, g_pnp_y_accel);
+    cycleStep = CYCLE_VERIFY_PICK;
+    return true;
+}
 
-    //! STEP 3: Get target grid position coordinates
-    float targetX_inch = gridPositionsX[currentPnPGridPosition];
-    float targetY_inch = gridPositionsY[currentPnPGridPosition];
-    long targetX_steps = (long)(targetX_inch * STEPS_PER_INCH_XYZ);
-    long targetY_steps = (long)(targetY_inch * STEPS_PER_INCH_XYZ);
-
-    //! STEP 4: Move to place position (Blocking)
-    int row = currentPnPGridPosition / GRID_COLS;
-    int col = currentPnPGridPosition % GRID_COLS;
-    Serial.printf("Moving to grid position [%d][%d] (%d): X=%.2f (%ld steps), Y=%.2f (%ld steps)\n",
-                  row, col, currentPnPGridPosition, targetX_inch, targetX_steps, targetY_inch, targetY_steps);
+// Advances the cycle by at most one sub-step. Returns true once the part is
+// placed and the cylinder retracted; the machine is then at the place location.
+bool PnPState::updatePnpCycle() {
+    bool timerExpired = (long)(millis() - cycleStepDeadline) >= 0;
+    if (!timerExpired) {
+        eventLoopWakeAt(cycleStepDeadline);
+    }
 
-    float y_speed_for_placement = DEFAULT_Y_SPEED; // Initialize with default Y speed
-    int total_positions = GRID_ROWS * GRID_COLS;
+    switch (cycleStep) {
+        case CYCLE_VERIFY_PICK:
+            if (!axesIdle()) break;
+            endPhase(PNP_PHASE_VERIFY_MOVE);
+            Serial.println("Confirmed at pick location.");
 
-    // Check if the current PnP position is the last one that will be processed before completion.
-    // Completion occurs when (currentPnPGridPosition_after_increment >= total_positions).
-    // So, if (currentPnPGridPosition + 2 >= total_positions), this is the last cycle.
-    bool isThisTheFinalPlacement = ((currentPnPGridPosition + 2) >= total_positions);
+            //! STEP 2: Extend cylinder, activate vacuum, retract cylinder
+            Serial.println("Extending cylinder...");
+            cylinderDown();
+            startTimedStep(CYCLE_PICK_EXTEND, PNP_PICK_DELAY_AFTER_CYLINDER_EXTEND);
+            break;
 
-    if (isThisTheFinalPlacement) {
-        Serial.println("INFO: This is the final PnP placement. Reducing Y speed by half for this move.");
-        y_speed_for_placement = DEFAULT_Y_SPEED / 2.0f;
-        if (y_speed_for_placement < 1.0f) { // Safeguard against excessively slow speed
-            y_speed_for_placement = 1.0f;
-            Serial.println("WARN: Calculated Y speed for final placement is very low. Clamped to 1.0 Hz.");
-        }
-    }
+        case CYCLE_PICK_EXTEND:
+            if (!timerExpired) break;
+            Serial.println("Activating vacuum...");
+            vacuumOn();
+            startTimedStep(CYCLE_PICK_VACUUM, PNP_PICK_DELAY_AFTER_VACUUM_ON + PNP_PICK_VACUUM_SETTLE_MS);
+            break;
 
-    moveToXYZ(
-        targetX_steps, DEFAULT_X_SPEED,
-        targetY_steps, y_speed_for_placement, // Use potentially modified Y speed
-        0, DEFAULT_Z_SPEED // Z assumed at home/0
-    );
-     Serial.println("Arrived at place location.");
-
-    //! STEP 5: Extend cylinder, deactivate vacuum, retract cylinder
-    Serial.println("Extending cylinder to place component...");
-    cylinderDown();
-    delay(PNP_PLACE_DELAY_AFTER_CYLINDER_EXTEND); // CORRECTED
-    Serial.println("Deactivating vacuum...");
-    vacuumOff();
-    delay(PNP_PLACE_DELAY_AFTER_VACUUM_OFF); // CORRECTED
-    Serial.println("Retracting cylinder...");
-    cylinderUp();
-    delay(PNP_PLACE_DELAY_AFTER_CYLINDER_RETRACT); // CORRECTED
+        case CYCLE_PICK_VACUUM:
+            if (!timerExpired) break;
+            Serial.println("Retracting cylinder...");
+            cylinderUp();
+            // Travel starts before the retract delay is over, while the
+            // gantry is still creeping out of its acceleration ramp
+            planPlaceMove();
+            startTimedStep(CYCLE_PICK_RETRACT, PNP_PICK_DELAY_AFTER_CYLINDER_RETRACT - pickRetractOverlapMs);
+            break;
+
+        case CYCLE_PICK_RETRACT:
+            if (!timerExpired) break;
+            Serial.println("Pick sequence complete.");
+
+            //! STEP 4: Move to place position
+            endPhase(PNP_PHASE_PICK);
+            startMoveTo(placeX_steps, g_pnp_loaded_x_speed, g_pnp_loaded_x_accel,
+                        placeY_steps, placeYSpeed, g_pnp_loaded_y_accel);
+            travelStartMs = millis();
+            placeExtendStartMs = 0;
+            cycleStep = CYCLE_TRAVEL;
+            break;
+
+        case CYCLE_TRAVEL:
+            // Start extending during the final deceleration once the profile
+            // says the remaining travel is within the allowed overlap
+            if (placeExtendStartMs == 0 && placeExtendLeadMs > 0 &&
+                millis() - travelStartMs + placeExtendLeadMs >= travelDurationMs) {
+                long overlapSteps = (long)(PNP_PLACE_EXTEND_OVERLAP_INCHES * STEPS_PER_INCH_XYZ);
+                if (labs(stepperX->getCurrentPosition() - placeX_steps) <= overlapSteps &&
+                    labs(stepperY_Left->getCurrentPosition() - placeY_steps) <= overlapSteps) {
+                    Serial.println("Extending cylinder to place component (during final deceleration)...");
+                    cylinderDown();
+                    placeExtendStartMs = millis() | 1; // Never 0 while set
+                }
+            }
+            if (!axesIdle()) break;
+            endPhase(PNP_PHASE_LOADED_TRAVEL);
+            Serial.println("Arrived at place location.");
+
+            //! STEP 5: Extend cylinder, deactivate vacuum, retract cylinder
+            if (placeExtendStartMs != 0) {
+                // Already extending: only wait out what is left of its delay
+                unsigned long extending = millis() - placeExtendStartMs;
+                startTimedStep(CYCLE_PLACE_EXTEND, extending < PNP_PLACE_DELAY_AFTER_CYLINDER_EXTEND ?
+                               PNP_PLACE_DELAY_AFTER_CYLINDER_EXTEND - extending : 0);
+            } else {
+                Serial.println("Extending cylinder to place component...");
+                cylinderDown();
+                startTimedStep(CYCLE_PLACE_EXTEND, PNP_PLACE_DELAY_AFTER_CYLINDER_EXTEND);
+            }
+            break;
+
+        case CYCLE_PLACE_EXTEND:
+            if (!timerExpired) break;
+            Serial.println("Deactivating vacuum...");
+            vacuumOff();
+            startTimedStep(CYCLE_PLACE_RELEASE, PNP_PLACE_DELAY_AFTER_VACUUM_OFF);
+            break;
 
-    Serial.println("Place sequence complete. Cycle finished, machine is at Place Location.");
-    Serial.println("------------------------------------");
-    // NOTE: Function ends here. The machine is currently at the place location.
-    // The state machine (update loop) will now initiate the move back to the pick location.
-}
\ No newline at end of file
+        case CYCLE_PLACE_RELEASE:
+            if (!timerExpired) break;
+            Serial.println("Retracting cylinder...");
+            cylinderUp();
+            startTimedStep(CYCLE_PLACE_RETRACT, PNP_PLACE_DELAY_AFTER_CYLINDER_RETRACT);
+            break;
+
+        case CYCLE_PLACE_RETRACT:
+            if (!timerExpired) break;
+            Serial.println("Place sequence complete. Cycle finished, machine is at Place Location.");
+            Serial.println("------------------------------------");
+            cycleStep = CYCLE_DONE;
+            return true;
+
+        case CYCLE_DONE:
+            return true;
+    }
+    return false;
+}
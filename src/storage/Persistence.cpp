@@ -81,6 +81,19 @@ bool Persistence::loadBool(const char* key, bool defaultValue) {
     return value;
 }
 
+void Persistence::saveBytes(const char* key, const void* data, size_t length) {
+    preferences.putBytes(key, data, length);
+    Serial.printf("Saved %u byte record %s\n", (unsigned)length, key);
+}
+
+size_t Persistence::loadBytes(const char* key, void* buffer, size_t length) {
+    if (!preferences.isKey(key) || preferences.getBytesLength(key) != length) {
+        // Missing or written by a different record layout
+        return 0;
+    }
+    return preferences.getBytes(key, buffer, length);
+}
+
 void Persistence::clearAll() {
     preferences.clear();
     Serial.println("All settings cleared");
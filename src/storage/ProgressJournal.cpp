@@ -0,0 +1,138 @@
+#include "storage/ProgressJournal.h"
+#include "storage/Persistence.h"
+#include <esp_attr.h>
+#include <esp_rom_crc.h>
+
+//* ************************************************************************
+//* ************************ PROGRESS JOURNAL ******************************
+//* ************************************************************************
+
+ProgressJournal progressJournal;
+
+const uint32_t JOURNAL_MAGIC = 0x504A524E; // "PJRN"
+
+// NVS keys of the ring slots
+static const char* const JOURNAL_KEYS[JOURNAL_NVS_SLOTS] = {"pjrn0", "pjrn1", "pjrn2", "pjrn3"};
+
+// Survives software resets; contents are garbage after power-on (CRC rejects them)
+RTC_NOINIT_ATTR static JournalRecord rtcJournal;
+
+uint32_t ProgressJournal::computeCrc(const JournalRecord& record) {
+    return esp_rom_crc32_le(0, (const uint8_t*)&record, offsetof(JournalRecord, crc));
+}
+
+bool ProgressJournal::isValid(const JournalRecord& record) {
+    return record.magic == JOURNAL_MAGIC && record.crc == computeCrc(record);
+}
+
+void ProgressJournal::begin() {
+    JournalRecord newest = {};
+    bool found = false;
+
+    if (isValid(rtcJournal)) {
+        newest = rtcJournal;
+        found = true;
+    }
+
+    persistence.beginTransaction(true);
+    for (int i = 0; i < JOURNAL_NVS_SLOTS; ++i) {
+        JournalRecord slot;
+        if (persistence.loadBytes(JOURNAL_KEYS[i], &slot, sizeof(slot)) != sizeof(slot) || !isValid(slot)) {
+            continue;
+        }
+        if (!found || (int32_t)(slot.sequence - newest.sequence) > 0) {
+            newest = slot;
+            found = true;
+        }
+    }
+    persistence.endTransaction();
+
+    if (!found) {
+        Serial.println("ProgressJournal: No journal found.");
+        return;
+    }
+
+    // Keep numbering going so new records always supersede the old ones
+    current = newest;
+    current.active = 0;
+
+    if (newest.active) {
+        pending = newest;
+        resumable = true;
+        Serial.printf("ProgressJournal: Unfinished job %lu found at coat %u/%u, side %u, pass %u.\n",
+                      (unsigned long)newest.jobId, newest.coat, newest.totalCoats, newest.side, newest.pass + 1);
+    }
+}
+
+void ProgressJournal::write(bool flushToFlash) {
+    // Pass writes only touch RTC memory, so the NVS slot follows its own
+    // count: consecutive flushes always land in different slots
+    uint8_t slot = current.flushCount % JOURNAL_NVS_SLOTS;
+    if (flushToFlash) {
+        current.flushCount++;
+    }
+    current.magic = JOURNAL_MAGIC;
+    current.sequence++;
+    current.crc = computeCrc(current);
+    rtcJournal = current;
+
+    if (flushToFlash) {
+        persistence.beginTransaction(false);
+        persistence.saveBytes(JOURNAL_KEYS[slot], &current, sizeof(current));
+        persistence.endTransaction();
+    }
+}
+
+void ProgressJournal::startJob(int totalCoats, int interCoatDelaySeconds, int mode) {
+    resumable = false; // A new job replaces whatever was left over
+    current.jobId++;
+    current.active = 1;
+    current.totalCoats = (uint8_t)totalCoats;
+    current.interCoatDelaySeconds = (uint16_t)interCoatDelaySeconds;
+    current.coat = 1;
+    current.fixture = 0;
+    current.mode = (uint8_t)mode;
+    current.side = 0;
+    current.pass = 0;
+    write(true);
+}
+
+void ProgressJournal::continueJob(const JournalRecord& record) {
+    uint32_t sequence = current.sequence;
+    uint8_t flushCount = current.flushCount;
+    current = record;
+    current.sequence = sequence;
+    current.flushCount = flushCount;
+    current.active = 1;
+    resumable = false;
+    write(true);
+}
+
+void ProgressJournal::recordProgress(int coat, int fixture, int side, int pass, bool flushToFlash) {
+    if (!current.active) {
+        return;
+    }
+    current.coat = (uint8_t)coat;
+    current.fixture = (uint8_t)fixture;
+    current.side = (uint8_t)side;
+    current.pass = (uint8_t)pass;
+    write(flushToFlash);
+}
+
+void ProgressJournal::finishJob() {
+    if (!current.active) {
+        return;
+    }
+    current.active = 0;
+    write(true);
+}
+
+void ProgressJournal::discardResumableJob() {
+    if (!resumable) {
+        return;
+    }
+    Serial.printf("ProgressJournal: Unfinished job %lu discarded.\n", (unsigned long)pending.jobId);
+    resumable = false;
+    current.active = 0;
+    write(true); // Newest record is now inactive, so it is not offered again
+}
@@ -0,0 +1,182 @@
+#include "storage/TrayLayouts.h"
+#include "storage/Persistence.h"
+#include "utils/settings.h"
+
+//* ************************************************************************
+//* ************************** TRAY LAYOUTS ********************************
+//* ************************************************************************
+
+TrayLayouts trayLayouts;
+
+static const char* const TRAY_LAYOUT_KEYS[MAX_TRAY_LAYOUTS] = {"tray0", "tray1", "tray2", "tray3"};
+static const char* const TRAY_ACTIVE_KEY = "trayAct";
+static const char* const TRAY_OCCUPIED_KEY = "trayOcc";
+static const char* const TRAY_PAINT_OFFSET_X_KEY = "trayPOffX";
+static const char* const TRAY_PAINT_OFFSET_Y_KEY = "trayPOffY";
+
+// Pitch of the original hard-coded grid (inches)
+const float DEFAULT_TRAY_PITCH_X = 4.7f;
+const float DEFAULT_TRAY_PITCH_Y = 5.0f;
+
+TrayLayout TrayLayouts::defaultLayout() {
+    TrayLayout layout = {};
+    strncpy(layout.name, "Default 4x5", TRAY_LAYOUT_NAME_LEN - 1);
+    layout.cols = GRID_COLS;
+    layout.rows = GRID_ROWS;
+    layout.originX = GRID_ORIGIN_X;
+    layout.originY = GRID_ORIGIN_Y;
+    layout.pitchX = DEFAULT_TRAY_PITCH_X;
+    layout.pitchY = DEFAULT_TRAY_PITCH_Y;
+    // Every other cell, starting at cell 1
+    for (int cell = 1; cell < GRID_COLS * GRID_ROWS; cell += 2) {
+        layout.placementMask |= (1UL << cell);
+    }
+    return layout;
+}
+
+bool TrayLayouts::isValid(const TrayLayout& layout) {
+    int cells = layout.cols * layout.rows;
+    return layout.cols > 0 && layout.rows > 0 && cells <= MAX_TRAY_CELLS &&
+           layout.pitchX >= 0.0f && layout.pitchY >= 0.0f;
+}
+
+void TrayLayouts::begin() {
+    persistence.beginTransaction(true);
+    for (int i = 0; i < MAX_TRAY_LAYOUTS; ++i) {
+        TrayLayout stored;
+        defined[i] = persistence.loadBytes(TRAY_LAYOUT_KEYS[i], &stored, sizeof(stored)) == sizeof(stored) &&
+                     isValid(stored);
+        if (defined[i]) {
+            stored.name[TRAY_LAYOUT_NAME_LEN - 1] = '\0';
+            layouts[i] = stored;
+        }
+    }
+    activeLayout = persistence.loadInt(TRAY_ACTIVE_KEY, 0);
+    occupiedMask = (uint32_t)persistence.loadInt(TRAY_OCCUPIED_KEY, 0);
+    paintOffsetXInches = persistence.loadFloat(TRAY_PAINT_OFFSET_X_KEY, 0.0f);
+    paintOffsetYInches = persistence.loadFloat(TRAY_PAINT_OFFSET_Y_KEY, 0.0f);
+    persistence.endTransaction();
+
+    if (!defined[0]) {
+        layouts[0] = defaultLayout();
+        defined[0] = true;
+    }
+    if (activeLayout < 0 || activeLayout >= MAX_TRAY_LAYOUTS || !defined[activeLayout]) {
+        activeLayout = 0;
+    }
+    buildStepTable();
+    Serial.printf("TrayLayouts: Active layout %d '%s' (%dx%d, %d placements, %d occupied).\n", activeLayout,
+                  active().name, active().cols, active().rows, placementCount(), occupiedCount());
+}
+
+bool TrayLayouts::isDefined(int index) const {
+    return index >= 0 && index < MAX_TRAY_LAYOUTS && defined[index];
+}
+
+const TrayLayout& TrayLayouts::layout(int index) const {
+    return layouts[isDefined(index) ? index : 0];
+}
+
+bool TrayLayouts::saveLayout(int index, const TrayLayout& layout) {
+    if (index < 0 || index >= MAX_TRAY_LAYOUTS || !isValid(layout)) {
+        return false;
+    }
+    TrayLayout copy = layout;
+    copy.name[TRAY_LAYOUT_NAME_LEN - 1] = '\0';
+    int cells = copy.cols * copy.rows;
+    if (cells < 32) {
+        copy.placementMask &= (1UL << cells) - 1; // Drop bits outside the grid
+    }
+
+    layouts[index] = copy;
+    defined[index] = true;
+    persistence.beginTransaction(false);
+    persistence.saveBytes(TRAY_LAYOUT_KEYS[index], &copy, sizeof(copy));
+    persistence.endTransaction();
+
+    if (index == activeLayout) {
+        buildStepTable();
+        setOccupiedCells(0); // Geometry changed: the recorded parts no longer match
+    }
+    return true;
+}
+
+bool TrayLayouts::select(int index) {
+    if (!isDefined(index)) {
+        return false;
+    }
+    bool changed = (index != activeLayout);
+    activeLayout = index;
+    persistence.beginTransaction(false);
+    persistence.saveInt(TRAY_ACTIVE_KEY, activeLayout);
+    persistence.endTransaction();
+    buildStepTable();
+    if (changed) {
+        setOccupiedCells(0);
+    }
+    Serial.printf("TrayLayouts: Selected layout %d '%s'.\n", activeLayout, active().name);
+    return true;
+}
+
+int TrayLayouts::cellCount() const {
+    return active().cols * active().rows;
+}
+
+bool TrayLayouts::isPlacementCell(int cell) const {
+    return cell >= 0 && cell < cellCount() && (active().placementMask & (1UL << cell)) != 0;
+}
+
+int TrayLayouts::placementCount() const {
+    int count = 0;
+    for (int cell = 0; cell < cellCount(); ++cell) {
+        if (isPlacementCell(cell)) count++;
+    }
+    return count;
+}
+
+void TrayLayouts::buildStepTable() {
+    const TrayLayout& layout = active();
+    for (int row = 0; row < layout.rows; ++row) {
+        for (int col = 0; col < layout.cols; ++col) {
+            int cell = row * layout.cols + col;
+            stepX[cell] = (long)((layout.originX - col * layout.pitchX) * STEPS_PER_INCH_XYZ);
+            stepY[cell] = (long)((layout.originY - row * layout.pitchY) * STEPS_PER_INCH_XYZ);
+        }
+    }
+}
+
+void TrayLayouts::setOccupiedCells(uint32_t mask) {
+    int cells = cellCount();
+    if (cells < 32) {
+        mask &= (1UL << cells) - 1;
+    }
+    occupiedMask = mask;
+    persistence.beginTransaction(false);
+    persistence.saveInt(TRAY_OCCUPIED_KEY, (int)occupiedMask);
+    persistence.endTransaction();
+}
+
+int TrayLayouts::occupiedCount() const {
+    int count = 0;
+    for (int cell = 0; cell < cellCount(); ++cell) {
+        if (occupiedMask & (1UL << cell)) count++;
+    }
+    return count;
+}
+
+void TrayLayouts::setPaintOffset(float offsetX, float offsetY) {
+    paintOffsetXInches = offsetX;
+    paintOffsetYInches = offsetY;
+    persistence.beginTransaction(false);
+    persistence.saveFloat(TRAY_PAINT_OFFSET_X_KEY, paintOffsetXInches);
+    persistence.saveFloat(TRAY_PAINT_OFFSET_Y_KEY, paintOffsetYInches);
+    persistence.endTransaction();
+}
+
+long TrayLayouts::cellPaintOffsetXSteps(int cell) const {
+    return (long)(paintOffsetXInches * STEPS_PER_INCH_XYZ) + stepX[cell] - stepX[0];
+}
+
+long TrayLayouts::cellPaintOffsetYSteps(int cell) const {
+    return (long)(paintOffsetYInches * STEPS_PER_INCH_XYZ) + stepY[cell] - stepY[0];
+}
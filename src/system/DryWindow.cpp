@@ -0,0 +1,193 @@
+#include "system/DryWindow.h"
+#include <Arduino.h>
+#include <FastAccelStepper.h>
+#include <WebSocketsServer.h>
+#include "system/NetworkTask.h" // For webBroadcastTXT()
+#include "utils/settings.h"
+#include "states/CleaningState.h"
+#include "motors/XYZ_Movements.h"
+#include "../../include/web/Web_Dashboard_Commands.h" // For checkForHomeCommand
+#include "system/EventLoop.h"
+#include "hardware/InputSampler.h" // Debounced home switches with edge times
+#include "hardware/pressurePot_Functions.h" // Pot restored after the gun clean
+#include "system/Supervisor.h" // Probes and the final wait run as timed segments
+
+extern FastAccelStepper *stepperX;
+extern FastAccelStepper *stepperY_Left;
+extern FastAccelStepper *stepperY_Right;
+extern FastAccelStepper *stepperZ;
+extern WebSocketsServer webSocket;
+extern bool isPressurePot_ON;
+
+//* ************************************************************************
+//* *************************** DRY WINDOW *********************************
+//* ************************************************************************
+
+struct DryWindowTask {
+    const char* name;
+    unsigned long estimateMs;   // Raised to the longest observed run
+    bool (*run)();              // Blocking, returns false when aborted by HOME
+};
+
+static bool runCleanGunTask();
+static bool runDriftCheckTask();
+
+// Tasks are offered in table order, each at most once per window
+static DryWindowTask DRY_WINDOW_TASKS[] = {
+    {"CLEAN_GUN", DRY_TASK_CLEAN_ESTIMATE_MS, runCleanGunTask},
+    {"DRIFT_CHECK", DRY_TASK_DRIFT_ESTIMATE_MS, runDriftCheckTask}
+};
+
+static void reportProgress(unsigned long elapsedMs, unsigned long durationMs, const char* activity) {
+    String msg = "DRY_WINDOW:" + String(elapsedMs / 1000) + "," + String(durationMs / 1000) + "," + activity;
+    webBroadcastTXT(msg);
+}
+
+//! Task: short gun clean so paint does not skin over in the nozzle
+static bool runCleanGunTask() {
+    bool potWasOn = isPressurePot_ON;
+    bool completed = runCleaningCycle(true, true);
+    if (!potWasOn) {
+        PressurePot_OFF(); // The cycle pressurizes the pot; do not leave it on while the coat dries
+    }
+    return completed;
+}
+
+// Creeps one axis toward its home switch. Homing leaves position 0 at
+// HOMING_MOVE_AWAY_INCHES from the trigger point, so the trigger should come
+// at direction * that distance; the difference is the accumulated drift.
+// The switch is debounced by the input sampler; the trigger point is taken
+// back to the time the change began, at the constant creep speed. The drift
+// is only reported: re-referencing the axis is left to homing.
+static bool probeAxisDrift(FastAccelStepper* stepper, InputId input, int direction, const char* axis) {
+    long expectedSteps = direction * (long)(HOMING_MOVE_AWAY_INCHES * STEPS_PER_INCH_XYZ);
+    long limitSteps = expectedSteps + direction * (long)(DRIFT_CHECK_OVERTRAVEL_INCHES * STEPS_PER_INCH_XYZ);
+
+    stepper->setSpeedInHz(DRIFT_CHECK_SPEED);
+    stepper->moveTo(limitSteps);
+
+    long triggerSteps = 0;
+    bool triggered = false;
+    while (stepper->isRunning()) {
+        if (checkForHomeCommand()) {
+            return false;
+        }
+        if (inputActive(input)) {
+            unsigned long sinceEdgeUs = micros() - inputLastEdgeUs(input);
+            triggerSteps = stepper->getCurrentPosition() - direction * (long)((uint64_t)DRIFT_CHECK_SPEED * sinceEdgeUs / 1000000UL);
+            triggered = true;
+            break;
+        }
+        eventLoopSleep(EVENT_LOOP_MOTION_POLL_MS); // Woken early by the switch change
+    }
+
+    if (!triggered) {
+        Serial.printf("DryWindow: %s switch not found within %.2f in. Drift too large, rehome recommended.\n",
+                      axis, DRIFT_CHECK_OVERTRAVEL_INCHES);
+        webBroadcastTXT(String("DRY_WINDOW_DRIFT:") + axis + ",LOST");
+    } else {
+        long drift = triggerSteps - expectedSteps;
+        stepper->stopMove(); // Ramps down from creep speed within a few steps
+        while (stepper->isRunning()) {
+            eventLoopSleep(EVENT_LOOP_MOTION_POLL_MS);
+        }
+        Serial.printf("DryWindow: %s drift %ld steps (not corrected).\n", axis, drift);
+        webBroadcastTXT(String("DRY_WINDOW_DRIFT:") + axis + "," + String(drift));
+        if (labs(drift) > DRIFT_CHECK_REHOME_STEPS) {
+            Serial.printf("DryWindow: %s drift above %d steps. Rehome recommended.\n", axis, DRIFT_CHECK_REHOME_STEPS);
+        }
+    }
+
+    stepper->setSpeedInHz(DRIFT_CHECK_SPEED * 4);
+    stepper->moveTo(0);
+    while (stepper->isRunning()) {
+        if (checkForHomeCommand()) {
+            return false;
+        }
+        eventLoopSleep(EVENT_LOOP_MOTION_POLL_MS);
+    }
+    return true;
+}
+
+//! Task: measure X and Z drift against the home switches.
+// Y is left alone: its two gantry motors would have to be probed together.
+static bool runDriftCheckTask() {
+    // Raise Z first, then bring X and Y back to the origin
+    if (!moveToXYZ_HomeCheck(stepperX->getCurrentPosition(), DEFAULT_X_SPEED,
+                             stepperY_Left->getCurrentPosition(), DEFAULT_Y_SPEED, 0, DEFAULT_Z_SPEED)) {
+        return false;
+    }
+    if (!moveToXYZ_HomeCheck(0, DEFAULT_X_SPEED, 0, DEFAULT_Y_SPEED, 0, DEFAULT_Z_SPEED)) {
+        return false;
+    }
+
+    // Each probe creeps out to the overtravel limit and returns at four times the speed
+    long probeSteps = (long)((HOMING_MOVE_AWAY_INCHES + DRIFT_CHECK_OVERTRAVEL_INCHES) * STEPS_PER_INCH_XYZ);
+    unsigned long probeBudgetMs = supervisorMoveBudgetMs(probeSteps, DRIFT_CHECK_SPEED) +
+                                  supervisorMoveBudgetMs(probeSteps, DRIFT_CHECK_SPEED * 4);
+    supervisorSegmentBegin("driftProbeZ", probeBudgetMs);
+    bool probed = probeAxisDrift(stepperZ, INPUT_Z_HOME, 1, "Z"); // Z homes upward
+    supervisorSegmentEnd();
+    if (!probed) return false;
+    supervisorSegmentBegin("driftProbeX", probeBudgetMs);
+    probed = probeAxisDrift(stepperX, INPUT_X_HOME, -1, "X");
+    supervisorSegmentEnd();
+    if (!probed) return false;
+
+    stepperX->setSpeedInHz(DEFAULT_X_SPEED);
+    stepperZ->setSpeedInHz(DEFAULT_Z_SPEED);
+    return true;
+}
+
+bool runDryWindow(unsigned long durationMs, int nextCoat) {
+    Serial.printf("DryWindow: %lu ms before coat %d.\n", durationMs, nextCoat);
+    unsigned long startTime = millis();
+
+    for (size_t i = 0; i < sizeof(DRY_WINDOW_TASKS) / sizeof(DRY_WINDOW_TASKS[0]); ++i) {
+        DryWindowTask& task = DRY_WINDOW_TASKS[i];
+        unsigned long elapsed = millis() - startTime;
+        unsigned long remaining = elapsed < durationMs ? durationMs - elapsed : 0;
+
+        if (task.estimateMs + DRY_WINDOW_MARGIN_MS > remaining) {
+            Serial.printf("DryWindow: Skipping %s (needs ~%lu ms, %lu ms left).\n", task.name, task.estimateMs, remaining);
+            continue;
+        }
+
+        Serial.printf("DryWindow: Running %s (~%lu ms).\n", task.name, task.estimateMs);
+        reportProgress(elapsed, durationMs, task.name);
+        unsigned long taskStart = millis();
+        if (!task.run()) {
+            Serial.printf("DryWindow: %s aborted by HOME command.\n", task.name);
+            return false;
+        }
+        unsigned long taskMs = millis() - taskStart;
+        if (taskMs > task.estimateMs) {
+            task.estimateMs = taskMs; // Never plan on a faster run than we have seen
+        }
+        Serial.printf("DryWindow: %s took %lu ms.\n", task.name, taskMs);
+    }
+
+    // Wait out the rest of the window without moving any axis
+    unsigned long waitStart = millis() - startTime;
+    supervisorSegmentBegin("dryWindowWait", (waitStart < durationMs ? durationMs - waitStart : 0) + SUPERVISOR_MOVE_MARGIN_MS);
+    unsigned long lastReport = 0;
+    while (millis() - startTime < durationMs) {
+        if (checkForHomeCommand()) {
+            Serial.printf("DryWindow: HOME command before coat %d.\n", nextCoat);
+            supervisorSegmentEnd();
+            return false;
+        }
+        unsigned long elapsed = millis() - startTime;
+        if (lastReport == 0 || elapsed - lastReport >= DRY_WINDOW_REPORT_INTERVAL_MS) {
+            reportProgress(elapsed, durationMs, "WAITING");
+            lastReport = elapsed == 0 ? 1 : elapsed;
+        }
+        unsigned long remaining = elapsed < durationMs ? durationMs - elapsed : 0;
+        eventLoopSleep(min(remaining, (unsigned long)DRY_WINDOW_REPORT_INTERVAL_MS)); // Wakes early on HOME
+    }
+    supervisorSegmentEnd();
+
+    webBroadcastTXT("DRY_WINDOW:DONE");
+    Serial.printf("DryWindow: Complete after %lu ms.\n", millis() - startTime);
+    return true;
+}
@@ -0,0 +1,71 @@
+#include "system/EventLoop.h"
+#include <FastAccelStepper.h>
+#include "utils/settings.h"
+#include "motors/Rotation_Motor.h"
+
+extern FastAccelStepper *stepperX;
+extern FastAccelStepper *stepperY_Left;
+extern FastAccelStepper *stepperY_Right;
+extern FastAccelStepper *stepperZ;
+
+//* ************************************************************************
+//* **************************** EVENT LOOP ********************************
+//* ************************************************************************
+
+static TaskHandle_t controllerTask = nullptr;
+static bool deadlineRequested = false;
+static unsigned long nextDeadlineMs = 0;
+
+void eventLoopBegin() {
+    controllerTask = xTaskGetCurrentTaskHandle();
+}
+
+void eventLoopNotify() {
+    if (controllerTask) {
+        xTaskNotifyGive(controllerTask);
+    }
+}
+
+void IRAM_ATTR eventLoopNotifyFromISR() {
+    if (!controllerTask) {
+        return;
+    }
+    BaseType_t higherPriorityTaskWoken = pdFALSE;
+    vTaskNotifyGiveFromISR(controllerTask, &higherPriorityTaskWoken);
+    if (higherPriorityTaskWoken) {
+        portYIELD_FROM_ISR();
+    }
+}
+
+void eventLoopWakeAt(unsigned long deadlineMs) {
+    if (!deadlineRequested || (long)(deadlineMs - nextDeadlineMs) < 0) {
+        nextDeadlineMs = deadlineMs;
+        deadlineRequested = true;
+    }
+}
+
+static bool axesMoving() {
+    return (stepperX && stepperX->isRunning()) || (stepperY_Left && stepperY_Left->isRunning()) ||
+           (stepperY_Right && stepperY_Right->isRunning()) || (stepperZ && stepperZ->isRunning()) ||
+           (rotationStepper && rotationStepper->isRunning());
+}
+
+void eventLoopWait() {
+    long sleepMs = EVENT_LOOP_MAX_SLEEP_MS;
+    if (deadlineRequested) {
+        sleepMs = min(sleepMs, (long)(nextDeadlineMs - millis()));
+        deadlineRequested = false;
+    }
+    if (axesMoving()) {
+        sleepMs = min(sleepMs, (long)EVENT_LOOP_MOTION_POLL_MS);
+    }
+    if (sleepMs <= 0) {
+        return; // Already due
+    }
+    eventLoopSleep(sleepMs);
+}
+
+void eventLoopSleep(unsigned long maxMs) {
+    TickType_t ticks = pdMS_TO_TICKS(maxMs);
+    ulTaskNotifyTake(pdTRUE, ticks > 0 ? ticks : 1);
+}
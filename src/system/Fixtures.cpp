@@ -0,0 +1,112 @@
+#include "system/Fixtures.h"
+#include "storage/Persistence.h"
+#include "utils/settings.h"
+#include "storage/TrayLayouts.h"
+
+//* ************************************************************************
+//* **************************** FIXTURES **********************************
+//* ************************************************************************
+
+// NVS keys per fixture (fixture 1 is fixed at the origin and not stored)
+static const char* const FIXTURE_ENABLED_KEYS[MAX_FIXTURES] = {"", "fx2En", "fx3En"};
+static const char* const FIXTURE_OFFSET_X_KEYS[MAX_FIXTURES] = {"", "fx2X", "fx3X"};
+static const char* const FIXTURE_OFFSET_Y_KEYS[MAX_FIXTURES] = {"", "fx2Y", "fx3Y"};
+
+static Fixture fixtures[MAX_FIXTURES] = {
+    {true, 0.0f, 0.0f},
+    {false, 0.0f, 0.0f},
+    {false, 0.0f, 0.0f}
+};
+static int activeFixture = 0;
+static long activeOffsetXSteps = 0;     // Offset the patterns currently apply
+static long activeOffsetYSteps = 0;
+static PatternCellMode cellMode = PATTERN_STANDALONE;
+
+static bool isValidIndex(int index) {
+    return index >= 0 && index < MAX_FIXTURES;
+}
+
+void loadFixtures() {
+    persistence.beginTransaction(true);
+    for (int i = 1; i < MAX_FIXTURES; ++i) {
+        fixtures[i].enabled = persistence.loadBool(FIXTURE_ENABLED_KEYS[i], false);
+        fixtures[i].offsetX = persistence.loadFloat(FIXTURE_OFFSET_X_KEYS[i], 0.0f);
+        fixtures[i].offsetY = persistence.loadFloat(FIXTURE_OFFSET_Y_KEYS[i], 0.0f);
+    }
+    persistence.endTransaction();
+    Serial.printf("Fixtures: %d enabled.\n", enabledFixtureCount());
+}
+
+void saveFixtures() {
+    persistence.beginTransaction(false);
+    for (int i = 1; i < MAX_FIXTURES; ++i) {
+        persistence.saveBool(FIXTURE_ENABLED_KEYS[i], fixtures[i].enabled);
+        persistence.saveFloat(FIXTURE_OFFSET_X_KEYS[i], fixtures[i].offsetX);
+        persistence.saveFloat(FIXTURE_OFFSET_Y_KEYS[i], fixtures[i].offsetY);
+    }
+    persistence.endTransaction();
+}
+
+const Fixture& getFixture(int index) {
+    return fixtures[isValidIndex(index) ? index : 0];
+}
+
+void setFixtureEnabled(int index, bool enabled) {
+    if (!isValidIndex(index) || index == 0) {
+        return; // Fixture 1 is always enabled
+    }
+    fixtures[index].enabled = enabled;
+}
+
+void setFixtureOffset(int index, float offsetX, float offsetY) {
+    if (!isValidIndex(index) || index == 0) {
+        return; // Fixture 1 defines the origin
+    }
+    fixtures[index].offsetX = offsetX;
+    fixtures[index].offsetY = offsetY;
+}
+
+int enabledFixtureCount() {
+    int count = 0;
+    for (int i = 0; i < MAX_FIXTURES; ++i) {
+        if (fixtures[i].enabled) count++;
+    }
+    return count;
+}
+
+void setActiveFixture(int index) {
+    activeFixture = isValidIndex(index) ? index : 0;
+    activeOffsetXSteps = (long)(fixtures[activeFixture].offsetX * STEPS_PER_INCH_XYZ);
+    activeOffsetYSteps = (long)(fixtures[activeFixture].offsetY * STEPS_PER_INCH_XYZ);
+}
+
+void setActiveTrayCell(int cell) {
+    activeFixture = 0;
+    if (cell < 0 || cell >= trayLayouts.cellCount()) {
+        activeOffsetXSteps = 0;
+        activeOffsetYSteps = 0;
+        return;
+    }
+    activeOffsetXSteps = trayLayouts.cellPaintOffsetXSteps(cell);
+    activeOffsetYSteps = trayLayouts.cellPaintOffsetYSteps(cell);
+}
+
+void setPatternCellMode(PatternCellMode mode) {
+    cellMode = mode;
+}
+
+PatternCellMode patternCellMode() {
+    return cellMode;
+}
+
+int getActiveFixture() {
+    return activeFixture;
+}
+
+long fixtureOffsetXSteps() {
+    return activeOffsetXSteps;
+}
+
+long fixtureOffsetYSteps() {
+    return activeOffsetYSteps;
+}
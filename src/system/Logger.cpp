@@ -0,0 +1,208 @@
+#include "system/Logger.h"
+#include "utils/settings.h"
+#include "utils/SpscRing.h"
+#include "system/NetworkTask.h" // For webBroadcastTXT()
+
+//* ************************************************************************
+//* ****************************** LOGGER **********************************
+//* ************************************************************************
+
+struct LogRecord {
+    uint32_t timeUs;
+    const char* format;
+    LogLevel level;
+    uint8_t argCount;
+    LogArg args[LOG_MAX_ARGS];
+};
+
+std::atomic<uint8_t> logActiveLevel{LOG_DEFAULT_SERIAL_LEVEL > LOG_DEFAULT_WEB_LEVEL ? LOG_DEFAULT_SERIAL_LEVEL
+                                                                                      : LOG_DEFAULT_WEB_LEVEL};
+static std::atomic<uint8_t> serialLevel{LOG_DEFAULT_SERIAL_LEVEL};
+static std::atomic<uint8_t> webLevel{LOG_DEFAULT_WEB_LEVEL};
+
+// One ring per core. The critical section only keeps tasks on the same core
+// from interleaving a push; the other core uses the other ring, so it never spins.
+static SpscRing<LogRecord, LOG_RING_LENGTH> rings[portNUM_PROCESSORS];
+static portMUX_TYPE ringMux[portNUM_PROCESSORS] = {portMUX_INITIALIZER_UNLOCKED, portMUX_INITIALIZER_UNLOCKED};
+static std::atomic<uint32_t> droppedCount{0};
+static SemaphoreHandle_t drainMutex = nullptr; // The rings have one consumer: the log task or logFlush()
+
+static const char* const LEVEL_NAMES[] = {"OFF", "ERROR", "WARN", "INFO", "DEBUG"};
+
+void logPush(LogLevel level, const char* format, const LogArg* args, uint8_t argCount) {
+    int core = xPortGetCoreID();
+    portENTER_CRITICAL(&ringMux[core]);
+    LogRecord* record = rings[core].pushSlot();
+    if (record) {
+        record->timeUs = micros();
+        record->format = format;
+        record->level = level;
+        record->argCount = argCount;
+        memcpy(record->args, args, argCount * sizeof(LogArg));
+        rings[core].commitPush();
+    }
+    portEXIT_CRITICAL(&ringMux[core]);
+    if (!record) {
+        droppedCount.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+// printf of the stored format, one conversion at a time from the 32-bit arguments
+static void formatRecord(const LogRecord& record, char* out, size_t size) {
+    size_t length = 0;
+    uint8_t argIndex = 0;
+    const char* p = record.format;
+    while (*p && length < size - 1) {
+        if (*p != '%') {
+            out[length++] = *p++;
+            continue;
+        }
+        const char* specStart = p++;
+        if (*p == '%') {
+            out[length++] = '%';
+            p++;
+            continue;
+        }
+
+        char spec[16] = "%";
+        size_t specLength = 1;
+        while (*p && strchr("-+ #0123456789.", *p) && specLength < sizeof(spec) - 3) {
+            spec[specLength++] = *p++;
+        }
+        while (*p == 'l' || *p == 'h' || *p == 'z') {
+            p++; // Arguments are stored as 32 bits; the length is chosen below
+        }
+        char conversion = *p;
+        if (!conversion) {
+            break;
+        }
+        p++;
+
+        if (argIndex >= record.argCount || !strchr("diuxXocsfeEgG", conversion)) {
+            // Missing argument or unsupported conversion: copy it as written
+            while (specStart < p && length < size - 1) {
+                out[length++] = *specStart++;
+            }
+            continue;
+        }
+
+        const LogArg& arg = record.args[argIndex++];
+        bool integer = strchr("diuxXo", conversion) != nullptr;
+        if (integer) {
+            spec[specLength++] = 'l';
+        }
+        spec[specLength++] = conversion;
+        spec[specLength] = '\0';
+
+        int written;
+        if (conversion == 'd' || conversion == 'i') {
+            written = snprintf(out + length, size - length, spec, (long)arg.i);
+        } else if (integer) {
+            written = snprintf(out + length, size - length, spec, (unsigned long)arg.u);
+        } else if (conversion == 'c') {
+            written = snprintf(out + length, size - length, spec, (int)arg.i);
+        } else if (conversion == 's') {
+            written = snprintf(out + length, size - length, spec, arg.s ? arg.s : "(null)");
+        } else {
+            written = snprintf(out + length, size - length, spec, (double)arg.f);
+        }
+        if (written > 0) {
+            length = min(length + (size_t)written, size - 1);
+        }
+    }
+    out[length] = '\0';
+}
+
+static void writeLine(LogLevel level, uint32_t timeUs, const char* text) {
+    if (level <= serialLevel.load(std::memory_order_relaxed)) {
+        unsigned long timeMs = timeUs / 1000;
+        Serial.printf("[%lu.%03lu] %s\n", timeMs / 1000, timeMs % 1000, text);
+    }
+    if (level <= webLevel.load(std::memory_order_relaxed)) {
+        webBroadcastTXT(String("LOG:") + LEVEL_NAMES[level] + ":" + text);
+    }
+}
+
+// Oldest record of either ring first, so the output keeps the order of the calls
+static void drainRings() {
+    char text[LOG_LINE_LENGTH];
+    for (;;) {
+        const LogRecord* oldest = nullptr;
+        int oldestCore = 0;
+        for (int core = 0; core < portNUM_PROCESSORS; core++) {
+            const LogRecord* record = rings[core].front();
+            if (record && (!oldest || (int32_t)(record->timeUs - oldest->timeUs) < 0)) {
+                oldest = record;
+                oldestCore = core;
+            }
+        }
+        if (!oldest) {
+            break;
+        }
+        LogLevel level = oldest->level;
+        uint32_t timeUs = oldest->timeUs;
+        formatRecord(*oldest, text, sizeof(text));
+        rings[oldestCore].pop();
+        writeLine(level, timeUs, text);
+    }
+
+    uint32_t dropped = droppedCount.exchange(0, std::memory_order_relaxed);
+    if (dropped > 0) {
+        snprintf(text, sizeof(text), "LOG: %lu messages dropped (ring full)", (unsigned long)dropped);
+        writeLine(LOG_LEVEL_WARN, micros(), text);
+    }
+}
+
+static void logTask(void* parameter) {
+    for (;;) {
+        logFlush();
+        vTaskDelay(pdMS_TO_TICKS(LOG_DRAIN_PERIOD_MS));
+    }
+}
+
+void logFlush() {
+    if (!drainMutex) {
+        drainRings(); // Log task not started, nothing else drains
+        return;
+    }
+    xSemaphoreTake(drainMutex, portMAX_DELAY);
+    drainRings();
+    xSemaphoreGive(drainMutex);
+}
+
+void startLogTask() {
+    drainMutex = xSemaphoreCreateMutex();
+    if (!drainMutex ||
+        xTaskCreatePinnedToCore(logTask, "log", LOG_TASK_STACK_SIZE, nullptr,
+                                LOG_TASK_PRIORITY, nullptr, LOG_TASK_CORE) != pdPASS) {
+        Serial.println("ERROR: Failed to start the log task!");
+    }
+}
+
+void logSetLevels(LogLevel serial, LogLevel web) {
+    serialLevel.store(serial, std::memory_order_relaxed);
+    webLevel.store(web, std::memory_order_relaxed);
+    logActiveLevel.store(max((uint8_t)serial, (uint8_t)web), std::memory_order_relaxed);
+}
+
+LogLevel logSerialLevel() {
+    return (LogLevel)serialLevel.load(std::memory_order_relaxed);
+}
+
+LogLevel logWebLevel() {
+    return (LogLevel)webLevel.load(std::memory_order_relaxed);
+}
+
+bool logParseLevel(const char* name, LogLevel& level) {
+    for (uint8_t i = LOG_LEVEL_OFF; i <= LOG_LEVEL_DEBUG; i++) {
+        if (name && strcasecmp(name, LEVEL_NAMES[i]) == 0) {
+            level = (LogLevel)i;
+            return true;
+        }
+    }
+    return false;
+}
+
+const char* logLevelName(LogLevel level) {
+    return level <= LOG_LEVEL_DEBUG ? LEVEL_NAMES[level] : "?";
+}
@@ -0,0 +1,44 @@
+#include "system/MotionAbort.h"
+#include <atomic>
+#include <FastAccelStepper.h>
+#include "utils/settings.h"
+#include "system/EventLoop.h"
+#include "motors/Rotation_Motor.h"
+
+extern FastAccelStepper *stepperX;
+extern FastAccelStepper *stepperY_Left;
+extern FastAccelStepper *stepperY_Right;
+extern FastAccelStepper *stepperZ;
+
+//* ************************************************************************
+//* ************************** MOTION ABORT ********************************
+//* ************************************************************************
+
+static std::atomic<bool> abortRequested{false};
+
+void motionAbortRequest() {
+    abortRequested.store(true, std::memory_order_release);
+    eventLoopNotify();
+}
+
+bool motionAbortPending() {
+    return abortRequested.load(std::memory_order_acquire);
+}
+
+void motionAbortClear() {
+    abortRequested.store(false, std::memory_order_release);
+}
+
+void motionAbortStopAxes() {
+    FastAccelStepper* axes[] = {stepperX, stepperY_Left, stepperY_Right, stepperZ, rotationStepper};
+    for (FastAccelStepper* axis : axes) {
+        if (axis && axis->isRunning()) {
+            axis->stopMove(); // Ramps down at the axis' current acceleration
+        }
+    }
+    for (FastAccelStepper* axis : axes) {
+        while (axis && axis->isRunning()) {
+            eventLoopSleep(EVENT_LOOP_MOTION_POLL_MS);
+        }
+    }
+}
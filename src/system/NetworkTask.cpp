@@ -0,0 +1,245 @@
+#include "system/NetworkTask.h"
+#include "system/EventLoop.h"
+#include "utils/settings.h"
+#include <ArduinoOTA.h>
+#include <WebSocketsServer.h>
+#include <ArduinoJson.h>
+#include "utils/SpscRing.h"
+#include "web/Web_Dashboard_Commands.h" // For runDashboardServer(), processWebCommand()
+#include "system/PaintProgress.h" // For pauseCommandReceived
+#include "system/Telemetry.h"
+#include "system/MotionAbort.h" // HOME is raised as it arrives
+#include "system/Supervisor.h" // Stall check and task watchdog
+#include "system/RetainedPositions.h" // Commands are refused during firmware updates
+#include "system/Logger.h" // Flushed before a restart
+#include <atomic>
+
+extern WebSocketsServer webSocket;
+
+//* ************************************************************************
+//* *************************** NETWORK TASK *******************************
+//* ************************************************************************
+
+// Outbound text for the network task
+struct WebMessage {
+    int16_t num;  // Client, or -1 to broadcast
+    char* text;   // Heap copy, freed by the network task
+};
+
+enum WebCommandLatch : uint8_t {
+    LATCH_NONE,
+    LATCH_HOME,   // Motion abort requested by the callback
+    LATCH_PAUSE   // pauseCommandReceived raised by the callback
+};
+
+// Command received by the network task
+struct WebCommandRecord {
+    uint8_t num;
+    WebCommandLatch latch;
+    uint16_t length;
+    char text[WEB_COMMAND_MAX_LENGTH];
+};
+
+static SpscRing<WebCommandRecord, WEB_COMMAND_QUEUE_LENGTH> commandRing;
+static bool networkTaskRunning = false;
+static QueueHandle_t outboundQueue = nullptr;
+static TaskHandle_t networkTaskHandle = nullptr;
+static std::atomic<bool> restartRequested{false};
+
+static char* copyText(const char* text, size_t length) {
+    char* copy = (char*)malloc(length + 1);
+    if (copy) {
+        memcpy(copy, text, length);
+        copy[length] = '\0';
+    }
+    return copy;
+}
+
+// Queues a copy of 'text'; falls back to a direct write before the task runs
+static void enqueueOutbound(int16_t num, const String& text) {
+    if (!outboundQueue) {
+        if (num < 0) webSocket.broadcastTXT(text);
+        else webSocket.sendTXT(num, text);
+        return;
+    }
+    WebMessage message = {num, copyText(text.c_str(), text.length())};
+    if (!message.text) {
+        Serial.println("ERROR: Out of memory for outbound WebSocket message.");
+        return;
+    }
+    if (xQueueSend(outboundQueue, &message, 0) != pdTRUE) {
+        free(message.text);
+        Serial.println("WARNING: WebSocket outbound queue full, message dropped.");
+    }
+}
+
+static void sendQueuedOutbound() {
+    WebMessage message;
+    while (xQueueReceive(outboundQueue, &message, 0) == pdTRUE) {
+        if (message.num < 0) webSocket.broadcastTXT(message.text);
+        else webSocket.sendTXT(message.num, message.text);
+        free(message.text);
+    }
+}
+
+// Machine snapshot for the dashboard, read without touching the controller
+static void broadcastTelemetry() {
+    static unsigned long lastBroadcastMs = 0;
+    Telemetry telemetry;
+    if (millis() - lastBroadcastMs < TELEMETRY_BROADCAST_MS || webSocket.connectedClients() == 0 ||
+        !telemetryRead(telemetry)) {
+        return;
+    }
+    lastBroadcastMs = millis();
+    JsonDocument doc;
+    telemetryToJson(telemetry, doc);
+    String output;
+    serializeJson(doc, output);
+    webSocket.broadcastTXT(output);
+}
+
+// Everything queued before the request (the RESTART reply, log lines) goes out first
+static void restartAfterSend() {
+    logFlush();
+    sendQueuedOutbound();
+    webSocket.disconnect();
+    vTaskDelay(pdMS_TO_TICKS(WEB_RESTART_LINGER_MS)); // Let the stack send the data and the close frames
+    ESP.restart();
+}
+
+static void networkTask(void* parameter) {
+    supervisorWatchdogBegin();
+    for (;;) {
+        ArduinoOTA.handle();
+        runDashboardServer(); // HTTP clients and WebSocket events
+        sendQueuedOutbound();
+        if (restartRequested.load(std::memory_order_acquire)) {
+            restartAfterSend();
+        }
+        broadcastTelemetry();
+        supervisorCheck(); // Feeds the task watchdog while the controller makes progress
+        vTaskDelay(pdMS_TO_TICKS(NETWORK_TASK_PERIOD_MS));
+    }
+}
+
+void startNetworkTask() {
+    outboundQueue = xQueueCreate(WEB_OUTBOUND_QUEUE_LENGTH, sizeof(WebMessage));
+    networkTaskRunning = true; // Commands are queued from now on
+    if (!outboundQueue ||
+        xTaskCreatePinnedToCore(networkTask, "network", NETWORK_TASK_STACK_SIZE, nullptr,
+                                NETWORK_TASK_PRIORITY, &networkTaskHandle, NETWORK_TASK_CORE) != pdPASS) {
+        Serial.println("ERROR: Failed to start the network task!");
+        return;
+    }
+    Serial.printf("Network task started on core %d; motion runs on core %d.\n",
+                  NETWORK_TASK_CORE, xPortGetCoreID());
+}
+
+// HOME and PAUSE take effect through flags polled by blocking operations,
+// so they are raised here rather than when the record is reached
+static WebCommandLatch latchInterruptCommand(const char* text, size_t length) {
+    String action;
+    JsonDocument doc;
+    if (text[0] == '{' && !deserializeJson(doc, text, length) && doc["command"].is<const char*>()) {
+        action = doc["command"].as<const char*>();
+    } else {
+        action = text;
+    }
+    action.trim();
+    int colonIndex = action.indexOf(':');
+    if (colonIndex >= 0) {
+        action = action.substring(0, colonIndex);
+    }
+    action.toUpperCase();
+
+    if (restartHoldActive()) {
+        return LATCH_NONE; // Refused by the controller until the reboot
+    }
+    if (action == "HOME") {
+        motionAbortRequest();
+        return LATCH_HOME;
+    }
+    if (action == "PAUSE") {
+        pauseCommandReceived = true; // Cleared by the job if none is running
+        return LATCH_PAUSE;
+    }
+    return LATCH_NONE;
+}
+
+bool webEnqueueCommand(uint8_t num, const uint8_t* payload, size_t length) {
+    if (!networkTaskRunning) {
+        processWebCommand(&webSocket, num, String((const char*)payload)); // Not split yet (setup)
+        return true;
+    }
+    // Before the capacity checks: HOME and PAUSE act even if their record is
+    // dropped (the library terminates text payloads)
+    WebCommandLatch latch = latchInterruptCommand((const char*)payload, length);
+    if (length >= WEB_COMMAND_MAX_LENGTH) {
+        Serial.printf("WARNING: WebSocket command of %u bytes dropped (max %d).\n",
+                      (unsigned)length, WEB_COMMAND_MAX_LENGTH - 1);
+        webSocket.sendTXT(num, latch == LATCH_NONE ? "CMD_ERROR: Command too long"
+                                                   : "CMD_ERROR: Command too long (HOME/PAUSE still applied)");
+        return false;
+    }
+    WebCommandRecord* record = commandRing.pushSlot();
+    if (!record) {
+        Serial.println("WARNING: WebSocket command ring full, command dropped.");
+        webSocket.sendTXT(num, latch == LATCH_NONE ? "CMD_ERROR: Busy, command dropped"
+                                                   : "CMD_ERROR: Busy, command dropped (HOME/PAUSE still applied)");
+        return false;
+    }
+    record->num = num;
+    record->length = length;
+    memcpy(record->text, payload, length);
+    record->text[length] = '\0';
+    record->latch = latch;
+    commandRing.commitPush();
+    eventLoopNotify();
+    return true;
+}
+
+void processQueuedWebCommands() {
+    restartHoldUpdate(); // Before any command can start motion
+    const WebCommandRecord* record;
+    while ((record = commandRing.front()) != nullptr) {
+        uint8_t num = record->num;
+        WebCommandLatch latch = record->latch;
+        String command = record->text;
+        commandRing.pop(); // Free the slot before running, the command may take a while
+
+        if (restartHoldActive()) {
+            webSendTXT(num, "CMD_ERROR: Firmware update in progress.");
+            continue;
+        }
+        if (latch == LATCH_HOME && !motionAbortPending()) {
+            // Already acted on by a blocking operation, which entered homing
+            webSendTXT(num, "CMD_ACK: Homing sequence initiated.");
+            continue;
+        }
+        if (latch == LATCH_PAUSE && isPaintJobPaused()) {
+            // The job already stopped at a pass boundary
+            webSendTXT(num, "CMD_ACK: Paint job paused.");
+            continue;
+        }
+        processWebCommand(&webSocket, num, command);
+    }
+    // A HOME whose record was dropped (ring full) still ends in homing
+    if (motionAbortPending()) {
+        checkForHomeCommand();
+    }
+}
+
+void webRestartAfterSend() {
+    if (!networkTaskRunning) {
+        ESP.restart(); // Sends are direct before the task runs
+    }
+    restartRequested.store(true, std::memory_order_release);
+}
+
+void webSendTXT(uint8_t num, const String& text) {
+    enqueueOutbound(num, text);
+}
+
+void webBroadcastTXT(const String& text) {
+    enqueueOutbound(-1, text);
+}
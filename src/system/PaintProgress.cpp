@@ -0,0 +1,252 @@
+#include "system/PaintProgress.h"
+#include <Arduino.h>
+#include <FastAccelStepper.h>
+#include "motors/ServoMotor.h"
+#include "motors/Rotation_Motor.h"
+#include "motors/PaintingSides.h"
+#include "storage/ProgressJournal.h"
+#include "system/Fixtures.h"
+#include "storage/TrayLayouts.h"
+
+extern FastAccelStepper *stepperX;
+extern FastAccelStepper *stepperY_Left;
+extern FastAccelStepper *stepperZ;
+extern ServoMotor myServo;
+extern bool isPaintGun_ON;
+extern bool isPressurePot_ON;
+
+//* ************************************************************************
+//* ************************* PAINT PROGRESS *******************************
+//* ************************************************************************
+
+volatile bool pauseCommandReceived = false;
+
+enum PaintJobStatus {
+    JOB_NONE,
+    JOB_RUNNING,
+    JOB_PAUSED,
+    JOB_RESUMING,
+    JOB_ABORTED     // HOME during the job: patterns unwind until paintJobEnd()
+};
+
+static PaintJobStatus jobStatus = JOB_NONE;
+static PaintJobMode jobMode = PAINT_JOB_FIXTURES;
+static int jobTotalCoats = 0;
+static int jobCoat = 0;
+static int jobFixture = 0;
+static int jobSide = 0;
+static int jobPass = 0;
+static PaintCheckpoint checkpoint = {};
+
+void paintJobBegin(int totalCoats, PaintJobMode mode) {
+    jobStatus = JOB_RUNNING;
+    jobMode = mode;
+    jobTotalCoats = totalCoats;
+    jobCoat = 1;
+    jobFixture = 0;
+    jobSide = 0;
+    jobPass = 0;
+    checkpoint.valid = false;
+    pauseCommandReceived = false;
+    progressJournal.startJob(totalCoats, g_interCoatDelaySeconds, mode);
+    Serial.printf("PaintProgress: %s job started (%d coat(s)).\n", mode == PAINT_JOB_TRAY ? "Tray" : "Fixture", totalCoats);
+}
+
+void paintJobEnd() {
+    if (jobStatus == JOB_NONE) {
+        return;
+    }
+    Serial.println("PaintProgress: Job finished.");
+    progressJournal.finishJob();
+    setActiveFixture(0);
+    jobStatus = JOB_NONE;
+    checkpoint.valid = false;
+    pauseCommandReceived = false;
+}
+
+void paintJobAbort() {
+    if (jobStatus == JOB_NONE || jobStatus == JOB_ABORTED) {
+        return;
+    }
+    Serial.println("PaintProgress: Job aborted, checkpoint discarded.");
+    progressJournal.finishJob();
+    setActiveFixture(0);
+    jobStatus = JOB_ABORTED;
+    checkpoint.valid = false;
+    pauseCommandReceived = false;
+}
+
+bool isPaintJobActive() {
+    return jobStatus == JOB_RUNNING || jobStatus == JOB_PAUSED || jobStatus == JOB_RESUMING;
+}
+
+bool isPaintJobRunning() {
+    return jobStatus == JOB_RUNNING || jobStatus == JOB_RESUMING;
+}
+
+bool isPaintJobPaused() {
+    return jobStatus == JOB_PAUSED;
+}
+
+void paintJobBeginCoat(int coat) {
+    jobCoat = coat;
+}
+
+void paintJobBeginFixture(int fixture) {
+    jobFixture = fixture;
+    if (jobMode == PAINT_JOB_TRAY) {
+        setActiveTrayCell(fixture);
+    } else {
+        setActiveFixture(fixture);
+    }
+}
+
+void paintJobBeginSide(int side) {
+    jobSide = side;
+    if (jobStatus == JOB_RESUMING && side == checkpoint.side) {
+        jobPass = checkpoint.pass; // Resumed side starts at its checkpoint pass
+        return;
+    }
+    jobPass = 0;
+    if (jobStatus == JOB_RUNNING) {
+        progressJournal.recordProgress(jobCoat, jobFixture, jobSide, jobPass, true); // Side boundary: flush to flash
+    }
+}
+
+void paintJobPassComplete(int side, int pass) {
+    jobSide = side;
+    jobPass = pass + 1;
+    if (isPaintJobRunning()) {
+        progressJournal.recordProgress(jobCoat, jobFixture, jobSide, jobPass, false); // Pass boundary: RTC only
+    }
+}
+
+// Captures the machine at the current pass boundary. Called before the
+// pattern raises Z so the recorded position is the painting position.
+static void recordCheckpoint() {
+    checkpoint.valid = true;
+    checkpoint.totalCoats = jobTotalCoats;
+    checkpoint.mode = jobMode;
+    checkpoint.coat = jobCoat;
+    checkpoint.fixture = jobFixture;
+    checkpoint.side = jobSide;
+    checkpoint.pass = jobPass;
+    checkpoint.xSteps = stepperX ? stepperX->getCurrentPosition() : 0;
+    checkpoint.ySteps = stepperY_Left ? stepperY_Left->getCurrentPosition() : 0;
+    checkpoint.zSteps = stepperZ ? stepperZ->getCurrentPosition() : 0;
+    checkpoint.rotationSteps = rotationStepper ? rotationStepper->getCurrentPosition() : 0;
+    checkpoint.paintGunOn = isPaintGun_ON;
+    checkpoint.pressurePotOn = isPressurePot_ON;
+    checkpoint.servoAngle = myServo.getCurrentAngle();
+
+    Serial.printf("PaintProgress: Checkpoint at coat %d/%d, fixture %d, side %d, pass %d (X=%ld Y=%ld Z=%ld).\n",
+                  checkpoint.coat, checkpoint.totalCoats, checkpoint.fixture + 1, checkpoint.side, checkpoint.pass,
+                  checkpoint.xSteps, checkpoint.ySteps, checkpoint.zSteps);
+}
+
+bool paintJobStopRequested() {
+    if (jobStatus == JOB_NONE) {
+        // Not inside a job (single side from the dashboard): nothing to checkpoint
+        pauseCommandReceived = false;
+        return false;
+    }
+    if (!isPaintJobRunning()) {
+        return true; // Aborted (or already paused): keep unwinding
+    }
+    if (pauseCommandReceived) {
+        pauseCommandReceived = false;
+        recordCheckpoint();
+        progressJournal.recordProgress(jobCoat, jobFixture, jobSide, jobPass, true);
+        jobStatus = JOB_PAUSED;
+        return true;
+    }
+    return false;
+}
+
+void paintJobResume() {
+    if (jobStatus != JOB_PAUSED || !checkpoint.valid) {
+        Serial.println("PaintProgress: Resume requested but no paused job.");
+        return;
+    }
+    jobStatus = JOB_RESUMING;
+    jobMode = checkpoint.mode;
+    jobTotalCoats = checkpoint.totalCoats;
+    jobCoat = checkpoint.coat;
+    jobFixture = checkpoint.fixture;
+    jobSide = checkpoint.side;
+    jobPass = checkpoint.pass;
+    pauseCommandReceived = false;
+    Serial.printf("PaintProgress: Resuming at coat %d, side %d, pass %d.\n",
+                  checkpoint.coat, checkpoint.side, checkpoint.pass);
+}
+
+bool paintJobRestoreFromJournal() {
+    if (jobStatus != JOB_NONE || !progressJournal.hasResumableJob()) {
+        return false;
+    }
+    const JournalRecord& record = progressJournal.resumableJob();
+
+    // Tool and axis state is not journaled; the side patterns set servo,
+    // pressure pot and rotation themselves and the machine has been homed.
+    checkpoint = {};
+    checkpoint.valid = true;
+    checkpoint.totalCoats = record.totalCoats;
+    checkpoint.mode = record.mode == PAINT_JOB_TRAY ? PAINT_JOB_TRAY : PAINT_JOB_FIXTURES;
+    checkpoint.coat = record.coat;
+    int targetCount = checkpoint.mode == PAINT_JOB_TRAY ? MAX_TRAY_CELLS : MAX_FIXTURES;
+    checkpoint.fixture = record.fixture < targetCount ? record.fixture : 0;
+    checkpoint.side = record.side;
+    checkpoint.pass = record.pass;
+    checkpoint.pressurePotOn = true;
+    checkpoint.servoAngle = myServo.getCurrentAngle();
+    g_interCoatDelaySeconds = record.interCoatDelaySeconds;
+
+    progressJournal.continueJob(record);
+    jobStatus = JOB_PAUSED;
+    Serial.printf("PaintProgress: Restored job from journal (coat %d/%d, side %d, pass %d).\n",
+                  checkpoint.coat, checkpoint.totalCoats, checkpoint.side, checkpoint.pass + 1);
+    return true;
+}
+
+bool isPaintJobResuming() {
+    return jobStatus == JOB_RESUMING;
+}
+
+int paintJobResumeCoat() {
+    return isPaintJobResuming() ? checkpoint.coat : 1;
+}
+
+int paintJobTotalCoats() {
+    return jobTotalCoats;
+}
+
+PaintJobMode paintJobMode() {
+    return jobMode;
+}
+
+bool paintJobShouldSkipFixture(int fixture) {
+    return isPaintJobResuming() && fixture != checkpoint.fixture;
+}
+
+bool paintJobShouldSkipSide(int side) {
+    return isPaintJobResuming() && side != checkpoint.side;
+}
+
+int paintJobTakeResumePass(int side) {
+    if (!isPaintJobResuming() || side != checkpoint.side) {
+        return 0;
+    }
+    jobStatus = JOB_RUNNING;
+    return checkpoint.pass;
+}
+
+const PaintCheckpoint& paintJobCheckpoint() {
+    return checkpoint;
+}
+
+PaintJobPosition paintJobPosition() {
+    if (jobStatus == JOB_NONE) {
+        return {};
+    }
+    return {jobTotalCoats, jobCoat, jobFixture, jobSide, jobPass};
+}
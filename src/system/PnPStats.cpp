@@ -0,0 +1,77 @@
+#include "system/PnPStats.h"
+#include <algorithm>
+
+//* ************************************************************************
+//* ***************************** PNP STATS ********************************
+//* ************************************************************************
+
+static const char* const PHASE_NAMES[PNP_PHASE_COUNT] = {
+    "wait_sensor", "arrival_latency", "verify_move", "pick", "loaded_travel", "place", "return_travel"
+};
+
+struct PhaseStats {
+    uint32_t count;
+    uint32_t minUs;
+    uint32_t maxUs;
+    uint64_t sumUs;
+    uint32_t recent[PNP_STATS_WINDOW];  // Ring of the latest samples for p95
+    uint8_t next;
+};
+
+static PhaseStats phases[PNP_PHASE_COUNT];
+static uint32_t completedCycles = 0;
+
+void pnpStatsRecord(PnPPhase phase, unsigned long durationUs) {
+    if (phase < 0 || phase >= PNP_PHASE_COUNT) {
+        return;
+    }
+    PhaseStats& stats = phases[phase];
+    if (stats.count == 0 || durationUs < stats.minUs) stats.minUs = durationUs;
+    if (durationUs > stats.maxUs) stats.maxUs = durationUs;
+    stats.count++;
+    stats.sumUs += durationUs;
+    stats.recent[stats.next] = durationUs;
+    stats.next = (stats.next + 1) % PNP_STATS_WINDOW;
+}
+
+void pnpStatsCycleComplete() {
+    completedCycles++;
+}
+
+void pnpStatsReset() {
+    memset(phases, 0, sizeof(phases));
+    completedCycles = 0;
+}
+
+const char* pnpPhaseName(PnPPhase phase) {
+    return (phase >= 0 && phase < PNP_PHASE_COUNT) ? PHASE_NAMES[phase] : "unknown";
+}
+
+// 95th percentile of the samples in the ring (nearest rank)
+static uint32_t percentile95(const PhaseStats& stats) {
+    int n = stats.count < (uint32_t)PNP_STATS_WINDOW ? (int)stats.count : PNP_STATS_WINDOW;
+    if (n == 0) {
+        return 0;
+    }
+    uint32_t sorted[PNP_STATS_WINDOW];
+    memcpy(sorted, stats.recent, n * sizeof(uint32_t));
+    std::sort(sorted, sorted + n);
+    int rank = (95 * n + 99) / 100; // ceil(0.95 n)
+    return sorted[rank - 1];
+}
+
+void pnpStatsToJson(JsonDocument& doc) {
+    doc["event"] = "pnp_stats";
+    doc["cycles"] = completedCycles;
+    JsonArray list = doc["phases"].to<JsonArray>();
+    for (int i = 0; i < PNP_PHASE_COUNT; ++i) {
+        const PhaseStats& stats = phases[i];
+        JsonObject entry = list.add<JsonObject>();
+        entry["name"] = pnpPhaseName((PnPPhase)i);
+        entry["n"] = stats.count;
+        entry["min"] = stats.minUs / 1000.0f;
+        entry["avg"] = stats.count ? (float)(stats.sumUs / stats.count) / 1000.0f : 0.0f;
+        entry["max"] = stats.maxUs / 1000.0f;
+        entry["p95"] = percentile95(stats) / 1000.0f;
+    }
+}
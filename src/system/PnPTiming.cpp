@@ -0,0 +1,184 @@
+#include "system/PnPTiming.h"
+#include "utils/settings.h"
+#include "motors/MotionProfile.h"
+#include "storage/TrayLayouts.h"
+
+// PnP motion settings (defined in Web_Dashboard_Commands.cpp)
+extern float g_pnp_x_speed;
+extern float g_pnp_x_accel;
+extern float g_pnp_y_speed;
+extern float g_pnp_y_accel;
+extern float g_pnp_loaded_x_speed;
+extern float g_pnp_loaded_x_accel;
+extern float g_pnp_loaded_y_speed;
+extern float g_pnp_loaded_y_accel;
+
+//* ************************************************************************
+//* **************************** PNP TIMING ********************************
+//* ************************************************************************
+
+const unsigned long PNP_ACTUATION_MS =
+    PNP_PICK_DELAY_AFTER_CYLINDER_EXTEND + PNP_PICK_DELAY_AFTER_VACUUM_ON + PNP_PICK_DELAY_AFTER_CYLINDER_RETRACT +
+    PNP_PLACE_DELAY_AFTER_CYLINDER_EXTEND + PNP_PLACE_DELAY_AFTER_VACUUM_OFF + PNP_PLACE_DELAY_AFTER_CYLINDER_RETRACT;
+
+PnPMoveProfile pnpLoadedProfile() {
+    return {g_pnp_loaded_x_speed, g_pnp_loaded_x_accel, g_pnp_loaded_y_speed, g_pnp_loaded_y_accel};
+}
+
+PnPMoveProfile pnpUnloadedProfile() {
+    return {g_pnp_x_speed, g_pnp_x_accel, g_pnp_y_speed, g_pnp_y_accel};
+}
+
+float pnpPlaceMoveYSpeed(const PnPMoveProfile& loaded, bool finalPlacement) {
+    if (!finalPlacement) {
+        return loaded.ySpeed;
+    }
+    float speed = loaded.ySpeed / 2.0f;
+    return speed < 1.0f ? 1.0f : speed; // Safeguard against excessively slow speed
+}
+
+PnPPlaceTiming pnpPlanPlaceMove(long dx, long dy, const PnPMoveProfile& loaded, bool finalPlacement) {
+    MotionProfile xProfile = computeTrapezoid(dx, loaded.xSpeed, loaded.xAccel);
+    MotionProfile yProfile = computeTrapezoid(dy, pnpPlaceMoveYSpeed(loaded, finalPlacement), loaded.yAccel);
+    float travelTime = max(xProfile.totalTime, yProfile.totalTime);
+
+    PnPPlaceTiming timing = {};
+    timing.travelMs = (unsigned long)(travelTime * 1000.0f);
+    if (!PNP_OVERLAP_ENABLED || travelTime <= 0.0f) {
+        return timing;
+    }
+
+    // Pick: both axes start together, the first to cover the allowed distance limits the overlap
+    float retractOverlapSteps = PNP_PICK_RETRACT_OVERLAP_INCHES * STEPS_PER_INCH_XYZ;
+    float retractOverlap = travelTime;
+    if (xProfile.totalTime > 0.0f) retractOverlap = min(retractOverlap, profileTimeForEdgeDistance(xProfile, retractOverlapSteps));
+    if (yProfile.totalTime > 0.0f) retractOverlap = min(retractOverlap, profileTimeForEdgeDistance(yProfile, retractOverlapSteps));
+    timing.retractOverlapMs = min((unsigned long)(retractOverlap * 1000.0f), (unsigned long)PNP_PICK_DELAY_AFTER_CYLINDER_RETRACT);
+
+    // Place: an axis that arrives early has been still for (travelTime - its time)
+    float extendOverlapSteps = PNP_PLACE_EXTEND_OVERLAP_INCHES * STEPS_PER_INCH_XYZ;
+    float extendLead = travelTime;
+    if (xProfile.totalTime > 0.0f) extendLead = min(extendLead, travelTime - xProfile.totalTime + profileTimeForEdgeDistance(xProfile, extendOverlapSteps));
+    if (yProfile.totalTime > 0.0f) extendLead = min(extendLead, travelTime - yProfile.totalTime + profileTimeForEdgeDistance(yProfile, extendOverlapSteps));
+    timing.extendLeadMs = min((unsigned long)(extendLead * 1000.0f), (unsigned long)PNP_PLACE_DELAY_AFTER_CYLINDER_EXTEND);
+    return timing;
+}
+
+float pnpReturnTime(long dx, long dy, const PnPMoveProfile& unloaded) {
+    return max(computeTrapezoid(dx, unloaded.xSpeed, unloaded.xAccel).totalTime,
+               computeTrapezoid(dy, unloaded.ySpeed, unloaded.yAccel).totalTime);
+}
+
+// Travel time of one cycle for a cell: pick -> place with the loaded profile,
+// then back to pick with the unloaded profile.
+static float placementTravelTime(long dx, long dy, const PnPMoveProfile& loaded,
+                                 const PnPMoveProfile& unloaded, bool finalPlacement) {
+    return pnpPlanPlaceMove(dx, dy, loaded, finalPlacement).travelMs / 1000.0f + pnpReturnTime(dx, dy, unloaded);
+}
+
+// Every cycle starts and ends at the pick location, so the sum of normal
+// cycle times does not depend on the order; only the final placement (slow Y)
+// costs extra. The cell with the smallest slow-down penalty is moved to the
+// end, the others keep layout order.
+int pnpPlanPlacementOrder(long pickX, long pickY, const PnPMoveProfile& loaded,
+                          const PnPMoveProfile& unloaded, int* order, float& travelSeconds) {
+    int count = 0;
+    for (int cell = 0; cell < trayLayouts.cellCount(); ++cell) {
+        if (trayLayouts.isPlacementCell(cell)) {
+            order[count++] = cell;
+        }
+    }
+    travelSeconds = 0.0f;
+    if (count == 0) {
+        return 0;
+    }
+
+    int lastIndex = 0;
+    float bestPenalty = 0.0f;
+    for (int i = 0; i < count; ++i) {
+        long dx = trayLayouts.cellXSteps(order[i]) - pickX;
+        long dy = trayLayouts.cellYSteps(order[i]) - pickY;
+        float normal = placementTravelTime(dx, dy, loaded, unloaded, false);
+        float penalty = placementTravelTime(dx, dy, loaded, unloaded, true) - normal;
+        travelSeconds += normal;
+        if (i == 0 || penalty < bestPenalty) {
+            bestPenalty = penalty;
+            lastIndex = i;
+        }
+    }
+    travelSeconds += bestPenalty;
+
+    int lastCell = order[lastIndex];
+    for (int i = lastIndex; i < count - 1; ++i) {
+        order[i] = order[i + 1];
+    }
+    order[count - 1] = lastCell;
+    return count;
+}
+
+//* ************************************************************************
+//* ************************** PNP BENCHMARK *******************************
+//* ************************************************************************
+
+void pnpBenchmarkRun(const PnPBenchmarkConfig& config, PnPBenchmarkResult& result) {
+    result = {};
+    long pickX = (long)(PICK_LOCATION_X * STEPS_PER_INCH_XYZ);
+    long pickY = (long)(PICK_LOCATION_Y * STEPS_PER_INCH_XYZ);
+    int order[MAX_TRAY_CELLS];
+    float plannedTravel;
+    int count = pnpPlanPlacementOrder(pickX, pickY, config.loaded, config.unloaded, order, plannedTravel);
+
+    float now = 0.0f; // ms; the gantry is at the pick location
+    for (int i = 0; i < count; ++i) {
+        long dx = trayLayouts.cellXSteps(order[i]) - pickX;
+        long dy = trayLayouts.cellYSteps(order[i]) - pickY;
+        PnPPlaceTiming timing = pnpPlanPlaceMove(dx, dy, config.loaded, i + 1 == count);
+
+        // Scripted sensor: wait for the part, or pick one that arrived during the return move
+        float arrival = (float)i * config.partIntervalMs;
+        if (arrival > now) {
+            result.phaseMs[PNP_PHASE_WAIT_SENSOR] += arrival - now;
+            now = arrival;
+        } else if (config.partIntervalMs > 0) {
+            result.phaseMs[PNP_PHASE_ARRIVAL_LATENCY] += now - arrival;
+        }
+
+        // Already at the pick location, so the verify move takes no time
+        float pick = PNP_PICK_DELAY_AFTER_CYLINDER_EXTEND + PNP_PICK_DELAY_AFTER_VACUUM_ON + PNP_PICK_VACUUM_SETTLE_MS +
+                     PNP_PICK_DELAY_AFTER_CYLINDER_RETRACT - timing.retractOverlapMs;
+        float place = (PNP_PLACE_DELAY_AFTER_CYLINDER_EXTEND - timing.extendLeadMs) +
+                      PNP_PLACE_DELAY_AFTER_VACUUM_OFF + PNP_PLACE_DELAY_AFTER_CYLINDER_RETRACT;
+        float back = pnpReturnTime(dx, dy, config.unloaded) * 1000.0f;
+
+        result.phaseMs[PNP_PHASE_PICK] += pick;
+        result.phaseMs[PNP_PHASE_LOADED_TRAVEL] += timing.travelMs;
+        result.phaseMs[PNP_PHASE_PLACE] += place;
+        result.phaseMs[PNP_PHASE_RETURN_TRAVEL] += back;
+        now += pick + timing.travelMs + place + back;
+
+        result.travelXInches += 2.0f * labs(dx) / STEPS_PER_INCH_XYZ;
+        result.travelYInches += 2.0f * labs(dy) / STEPS_PER_INCH_XYZ;
+    }
+
+    result.parts = count;
+    result.totalMs = now;
+    result.partsPerHour = now > 0.0f ? count * 3600000.0f / now : 0.0f;
+}
+
+void pnpBenchmarkToJson(const PnPBenchmarkConfig& config, const PnPBenchmarkResult& result, JsonDocument& doc) {
+    doc["event"] = "pnp_benchmark";
+    doc["layout"] = trayLayouts.active().name;
+    doc["partIntervalMs"] = config.partIntervalMs;
+    doc["parts"] = result.parts;
+    doc["totalMs"] = result.totalMs;
+    doc["partsPerHour"] = result.partsPerHour;
+    doc["travelX"] = result.travelXInches;
+    doc["travelY"] = result.travelYInches;
+    JsonArray list = doc["phases"].to<JsonArray>();
+    for (int i = 0; i < PNP_PHASE_COUNT; ++i) {
+        JsonObject entry = list.add<JsonObject>();
+        entry["name"] = pnpPhaseName((PnPPhase)i);
+        entry["total"] = result.phaseMs[i];
+        entry["avg"] = result.parts ? result.phaseMs[i] / result.parts : 0.0f;
+    }
+}
@@ -0,0 +1,162 @@
+#include "system/RetainedPositions.h"
+#include <FastAccelStepper.h>
+#include <esp_attr.h>
+#include <esp_system.h>
+#include <esp_rom_crc.h>
+#include <atomic>
+#include "motors/Rotation_Motor.h"
+#include "system/StateMachine.h"
+
+extern FastAccelStepper *stepperX;
+extern FastAccelStepper *stepperY_Left;
+extern FastAccelStepper *stepperY_Right;
+extern FastAccelStepper *stepperZ;
+extern StateMachine* stateMachine;
+
+//* ************************************************************************
+//* *********************** RETAINED POSITIONS *****************************
+//* ************************************************************************
+
+struct RetainedPositionRecord {
+    uint32_t token;
+    int32_t x;
+    int32_t yLeft;
+    int32_t yRight;
+    int32_t z;
+    int32_t rotation;
+    uint32_t crc;
+};
+
+const uint32_t RETAINED_POSITIONS_TOKEN = 0x52504F53; // "RPOS"
+
+// Survives software resets; contents are garbage after power-on (token/CRC reject them)
+RTC_NOINIT_ATTR static RetainedPositionRecord rtcPositions;
+
+static bool axesReferenced = false;
+
+static uint32_t computeCrc(const RetainedPositionRecord& record) {
+    return esp_rom_crc32_le(0, (const uint8_t*)&record, offsetof(RetainedPositionRecord, crc));
+}
+
+void setAxesReferenced(bool referenced) {
+    axesReferenced = referenced;
+}
+
+bool areAxesReferenced() {
+    return axesReferenced;
+}
+
+void invalidateRetainedPositions() {
+    rtcPositions.token = 0;
+    rtcPositions.crc = 0;
+}
+
+bool retainPositionsForRestart() {
+    FastAccelStepper* axes[] = {stepperX, stepperY_Left, stepperY_Right, stepperZ, rotationStepper};
+    for (FastAccelStepper* axis : axes) {
+        if (!axis || axis->isRunning()) {
+            Serial.println("RetainedPositions: Axis missing or moving, positions not retained.");
+            invalidateRetainedPositions();
+            return false;
+        }
+    }
+    if (!axesReferenced) {
+        Serial.println("RetainedPositions: Axes not homed, positions not retained.");
+        invalidateRetainedPositions();
+        return false;
+    }
+
+    rtcPositions.token = RETAINED_POSITIONS_TOKEN;
+    rtcPositions.x = stepperX->getCurrentPosition();
+    rtcPositions.yLeft = stepperY_Left->getCurrentPosition();
+    rtcPositions.yRight = stepperY_Right->getCurrentPosition();
+    rtcPositions.z = stepperZ->getCurrentPosition();
+    rtcPositions.rotation = rotationStepper->getCurrentPosition();
+    rtcPositions.crc = computeCrc(rtcPositions);
+    Serial.printf("RetainedPositions: Retained X=%ld YL=%ld YR=%ld Z=%ld R=%ld for restart.\n",
+                  (long)rtcPositions.x, (long)rtcPositions.yLeft, (long)rtcPositions.yRight,
+                  (long)rtcPositions.z, (long)rtcPositions.rotation);
+    return true;
+}
+
+bool restoreRetainedPositions() {
+    RetainedPositionRecord record = rtcPositions;
+    invalidateRetainedPositions(); // One use only: a later crash must not reuse them
+
+    esp_reset_reason_t reason = esp_reset_reason();
+    if (reason != ESP_RST_SW) {
+        Serial.printf("RetainedPositions: Reset reason %d is not a software restart, homing required.\n", (int)reason);
+        return false;
+    }
+    if (record.token != RETAINED_POSITIONS_TOKEN || record.crc != computeCrc(record)) {
+        Serial.println("RetainedPositions: No valid retained positions, homing required.");
+        return false;
+    }
+    if (!stepperX || !stepperY_Left || !stepperY_Right || !stepperZ || !rotationStepper) {
+        Serial.println("RetainedPositions: Steppers not initialized, homing required.");
+        return false;
+    }
+
+    stepperX->setCurrentPosition(record.x);
+    stepperY_Left->setCurrentPosition(record.yLeft);
+    stepperY_Right->setCurrentPosition(record.yRight);
+    stepperZ->setCurrentPosition(record.z);
+    rotationStepper->setCurrentPosition(record.rotation);
+    axesReferenced = true;
+
+    Serial.printf("RetainedPositions: Restored X=%ld YL=%ld YR=%ld Z=%ld R=%ld, skipping homing.\n",
+                  (long)record.x, (long)record.yLeft, (long)record.yRight, (long)record.z, (long)record.rotation);
+    return true;
+}
+
+enum RestartHold : uint8_t {
+    HOLD_NONE = 0,
+    HOLD_REQUESTED, // Upload started, controller not yet checked
+    HOLD_IDLE,      // Controller was idle with all axes stopped and refuses commands since
+    HOLD_BUSY       // Controller was busy; positions will not be retained
+};
+
+static std::atomic<uint8_t> restartHold{HOLD_NONE};
+
+void restartHoldBegin() {
+    restartHold.store(HOLD_REQUESTED, std::memory_order_release);
+}
+
+void restartHoldUpdate() {
+    if (restartHold.load(std::memory_order_acquire) != HOLD_REQUESTED) {
+        return;
+    }
+    bool stopped = true;
+    FastAccelStepper* axes[] = {stepperX, stepperY_Left, stepperY_Right, stepperZ, rotationStepper};
+    for (FastAccelStepper* axis : axes) {
+        if (axis && axis->isRunning()) {
+            stopped = false;
+        }
+    }
+    bool idle = stateMachine && stateMachine->getCurrentStateId() == STATE_IDLE;
+    for (uint8_t id = 0; idle && id < STATE_COUNT; id++) {
+        idle = !stateMachine->isTransitionQueued((StateId)id); // Nothing about to leave Idle
+    }
+    uint8_t expected = HOLD_REQUESTED;
+    restartHold.compare_exchange_strong(expected, (idle && stopped) ? HOLD_IDLE : HOLD_BUSY);
+    Serial.println(idle && stopped ? "RetainedPositions: Controller held idle for the update."
+                                   : "RetainedPositions: Controller busy during the update, homing will be required.");
+}
+
+bool restartHoldActive() {
+    return restartHold.load(std::memory_order_acquire) != HOLD_NONE;
+}
+
+bool restartHoldRetain() {
+    if (restartHold.load(std::memory_order_acquire) != HOLD_IDLE) {
+        Serial.println("RetainedPositions: Controller was not held idle, positions not retained.");
+        invalidateRetainedPositions();
+        return false;
+    }
+    return retainPositionsForRestart();
+}
+
+void restartHoldCancel() {
+    restartHold.store(HOLD_NONE, std::memory_order_release);
+    invalidateRetainedPositions();
+}
@@ -1,14 +1,10 @@
 #include "system/StateMachine.h" // Updated path
-#include "states/IdleState.h"
-#include "states/HomingState.h"
-#include "states/PaintingState.h"
-#include "states/CleaningState.h"
-#include "states/PausedState.h"
-#include "states/PnPState.h"
 #include <Arduino.h>
 #include "system/machine_state.h" // Updated path
 #include "states/State.h"
 #include <WebSocketsServer.h> // Added WebSocket header
+#include "system/NetworkTask.h" // For webBroadcastTXT()
+#include "system/EventLoop.h" // Queued transitions are due at once
 
 //* ************************************************************************
 //* ************************* STATE MACHINE *******************************
@@ -21,164 +17,140 @@ StateMachine* stateMachine = nullptr;
 // Assuming it's defined in Setup.cpp or Web_Dashboard_Commands.cpp
 extern WebSocketsServer webSocket;
 
-// Flag to prevent circular state changes
-bool inStateTransition = false;
-
-StateMachine::StateMachine() : 
-    currentState(nullptr),
-    nextStateOverride(nullptr), // Initialize nextStateOverride
-    _isTransitioningToPaintAllSides(false) // Initialize the new flag
-    // Initialize state instances here if using composition
-    // homingState(), // Example - PnP was likely here
-    // paintingSide1State(), 
-    // ... etc.
+// Allowed transitions, TRANSITIONS[from][to]. HOME can interrupt anything;
+// a transition to the current state is a no-op and never reaches the table.
+static const bool TRANSITIONS[STATE_COUNT][STATE_COUNT] = {
+    //            IDLE   HOMING PAINT  CLEAN  PAUSED PNP
+    /* IDLE     */ {false, true,  false, true,  false, true },
+    /* HOMING   */ {true,  false, false, false, false, false},
+    /* PAINTING */ {true,  true,  false, true,  true,  false},
+    /* CLEANING */ {true,  true,  true,  false, false, false},
+    /* PAUSED   */ {false, true,  true,  false, false, false},
+    /* PNP      */ {true,  true,  false, false, false, false}
+};
+
+static const char* stateIdName(StateId id) {
+    static const char* const NAMES[STATE_COUNT] = {"IDLE", "HOMING", "PAINTING", "CLEANING", "PAUSED", "PNP"};
+    return id < STATE_COUNT ? NAMES[id] : "NONE";
+}
+
+StateMachine::StateMachine() :
+    currentState(&idleState),
+    currentId(STATE_IDLE),
+    entryTransition{STATE_NONE, STATE_IDLE, STATE_NONE, false},
+    pendingHead(0),
+    pendingCount(0)
 {
-    // Initialize all state objects
-    idleState = new IdleState();
-    homingState = new HomingState();
-    paintingState = new PaintingState();
-    cleaningState = new CleaningState();
-    pausedState = new PausedState();
-    pnpState = new PnPState();
-    
-    // Set initial state to idle
-    currentState = idleState;
-    currentState->enter();
-    
     // Set the global pointer
     stateMachine = this;
-    
+
+    // Set initial state to idle
+    currentState->enter();
+
     Serial.println("State Machine initialized with Idle state");
     // Initial state broadcast might be needed here if webSocket is ready
     // but it's safer to do it on connect in webSocketEvent
 }
 
-StateMachine::~StateMachine() {
-    // Clean up all state objects
-    delete idleState;
-    delete homingState;
-    delete paintingState;
-    delete cleaningState;
-    delete pausedState;
-    delete pnpState;
-    
-    // Clear the global pointer
-    stateMachine = nullptr;
+State* StateMachine::getState(StateId id) {
+    switch (id) {
+        case STATE_IDLE: return &idleState;
+        case STATE_HOMING: return &homingState;
+        case STATE_PAINTING: return &paintingState;
+        case STATE_CLEANING: return &cleaningState;
+        case STATE_PAUSED: return &pausedState;
+        case STATE_PNP: return &pnpState;
+        default: return nullptr;
+    }
 }
 
-void StateMachine::changeState(State* newState) {
-    if (newState == nullptr) {
+bool StateMachine::requestTransition(StateId to, StateId then, bool paintAllSides) {
+    if (to >= STATE_COUNT) {
         Serial.println("ERROR: Attempted to change to NULL state!");
+        return false;
+    }
+    StateTransition transition = {currentId, to, then, paintAllSides};
+
+    // Blocking code may ask for the same thing at every check (e.g. HOME)
+    for (uint8_t i = 0; i < pendingCount; i++) {
+        const StateTransition& queued = pending[(pendingHead + i) % STATE_TRANSITION_QUEUE_LENGTH];
+        if (queued.from == transition.from && queued.to == to && queued.then == then &&
+            queued.paintAllSides == paintAllSides) {
+            return true;
+        }
+    }
+    if (pendingCount >= STATE_TRANSITION_QUEUE_LENGTH) {
+        Serial.printf("ERROR: State transition queue full, %s -> %s dropped.\n",
+                      stateIdName(currentId), stateIdName(to));
+        return false;
+    }
+    pending[(pendingHead + pendingCount) % STATE_TRANSITION_QUEUE_LENGTH] = transition;
+    pendingCount++;
+    eventLoopWakeAt(millis()); // Apply on the next pass without sleeping
+    return true;
+}
+
+bool StateMachine::isTransitionQueued(StateId to) const {
+    for (uint8_t i = 0; i < pendingCount; i++) {
+        if (pending[(pendingHead + i) % STATE_TRANSITION_QUEUE_LENGTH].to == to) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void StateMachine::applyTransition(StateTransition transition) {
+    // Homing is the safety path and is allowed from every state: a HOME queued
+    // behind another transition still applies, checked against the state now
+    if (transition.to == STATE_HOMING) {
+        transition.from = currentId;
+    }
+    if (transition.from != currentId) {
+        Serial.printf("StateMachine: Stale transition %s -> %s dropped (now %s).\n",
+                      stateIdName(transition.from), stateIdName(transition.to), stateIdName(currentId));
         return;
     }
-    
-    // Use the new getName() method
-    const char* newStateName = newState->getName();
-    
-    // Check if already in the target state
-    if (currentState == newState) {
+    if (transition.to == currentId) {
         Serial.print("INFO: Already in state: ");
-        Serial.println(newStateName);
+        Serial.println(stateIdName(currentId));
         return;
     }
-
-    // Set flag to prevent circular state changes
-    inStateTransition = true;
-    
-    if (currentState != nullptr) {
-        Serial.print("Changing state from ");
-        Serial.print(currentState->getName()); // Use getName here too
-        Serial.print(" to ");
-        Serial.println(newStateName);
-        currentState->exit();
+    if (!TRANSITIONS[currentId][transition.to]) {
+        Serial.printf("StateMachine: Transition %s -> %s rejected.\n",
+                      stateIdName(currentId), stateIdName(transition.to));
+        webBroadcastTXT(String("STATE_REJECTED:") + stateIdName(currentId) + "," + stateIdName(transition.to));
+        return;
     }
-    
-    currentState = newState;
-    currentState->enter();
 
-    // --- Broadcast state change --- 
+    Serial.print("Changing state from ");
+    Serial.print(currentState->getName());
+    Serial.print(" to ");
+    Serial.println(stateIdName(transition.to));
+    currentState->exit();
+
+    currentId = transition.to;
+    currentState = getState(transition.to);
+    entryTransition = transition;
+    currentState->enter(); // May queue further transitions, applied after this one
+
+    // --- Broadcast state change ---
     String stateMessage = "STATE:";
-    stateMessage += newStateName;
-    webSocket.broadcastTXT(stateMessage);
+    stateMessage += currentState->getName();
+    webBroadcastTXT(stateMessage);
     Serial.print("Broadcasted state: ");
     Serial.println(stateMessage);
     // ----------------------------
-    
-    // Clear flag
-    inStateTransition = false;
 }
 
 void StateMachine::update() {
-    // Update current state
-    if (currentState != nullptr) {
-        currentState->update();
-    }
-}
-
-// --- nextStateOverride Methods ---
-void StateMachine::setNextStateOverride(State* state) {
-    nextStateOverride = state;
-    if (state) {
-        Serial.printf("StateMachine: Next state override set to: %s\n", state->getName());
-    } else {
-        Serial.println("StateMachine: Next state override cleared.");
-    }
-}
-
-State* StateMachine::getNextStateOverrideAndClear() {
-    State* temp = nextStateOverride;
-    if (temp) {
-        Serial.printf("StateMachine: Consuming next state override: %s\n", temp->getName());
-    }
-    nextStateOverride = nullptr;
-    return temp;
-}
-// --------------------------------
-
-// --- Paint All Sides Transition Flag Methods ---
-void StateMachine::setTransitioningToPaintAllSides(bool value) {
-    _isTransitioningToPaintAllSides = value;
-    if (value) {
-        Serial.println("StateMachine: Flag set - transitioning to Paint All Sides sequence.");
-    } else {
-        Serial.println("StateMachine: Flag cleared - no longer transitioning to Paint All Sides sequence.");
+    // Apply queued transitions first; bounded so two states cannot ping-pong forever
+    for (int applied = 0; pendingCount > 0 && applied < STATE_TRANSITION_QUEUE_LENGTH; applied++) {
+        StateTransition transition = pending[pendingHead];
+        pendingHead = (pendingHead + 1) % STATE_TRANSITION_QUEUE_LENGTH;
+        pendingCount--;
+        applyTransition(transition);
     }
-}
 
-bool StateMachine::isTransitioningToPaintAllSides() const {
-    return _isTransitioningToPaintAllSides;
-}
-
-void StateMachine::clearTransitioningToPaintAllSidesFlag() {
-    if (_isTransitioningToPaintAllSides) {
-        Serial.println("StateMachine: Paint All Sides transition flag explicitly cleared.");
-    }
-    _isTransitioningToPaintAllSides = false;
-}
-// ---------------------------------------------
-
-// Helper function to get state name (now uses the virtual method)
-const char* StateMachine::getStateName(State* state) {
-    if (state != nullptr) {
-        return state->getName();
-    } else {
-        return "Unknown";
-    }
+    // Update current state
+    currentState->update();
 }
-
-/* // REMOVING this duplicate/incorrect initialize() definition
-void StateMachine::initialize() {
-    Serial.println("Initializing State Machine...");
-    // Initialize state instances - Ensure PnP is removed if it was here
-    // pnpState = new PnPState(); // Example - REMOVED
-
-    // Set the initial state
-    currentState = getHomingState(); // Start with homing or idle
-    if (currentState != nullptr) {
-        currentState->enter();
-    } else {
-        Serial.println("ERROR: Initial state is null!");
-        // Handle error appropriately, maybe enter an error state
-    }
-} 
-*/ 
\ No newline at end of file
@@ -0,0 +1,277 @@
+#include "system/Supervisor.h"
+#include <atomic>
+#include <esp_attr.h>
+#include <esp_system.h>
+#include <esp_rom_crc.h>
+#include <esp_task_wdt.h>
+#include "utils/settings.h"
+#include "system/StateMachine.h"
+#include "system/Telemetry.h"
+#include "system/NetworkTask.h"
+#include "system/Logger.h"
+#include <FastAccelStepper.h>
+#include "motors/Rotation_Motor.h"
+
+extern StateMachine* stateMachine;
+extern FastAccelStepper *stepperX;
+extern FastAccelStepper *stepperY_Left;
+extern FastAccelStepper *stepperY_Right;
+extern FastAccelStepper *stepperZ;
+
+//* ************************************************************************
+//* **************************** SUPERVISOR ********************************
+//* ************************************************************************
+
+struct StallRecord {
+    uint32_t token;
+    char segment[24];     // Segment (or "loop") the controller was stuck in
+    char state[16];
+    uint32_t elapsedMs;   // Time in the segment, or since the last progress
+    uint32_t uptimeMs;
+    uint32_t crc;
+};
+
+const uint32_t STALL_RECORD_TOKEN = 0x53544C4C; // "STLL"
+
+// Survives the watchdog reset; contents are garbage after power-on (token/CRC reject them)
+RTC_NOINIT_ATTR static StallRecord rtcStall;
+
+static StallRecord lastStall;      // Stall reported at boot, for the dashboard
+static bool lastStallValid = false;
+
+struct Segment {
+    const char* name;
+    unsigned long startMs;
+    unsigned long budgetMs;
+};
+
+// Written by the controller, read by the network task
+static portMUX_TYPE segmentMux = portMUX_INITIALIZER_UNLOCKED;
+static Segment segments[SUPERVISOR_SEGMENT_DEPTH];
+static uint8_t segmentDepth = 0; // May exceed SUPERVISOR_SEGMENT_DEPTH; deeper segments are not timed
+static std::atomic<unsigned long> lastProgressMs{0};
+
+// Loop statistics, controller only
+static unsigned long loopStartUs = 0;
+static uint32_t loopHistogram[SUPERVISOR_HISTOGRAM_BUCKETS];
+static uint32_t loopPasses = 0;
+static uint32_t loopOverruns = 0;
+static unsigned long loopMaxUs = 0;
+static unsigned long lastLoopOverrunMs = 0;
+static const char* lastLoopOverrunState = "";
+static uint32_t segmentOverruns = 0;
+static const char* lastSegmentOverrun = "";
+static unsigned long lastSegmentOverrunMs = 0;
+static unsigned long lastSegmentBudgetMs = 0;
+
+// Network task only
+static bool watchdogArmed = false;
+static bool stalled = false;
+
+static uint32_t computeCrc(const StallRecord& record) {
+    return esp_rom_crc32_le(0, (const uint8_t*)&record, offsetof(StallRecord, crc));
+}
+
+static const char* currentStateName() {
+    return (stateMachine && stateMachine->getCurrentState()) ? stateMachine->getCurrentState()->getName() : "UNKNOWN";
+}
+
+void supervisorBegin() {
+    StallRecord record = rtcStall;
+    rtcStall.token = 0;
+    rtcStall.crc = 0;
+    if (record.token == STALL_RECORD_TOKEN && record.crc == computeCrc(record)) {
+        lastStall = record;
+        lastStallValid = true;
+        Serial.printf("SUPERVISOR: Last reset was a controller stall in %s (state %s, %lu ms, uptime %lu ms).\n",
+                      record.segment, record.state, (unsigned long)record.elapsedMs, (unsigned long)record.uptimeMs);
+    }
+    lastProgressMs.store(millis(), std::memory_order_relaxed);
+}
+
+void supervisorLoopBegin() {
+    loopStartUs = micros();
+}
+
+void supervisorLoopEnd() {
+    unsigned long elapsedUs = micros() - loopStartUs;
+    unsigned long elapsedMs = elapsedUs / 1000;
+    uint8_t bucket = 0;
+    while (bucket < SUPERVISOR_HISTOGRAM_BUCKETS - 1 && elapsedMs >= (1UL << bucket)) {
+        bucket++;
+    }
+    loopHistogram[bucket]++;
+    loopPasses++;
+    if (elapsedUs > loopMaxUs) {
+        loopMaxUs = elapsedUs;
+    }
+    if (elapsedMs > SUPERVISOR_LOOP_BUDGET_MS) {
+        loopOverruns++;
+        lastLoopOverrunMs = elapsedMs;
+        lastLoopOverrunState = currentStateName();
+    }
+    supervisorFeed();
+}
+
+void supervisorSegmentBegin(const char* name, unsigned long budgetMs) {
+    portENTER_CRITICAL(&segmentMux);
+    if (segmentDepth < SUPERVISOR_SEGMENT_DEPTH) {
+        segments[segmentDepth] = {name, millis(), budgetMs};
+    }
+    segmentDepth++;
+    portEXIT_CRITICAL(&segmentMux);
+    supervisorFeed();
+}
+
+void supervisorSegmentEnd() {
+    Segment segment = {nullptr, 0, 0};
+    portENTER_CRITICAL(&segmentMux);
+    if (segmentDepth > 0) {
+        segmentDepth--;
+        if (segmentDepth < SUPERVISOR_SEGMENT_DEPTH) {
+            segment = segments[segmentDepth];
+        }
+    }
+    portEXIT_CRITICAL(&segmentMux);
+    supervisorFeed();
+
+    if (!segment.name) {
+        return;
+    }
+    unsigned long elapsedMs = millis() - segment.startMs;
+    if (elapsedMs > segment.budgetMs) {
+        segmentOverruns++;
+        lastSegmentOverrun = segment.name;
+        lastSegmentOverrunMs = elapsedMs;
+        lastSegmentBudgetMs = segment.budgetMs;
+        logWarn("SUPERVISOR: Segment %s took %lu ms (budget %lu ms).", segment.name, elapsedMs, segment.budgetMs);
+    }
+}
+
+unsigned long supervisorMoveBudgetMs(long steps, unsigned int speedHz) {
+    unsigned long cruiseMs = speedHz > 0 ? (unsigned long)(labs(steps) * 1000UL / speedHz) : 0;
+    return cruiseMs * SUPERVISOR_MOVE_BUDGET_FACTOR + SUPERVISOR_MOVE_MARGIN_MS;
+}
+
+void supervisorFeed() {
+    lastProgressMs.store(millis(), std::memory_order_relaxed);
+}
+
+void supervisorWatchdogBegin() {
+    // Reconfigures the watchdog the core already started (idle tasks stay subscribed)
+    if (esp_task_wdt_init(SUPERVISOR_WDT_TIMEOUT_S, true) != ESP_OK || esp_task_wdt_add(NULL) != ESP_OK) {
+        Serial.println("ERROR: Supervisor could not subscribe to the task watchdog!");
+        return;
+    }
+    watchdogArmed = true;
+    Serial.printf("Supervisor: Task watchdog armed (%d s).\n", SUPERVISOR_WDT_TIMEOUT_S);
+}
+
+static void stopOnStall(const char* where, unsigned long elapsedMs) {
+    stalled = true;
+
+    // Outputs first; GPIO writes are safe from this core while the controller is stuck
+    digitalWrite(PAINT_GUN_PIN, LOW);
+    digitalWrite(PRESSURE_POT_PIN, LOW);
+
+    // Then every axis, before the watchdog is starved: the stuck controller
+    // cannot ramp them down, and the reset is up to SUPERVISOR_WDT_TIMEOUT_S away
+    FastAccelStepper* axes[] = {stepperX, stepperY_Left, stepperY_Right, stepperZ, rotationStepper};
+    for (FastAccelStepper* axis : axes) {
+        if (axis) {
+            axis->forceStop();
+        }
+    }
+
+    Telemetry telemetry;
+    StallRecord record = {};
+    record.token = STALL_RECORD_TOKEN;
+    strncpy(record.segment, where, sizeof(record.segment) - 1);
+    strncpy(record.state, telemetryRead(telemetry) ? telemetry.state : "UNKNOWN", sizeof(record.state) - 1);
+    record.elapsedMs = elapsedMs;
+    record.uptimeMs = millis();
+    record.crc = computeCrc(record);
+    rtcStall = record;
+
+    Serial.printf("SUPERVISOR: Controller stalled in %s (state %s) for %lu ms. Paint off, axes stopped.\n",
+                  record.segment, record.state, elapsedMs);
+    webBroadcastTXT(String("STALL:") + record.segment + "," + record.state + "," + elapsedMs);
+    if (!watchdogArmed) {
+        ESP.restart(); // No watchdog to do it
+    }
+    // Otherwise the watchdog is no longer fed and its panic reset restarts the controller
+}
+
+void supervisorCheck() {
+    if (stalled) {
+        return;
+    }
+
+    // Controller state first, then the clock, so the elapsed times cannot go negative
+    Segment segment = {nullptr, 0, 0};
+    portENTER_CRITICAL(&segmentMux);
+    if (segmentDepth > 0) {
+        segment = segments[min((int)segmentDepth, SUPERVISOR_SEGMENT_DEPTH) - 1];
+    }
+    portEXIT_CRITICAL(&segmentMux);
+    unsigned long progressMs = lastProgressMs.load(std::memory_order_relaxed);
+    unsigned long now = millis();
+
+    // A segment is bounded by its budget; outside one, loop passes must keep completing
+    if (segment.name) {
+        if (now - segment.startMs > segment.budgetMs + SUPERVISOR_STALL_MS) {
+            stopOnStall(segment.name, now - segment.startMs);
+            return;
+        }
+    } else if (now - progressMs > SUPERVISOR_STALL_MS) {
+        stopOnStall("loop", now - progressMs);
+        return;
+    }
+
+    if (watchdogArmed) {
+        esp_task_wdt_reset();
+    }
+}
+
+void supervisorToJson(JsonDocument& doc) {
+    doc["event"] = "supervisor";
+    JsonObject loop = doc["loop"].to<JsonObject>();
+    loop["passes"] = loopPasses;
+    loop["budgetMs"] = SUPERVISOR_LOOP_BUDGET_MS;
+    loop["overruns"] = loopOverruns;
+    loop["maxMs"] = loopMaxUs / 1000.0f;
+    if (loopOverruns > 0) {
+        loop["lastOverrunMs"] = lastLoopOverrunMs;
+        loop["lastOverrunState"] = lastLoopOverrunState;
+    }
+    // Bucket i counts passes shorter than 2^i ms; the last bucket is open-ended
+    JsonArray histogram = loop["histogram"].to<JsonArray>();
+    for (int i = 0; i < SUPERVISOR_HISTOGRAM_BUCKETS; i++) {
+        histogram.add(loopHistogram[i]);
+    }
+
+    JsonObject segmentsJson = doc["segments"].to<JsonObject>();
+    segmentsJson["overruns"] = segmentOverruns;
+    if (segmentOverruns > 0) {
+        segmentsJson["lastOverrun"] = lastSegmentOverrun;
+        segmentsJson["lastOverrunMs"] = lastSegmentOverrunMs;
+        segmentsJson["lastBudgetMs"] = lastSegmentBudgetMs;
+    }
+
+    if (lastStallValid) {
+        JsonObject stall = doc["lastStall"].to<JsonObject>();
+        stall["segment"] = lastStall.segment;
+        stall["state"] = lastStall.state;
+        stall["elapsedMs"] = lastStall.elapsedMs;
+        stall["uptimeMs"] = lastStall.uptimeMs;
+    }
+}
+
+void supervisorReset() {
+    memset(loopHistogram, 0, sizeof(loopHistogram));
+    loopPasses = 0;
+    loopOverruns = 0;
+    loopMaxUs = 0;
+    segmentOverruns = 0;
+    lastStallValid = false;
+}
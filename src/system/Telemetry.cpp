@@ -0,0 +1,119 @@
+#include "system/Telemetry.h"
+#include <atomic>
+#include <FastAccelStepper.h>
+#include "utils/settings.h"
+#include "system/StateMachine.h"
+#include "system/PaintProgress.h"
+#include "storage/ProgressJournal.h"
+#include "motors/Rotation_Motor.h"
+#include "system/EventLoop.h"
+
+extern FastAccelStepper *stepperX;
+extern FastAccelStepper *stepperY_Left;
+extern FastAccelStepper *stepperY_Right;
+extern FastAccelStepper *stepperZ;
+extern StateMachine* stateMachine;
+extern bool isPaintGun_ON;
+extern bool isPressurePot_ON;
+extern bool isVacuum_ON;
+extern bool isCylinder_DOWN;
+
+//* ************************************************************************
+//* **************************** TELEMETRY *********************************
+//* ************************************************************************
+
+static Telemetry snapshot;
+static std::atomic<uint32_t> sequence{0}; // Odd while the snapshot is being written
+static unsigned long lastPublishMs = 0;
+
+static void capture(Telemetry& t) {
+    t.timeMs = millis();
+    t.xSteps = stepperX ? stepperX->getCurrentPosition() : 0;
+    t.yLeftSteps = stepperY_Left ? stepperY_Left->getCurrentPosition() : 0;
+    t.yRightSteps = stepperY_Right ? stepperY_Right->getCurrentPosition() : 0;
+    t.zSteps = stepperZ ? stepperZ->getCurrentPosition() : 0;
+    t.rotationSteps = rotationStepper ? rotationStepper->getCurrentPosition() : 0;
+    t.rotationAngle = t.rotationSteps / STEPS_PER_DEGREE;
+    t.paintGunOn = isPaintGun_ON;
+    t.pressurePotOn = isPressurePot_ON;
+    t.vacuumOn = isVacuum_ON;
+    t.cylinderDown = isCylinder_DOWN;
+    t.jobRunning = isPaintJobRunning();
+    t.jobPaused = isPaintJobPaused();
+    PaintJobPosition job = paintJobPosition();
+    t.jobCoat = job.coat;
+    t.jobTotalCoats = job.totalCoats;
+    t.jobFixture = job.fixture;
+    t.jobSide = job.side;
+    t.jobPass = job.pass;
+    t.resumeAvailable = progressJournal.hasResumableJob();
+    const JournalRecord& resume = progressJournal.resumableJob();
+    t.resumeCoat = t.resumeAvailable ? resume.coat : 0;
+    t.resumeTotalCoats = t.resumeAvailable ? resume.totalCoats : 0;
+    t.resumeSide = t.resumeAvailable ? resume.side : 0;
+    t.resumePass = t.resumeAvailable ? resume.pass : 0;
+    const char* name = (stateMachine && stateMachine->getCurrentState()) ? stateMachine->getCurrentState()->getName() : "UNKNOWN";
+    strncpy(t.state, name, sizeof(t.state) - 1);
+    t.state[sizeof(t.state) - 1] = '\0';
+}
+
+void telemetryUpdate() {
+    unsigned long now = millis();
+    if (sequence.load(std::memory_order_relaxed) != 0 && now - lastPublishMs < TELEMETRY_PERIOD_MS) {
+        eventLoopWakeAt(lastPublishMs + TELEMETRY_PERIOD_MS);
+        return;
+    }
+    lastPublishMs = now;
+    eventLoopWakeAt(now + TELEMETRY_PERIOD_MS);
+
+    // Driver reads happen outside the write window to keep it short
+    Telemetry next;
+    capture(next);
+
+    uint32_t seq = sequence.load(std::memory_order_relaxed);
+    sequence.store(seq + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    memcpy(&snapshot, &next, sizeof(snapshot));
+    sequence.store(seq + 2, std::memory_order_release);
+}
+
+bool telemetryRead(Telemetry& out) {
+    for (;;) {
+        uint32_t before = sequence.load(std::memory_order_acquire);
+        if (before == 0) {
+            return false;
+        }
+        if (before & 1) {
+            continue; // Write in progress on the other core
+        }
+        memcpy(&out, &snapshot, sizeof(out));
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (sequence.load(std::memory_order_relaxed) == before) {
+            return true;
+        }
+    }
+}
+
+void telemetryToJson(const Telemetry& telemetry, JsonDocument& doc) {
+    doc["event"] = "telemetry";
+    doc["t"] = telemetry.timeMs;
+    doc["state"] = telemetry.state;
+    doc["x"] = telemetry.xSteps / STEPS_PER_INCH_XYZ;
+    doc["y"] = telemetry.yLeftSteps / STEPS_PER_INCH_XYZ;
+    doc["yRight"] = telemetry.yRightSteps / STEPS_PER_INCH_XYZ;
+    doc["z"] = telemetry.zSteps / STEPS_PER_INCH_XYZ;
+    doc["angle"] = telemetry.rotationAngle;
+    doc["gun"] = telemetry.paintGunOn;
+    doc["pot"] = telemetry.pressurePotOn;
+    doc["vacuum"] = telemetry.vacuumOn;
+    doc["cylinder"] = telemetry.cylinderDown;
+    if (telemetry.jobRunning || telemetry.jobPaused) {
+        JsonObject job = doc["job"].to<JsonObject>();
+        job["paused"] = telemetry.jobPaused;
+        job["coat"] = telemetry.jobCoat;
+        job["coats"] = telemetry.jobTotalCoats;
+        job["fixture"] = telemetry.jobFixture;
+        job["side"] = telemetry.jobSide;
+        job["pass"] = telemetry.jobPass;
+    }
+}
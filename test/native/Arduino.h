@@ -0,0 +1,124 @@
+#ifndef ARDUINO_H
+#define ARDUINO_H
+
+//* ************************************************************************
+//* ************************* HOST ARDUINO CORE ****************************
+//* ************************************************************************
+// Just enough of the Arduino core to build the PnP sources on the host
+// (env:native). millis()/micros() read the simulation clock, so time only
+// moves when a test advances it (see Simulation.h). Serial output is
+// discarded unless the test turns echo on.
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdarg.h>
+#include <string.h>
+#include <math.h>
+#include <string>
+#include <algorithm>
+
+using std::min;
+using std::max;
+
+#define HIGH 1
+#define LOW 0
+#define INPUT 0
+#define OUTPUT 1
+#define INPUT_PULLUP 2
+#define IRAM_ATTR
+
+typedef uint8_t byte;
+typedef bool boolean;
+
+class String {
+public:
+    String() {}
+    String(const char* text) : value(text ? text : "") {}
+    String(const std::string& text) : value(text) {}
+    String(char c) : value(1, c) {}
+    String(int number) : value(std::to_string(number)) {}
+    String(unsigned int number) : value(std::to_string(number)) {}
+    String(long number) : value(std::to_string(number)) {}
+    String(unsigned long number) : value(std::to_string(number)) {}
+    String(float number, unsigned int decimals = 2) { format((double)number, decimals); }
+    String(double number, unsigned int decimals = 2) { format(number, decimals); }
+
+    String& operator=(const char* text) {
+        value = text ? text : "";
+        return *this;
+    }
+
+    const char* c_str() const { return value.c_str(); }
+    unsigned int length() const { return (unsigned int)value.length(); }
+    bool concat(const char* text) {
+        value += text ? text : "";
+        return true;
+    }
+    bool concat(const String& text) {
+        value += text.value;
+        return true;
+    }
+    char operator[](unsigned int index) const { return index < value.length() ? value[index] : 0; }
+
+    String& operator+=(const String& text) {
+        value += text.value;
+        return *this;
+    }
+    bool operator==(const String& other) const { return value == other.value; }
+    bool operator!=(const String& other) const { return value != other.value; }
+    bool startsWith(const String& prefix) const { return value.compare(0, prefix.value.length(), prefix.value) == 0; }
+
+    friend String operator+(const String& a, const String& b) { return String(a.value + b.value); }
+
+private:
+    void format(double number, unsigned int decimals) {
+        char buffer[48];
+        snprintf(buffer, sizeof(buffer), "%.*f", (int)decimals, number);
+        value = buffer;
+    }
+
+    std::string value;
+};
+
+class HardwareSerial {
+public:
+    bool echo = false;
+
+    void begin(unsigned long) {}
+    void print(const String& text) { write(text.c_str()); }
+    void print(const char* text) { write(text); }
+    void print(long number) { print(String(number)); }
+    void println(const String& text) { write(text.c_str()); write("\n"); }
+    void println(const char* text = "") { write(text); write("\n"); }
+    void println(long number) { println(String(number)); }
+    int printf(const char* format, ...) __attribute__((format(printf, 2, 3))) {
+        if (!echo) {
+            return 0;
+        }
+        va_list args;
+        va_start(args, format);
+        int written = vprintf(format, args);
+        va_end(args);
+        return written;
+    }
+
+private:
+    void write(const char* text) {
+        if (echo) {
+            fputs(text, stdout);
+        }
+    }
+};
+
+extern HardwareSerial Serial;
+
+unsigned long millis();
+unsigned long micros();
+void delay(unsigned long ms);   // Advances the simulation clock
+void pinMode(uint8_t pin, uint8_t mode);
+void digitalWrite(uint8_t pin, uint8_t value);
+int digitalRead(uint8_t pin);
+
+#endif // ARDUINO_H
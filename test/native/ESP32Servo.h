@@ -0,0 +1,12 @@
+#ifndef ESP32_SERVO_H
+#define ESP32_SERVO_H
+
+// Host stand-in: the PnP cycle does not drive the servo
+class Servo {
+public:
+    void setPeriodHertz(int) {}
+    int attach(int, int = 0, int = 0) { return 0; }
+    void write(int) {}
+};
+
+#endif // ESP32_SERVO_H
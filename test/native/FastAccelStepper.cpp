@@ -0,0 +1,110 @@
+#include <FastAccelStepper.h>
+#include <math.h>
+
+//* ************************************************************************
+//* *********************** SIMULATED STEPPER ******************************
+//* ************************************************************************
+
+int8_t FastAccelStepper::setSpeedInHz(uint32_t speedHz) {
+    if (speedHz == 0) {
+        return -1;
+    }
+    maxSpeed = speedHz;
+    return 0;
+}
+
+int8_t FastAccelStepper::setAcceleration(int32_t acceleration) {
+    if (acceleration <= 0) {
+        return -1;
+    }
+    accel = acceleration;
+    return 0;
+}
+
+MoveResultCode FastAccelStepper::moveTo(int32_t position, bool) {
+    target = position;
+    stopping = false;
+    if (!running && position != getCurrentPosition()) {
+        running = true;
+    }
+    return MOVE_OK;
+}
+
+MoveResultCode FastAccelStepper::move(int32_t steps, bool blocking) {
+    return moveTo(target + steps, blocking);
+}
+
+void FastAccelStepper::stopMove() {
+    if (running) {
+        stopping = true;
+    }
+}
+
+void FastAccelStepper::forceStop() {
+    velocity = 0.0;
+    running = false;
+    stopping = false;
+    target = getCurrentPosition();
+}
+
+void FastAccelStepper::forceStopAndNewPosition(int32_t newPosition) {
+    forceStop();
+    setCurrentPosition(newPosition);
+}
+
+void FastAccelStepper::setCurrentPosition(int32_t newPosition) {
+    position = newPosition;
+    target = newPosition;
+}
+
+int32_t FastAccelStepper::getCurrentPosition() const {
+    return (int32_t)lround(position);
+}
+
+void FastAccelStepper::simStep(double dt) {
+    if (!running) {
+        return;
+    }
+    double speed = fabs(velocity);
+    double heading = velocity >= 0.0 ? 1.0 : -1.0;
+
+    if (stopping) {
+        speed = fmax(0.0, speed - accel * dt);
+        position += heading * speed * dt;
+        velocity = heading * speed;
+        if (speed == 0.0) {
+            forceStop();
+        }
+        return;
+    }
+
+    double remaining = target - position;
+    double direction = remaining >= 0.0 ? 1.0 : -1.0;
+    double distance = fabs(remaining);
+    if (speed > 0.0 && heading != direction) {
+        // Moving away from a new target: brake first
+        speed = fmax(0.0, speed - accel * dt);
+        position += heading * speed * dt;
+        velocity = heading * speed;
+        return;
+    }
+
+    // Brake when the stopping distance (plus this tick) reaches the target,
+    // at the rate that stops on it; never slower than one start step per tick
+    if (distance <= speed * speed / (2.0 * accel) + speed * dt) {
+        double brake = fmin(speed * speed / (2.0 * distance), 4.0 * accel);
+        speed = fmax(accel * dt, speed - brake * dt);
+    } else {
+        speed = speed < maxSpeed ? fmin(maxSpeed, speed + accel * dt) : fmax(maxSpeed, speed - accel * dt);
+    }
+
+    double step = speed * dt;
+    if (step >= distance) {
+        position = target;
+        velocity = 0.0;
+        running = false;
+        return;
+    }
+    position += direction * step;
+    velocity = direction * speed;
+}
@@ -0,0 +1,54 @@
+#ifndef FAST_ACCEL_STEPPER_H
+#define FAST_ACCEL_STEPPER_H
+
+#include <stdint.h>
+
+//* ************************************************************************
+//* *********************** SIMULATED STEPPER ******************************
+//* ************************************************************************
+// Host stand-in for FastAccelStepper. Each axis integrates its own motion in
+// simStep(): accelerate at the set acceleration up to the set speed, start
+// braking once the remaining distance is within the stopping distance, and
+// snap onto the target when it is reached. It deliberately does not use the
+// trapezoid model in MotionProfile, so the firmware's timing predictions are
+// checked against independent motion.
+
+enum MoveResultCode : int8_t {
+    MOVE_OK = 0
+};
+
+class FastAccelStepper {
+public:
+    int8_t setSpeedInHz(uint32_t speedHz);
+    int8_t setAcceleration(int32_t accel);
+    MoveResultCode moveTo(int32_t position, bool blocking = false);
+    MoveResultCode move(int32_t steps, bool blocking = false);
+    void stopMove();                                // Ramps down at the set acceleration
+    void forceStop();
+    void forceStopAndNewPosition(int32_t position);
+    void setCurrentPosition(int32_t position);
+
+    bool isRunning() const { return running; }
+    int32_t getCurrentPosition() const;
+    int32_t targetPos() const { return target; }
+    uint32_t getMaxSpeedInHz() const { return (uint32_t)maxSpeed; }
+
+    // Simulation only: advance the motion by 'dt' seconds
+    void simStep(double dt);
+
+private:
+    double position = 0.0;   // Steps
+    double velocity = 0.0;   // Steps/s, signed
+    double maxSpeed = 1000.0;
+    double accel = 1000.0;
+    int32_t target = 0;
+    bool running = false;
+    bool stopping = false;
+};
+
+class FastAccelStepperEngine {
+public:
+    void init() {}
+};
+
+#endif // FAST_ACCEL_STEPPER_H
@@ -0,0 +1,107 @@
+#include <Arduino.h>
+#include "Simulation.h"
+#include "utils/settings.h"
+#include "system/StateMachine.h"
+#include "system/NetworkTask.h"
+#include "system/EventLoop.h"
+
+//* ************************************************************************
+//* ************************* FIRMWARE DOUBLES *****************************
+//* ************************************************************************
+// Stand-ins for the parts of the firmware the PnP cycle talks to but the
+// native tests do not exercise. The real StateMachine runs the real
+// PnPState; the other states only report their name, so a test can see
+// where the cycle hands over (e.g. Homing at the end of a tray).
+
+// PnP motion settings (Web_Dashboard_Commands.cpp on the controller)
+float g_pnp_x_speed = DEFAULT_PNP_X_SPEED;
+float g_pnp_x_accel = DEFAULT_PNP_X_ACCEL;
+float g_pnp_y_speed = DEFAULT_PNP_Y_SPEED;
+float g_pnp_y_accel = DEFAULT_PNP_Y_ACCEL;
+float g_pnp_loaded_x_speed = DEFAULT_PNP_LOADED_X_SPEED;
+float g_pnp_loaded_x_accel = DEFAULT_PNP_LOADED_X_ACCEL;
+float g_pnp_loaded_y_speed = DEFAULT_PNP_LOADED_Y_SPEED;
+float g_pnp_loaded_y_accel = DEFAULT_PNP_LOADED_Y_ACCEL;
+
+void webBroadcastTXT(const String&) {}
+
+// The tests call update() every tick, so wake-ups need no bookkeeping
+void eventLoopWakeAt(unsigned long) {}
+
+IdleState::IdleState() {}
+void IdleState::enter() {}
+void IdleState::update() {}
+void IdleState::exit() {}
+const char* IdleState::getName() const { return "IDLE"; }
+
+HomingState::HomingState() : _homingController(nullptr), _isHoming(false), _homingComplete(false), _homingSuccess(false) {}
+HomingState::~HomingState() {}
+void HomingState::enter() {}
+void HomingState::update() {}
+void HomingState::exit() {}
+const char* HomingState::getName() const { return "HOMING"; }
+
+PaintingState::PaintingState() : currentStep(PS_IDLE) {}
+void PaintingState::enter() {}
+void PaintingState::update() {}
+void PaintingState::exit() {}
+const char* PaintingState::getName() const { return "PAINTING"; }
+
+CleaningState::CleaningState() : _isCleaning(false), _cleaningComplete(false), shortMode(false) {}
+void CleaningState::enter() {}
+void CleaningState::update() {}
+void CleaningState::exit() {}
+const char* CleaningState::getName() const { return "CLEANING"; }
+
+PausedState::PausedState() : currentStep(PAUSED_WAITING), resumeRequested(false), pressurizeStartTime(0) {}
+void PausedState::enter() {}
+void PausedState::update() {}
+void PausedState::exit() {}
+const char* PausedState::getName() const { return "PAUSED"; }
+
+//* ************************************************************************
+//* ***************************** PNP STATS ********************************
+//* ************************************************************************
+// Keeps totals per phase so a run can be compared with the benchmark model
+
+static unsigned long phaseTotalUs[PNP_PHASE_COUNT];
+static uint32_t phaseCount[PNP_PHASE_COUNT];
+static uint32_t completedCycles = 0;
+
+void pnpStatsRecord(PnPPhase phase, unsigned long durationUs) {
+    phaseTotalUs[phase] += durationUs;
+    phaseCount[phase]++;
+}
+
+void pnpStatsCycleComplete() {
+    completedCycles++;
+}
+
+void pnpStatsReset() {
+    simPhaseReset();
+}
+
+const char* pnpPhaseName(PnPPhase phase) {
+    static const char* const NAMES[PNP_PHASE_COUNT] = {
+        "wait_sensor", "arrival_latency", "verify_move", "pick", "loaded_travel", "place", "return_travel"
+    };
+    return NAMES[phase];
+}
+
+unsigned long simPhaseTotalUs(PnPPhase phase) {
+    return phaseTotalUs[phase];
+}
+
+uint32_t simPhaseCount(PnPPhase phase) {
+    return phaseCount[phase];
+}
+
+uint32_t simCompletedCycles() {
+    return completedCycles;
+}
+
+void simPhaseReset() {
+    memset(phaseTotalUs, 0, sizeof(phaseTotalUs));
+    memset(phaseCount, 0, sizeof(phaseCount));
+    completedCycles = 0;
+}
@@ -0,0 +1,67 @@
+#ifndef PREFERENCES_H
+#define PREFERENCES_H
+
+#include <Arduino.h>
+#include <map>
+#include <vector>
+
+//* ************************************************************************
+//* ************************* HOST PREFERENCES *****************************
+//* ************************************************************************
+// In-memory NVS for env:native. One store shared by every instance, as on
+// the controller; clear() empties it between tests.
+
+class Preferences {
+public:
+    bool begin(const char*, bool = false) { return true; }
+    void end() {}
+    bool clear() {
+        store().clear();
+        return true;
+    }
+    bool isKey(const char* key) { return store().count(key) != 0; }
+
+    size_t putBytes(const char* key, const void* data, size_t length) {
+        const uint8_t* bytes = (const uint8_t*)data;
+        store()[key].assign(bytes, bytes + length);
+        return length;
+    }
+    size_t getBytesLength(const char* key) { return isKey(key) ? store()[key].size() : 0; }
+    size_t getBytes(const char* key, void* buffer, size_t length) {
+        if (!isKey(key)) {
+            return 0;
+        }
+        const std::vector<uint8_t>& bytes = store()[key];
+        size_t count = min(length, bytes.size());
+        memcpy(buffer, bytes.data(), count);
+        return count;
+    }
+
+    size_t putInt(const char* key, int32_t value) { return putBytes(key, &value, sizeof(value)); }
+    int32_t getInt(const char* key, int32_t defaultValue = 0) { return get(key, defaultValue); }
+    size_t putFloat(const char* key, float value) { return putBytes(key, &value, sizeof(value)); }
+    float getFloat(const char* key, float defaultValue = 0.0f) { return get(key, defaultValue); }
+    size_t putBool(const char* key, bool value) { return putBytes(key, &value, sizeof(value)); }
+    bool getBool(const char* key, bool defaultValue = false) { return get(key, defaultValue); }
+    size_t putString(const char* key, const String& value) { return putBytes(key, value.c_str(), value.length() + 1); }
+    String getString(const char* key, const String& defaultValue = String()) {
+        return isKey(key) ? String((const char*)store()[key].data()) : defaultValue;
+    }
+
+private:
+    static std::map<std::string, std::vector<uint8_t>>& store() {
+        static std::map<std::string, std::vector<uint8_t>> values;
+        return values;
+    }
+
+    template <typename T>
+    T get(const char* key, T defaultValue) {
+        T value = defaultValue;
+        if (getBytesLength(key) == sizeof(T)) {
+            getBytes(key, &value, sizeof(T));
+        }
+        return value;
+    }
+};
+
+#endif // PREFERENCES_H
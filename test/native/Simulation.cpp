@@ -0,0 +1,212 @@
+#include "Simulation.h"
+#include "hardware/CycleSensor.h"
+#include "hardware/cylinder_Functions.h"
+#include "hardware/vacuum_Functions.h"
+
+//* ************************************************************************
+//* **************************** SIMULATION ********************************
+//* ************************************************************************
+
+HardwareSerial Serial;
+
+static FastAccelStepper axes[4];
+FastAccelStepper *stepperX = &axes[0];
+FastAccelStepper *stepperY_Left = &axes[1];
+FastAccelStepper *stepperY_Right = &axes[2];
+FastAccelStepper *stepperZ = &axes[3];
+
+static unsigned long nowUs = 0;
+static std::vector<SimEvent> events;
+static bool gantryRunning = false;
+static bool cylinderDown_ = false;
+
+// Conveyor and cycle sensor
+static std::vector<unsigned long> releaseMs;
+static size_t nextPart = 0;
+static int partsPicked = 0;
+static bool partAtSensor = false;
+static uint32_t arrivalCount = 0;
+static unsigned long lastArrivalUs = 0;
+static bool arrivalLatched = false;
+
+static bool gantryMoving() {
+    return stepperX->isRunning() || stepperY_Left->isRunning();
+}
+
+static void logEvent(SimEventKind kind) {
+    events.push_back({kind, nowUs, stepperX->getCurrentPosition(), stepperY_Left->getCurrentPosition(),
+                      gantryMoving(), 0});
+}
+
+// Next part onto the sensor once it is released and the previous one was picked
+static void feedConveyor() {
+    if (partAtSensor || nextPart >= releaseMs.size() || nowUs < releaseMs[nextPart] * 1000UL) {
+        return;
+    }
+    nextPart++;
+    partAtSensor = true;
+    arrivalCount++;
+    lastArrivalUs = nowUs;
+    arrivalLatched = true;
+}
+
+// Largest X or Y travel of the gantry since each cylinder event, while that stroke lasts
+static void trackStrokes() {
+    for (size_t i = events.size(); i-- > 0;) {
+        SimEvent& event = events[i];
+        if (event.kind != SIM_CYLINDER_DOWN && event.kind != SIM_CYLINDER_UP) {
+            continue;
+        }
+        unsigned long strokeMs = event.kind == SIM_CYLINDER_DOWN ? SIM_CYLINDER_EXTEND_MS : SIM_CYLINDER_RETRACT_MS;
+        if (nowUs - event.timeUs > strokeMs * 1000UL) {
+            break; // Older strokes ended before this one started
+        }
+        long travel = max(labs(stepperX->getCurrentPosition() - event.x), labs(stepperY_Left->getCurrentPosition() - event.y));
+        event.strokeTravel = max(event.strokeTravel, travel);
+    }
+}
+
+void simReset() {
+    for (FastAccelStepper& axis : axes) {
+        axis = FastAccelStepper();
+    }
+    nowUs = 0;
+    events.clear();
+    gantryRunning = false;
+    cylinderDown_ = false;
+    releaseMs.clear();
+    nextPart = 0;
+    partsPicked = 0;
+    partAtSensor = false;
+    arrivalCount = 0;
+    lastArrivalUs = 0;
+    arrivalLatched = false;
+    simPhaseReset();
+}
+
+void simAdvanceUs(unsigned long us) {
+    while (us > 0) {
+        unsigned long tick = min(us, SIM_TICK_US);
+        us -= tick;
+
+        // A move started by the firmware since the last tick begins now
+        if (!gantryRunning && gantryMoving()) {
+            gantryRunning = true;
+            logEvent(SIM_GANTRY_START);
+        }
+        for (FastAccelStepper& axis : axes) {
+            axis.simStep(tick / 1000000.0);
+        }
+        nowUs += tick;
+        if (gantryRunning && !gantryMoving()) {
+            gantryRunning = false;
+            logEvent(SIM_GANTRY_STOP);
+        }
+        trackStrokes();
+        feedConveyor();
+    }
+}
+
+unsigned long simNowUs() {
+    return nowUs;
+}
+
+const std::vector<SimEvent>& simEvents() {
+    return events;
+}
+
+void simAddPart(unsigned long release) {
+    releaseMs.push_back(release);
+    feedConveyor();
+}
+
+void simAddParts(int count, unsigned long intervalMs, unsigned long firstMs) {
+    for (int i = 0; i < count; ++i) {
+        simAddPart(firstMs + i * intervalMs);
+    }
+}
+
+int simPartsPicked() {
+    return partsPicked;
+}
+
+bool simPartAtSensor() {
+    return partAtSensor;
+}
+
+//* ************************************************************************
+//* *************************** ARDUINO CORE *******************************
+//* ************************************************************************
+
+unsigned long millis() {
+    return nowUs / 1000UL;
+}
+
+unsigned long micros() {
+    return nowUs;
+}
+
+void delay(unsigned long ms) {
+    simAdvanceUs(ms * 1000UL);
+}
+
+void pinMode(uint8_t, uint8_t) {}
+void digitalWrite(uint8_t, uint8_t) {}
+int digitalRead(uint8_t) { return HIGH; }
+
+//* ************************************************************************
+//* ***************************** ACTUATORS ********************************
+//* ************************************************************************
+
+void cylinderDown() {
+    cylinderDown_ = true;
+    logEvent(SIM_CYLINDER_DOWN);
+}
+
+void cylinderUp() {
+    cylinderDown_ = false;
+    logEvent(SIM_CYLINDER_UP);
+}
+
+// The cup lifts the part off the sensor when it is down at the pick location
+void vacuumOn() {
+    logEvent(SIM_VACUUM_ON);
+    bool atPick = stepperX->getCurrentPosition() == (long)(PICK_LOCATION_X * STEPS_PER_INCH_XYZ) &&
+                  stepperY_Left->getCurrentPosition() == (long)(PICK_LOCATION_Y * STEPS_PER_INCH_XYZ);
+    if (cylinderDown_ && atPick && partAtSensor) {
+        partAtSensor = false;
+        partsPicked++;
+        feedConveyor();
+    }
+}
+
+void vacuumOff() {
+    logEvent(SIM_VACUUM_OFF);
+}
+
+//* ************************************************************************
+//* *************************** CYCLE SENSOR *******************************
+//* ************************************************************************
+
+void initializeCycleSensor() {}
+
+bool cycleSensorActive() {
+    return partAtSensor;
+}
+
+bool cycleSensorConsumeArrival() {
+    bool latched = arrivalLatched;
+    arrivalLatched = false;
+    return latched;
+}
+
+unsigned long cycleSensorLastArrivalUs() {
+    return lastArrivalUs;
+}
+
+uint32_t cycleSensorArrivalCount(unsigned long* arrivalUs) {
+    if (arrivalUs) {
+        *arrivalUs = lastArrivalUs;
+    }
+    return arrivalCount;
+}
@@ -0,0 +1,77 @@
+#ifndef SIMULATION_H
+#define SIMULATION_H
+
+#include <Arduino.h>
+#include <FastAccelStepper.h>
+#include <vector>
+#include "utils/settings.h"
+#include "system/PnPStats.h"
+
+//* ************************************************************************
+//* **************************** SIMULATION ********************************
+//* ************************************************************************
+// Host model of the PnP cell for env:native tests: a clock, the gantry axes
+// (simulated FastAccelStepper), the cylinder and vacuum outputs, and a
+// scripted cycle sensor fed by a part conveyor.
+//
+// Nothing moves on its own: a test calls the firmware (e.g. the state
+// machine's update()) and then simAdvanceUs() in small ticks, like the loop
+// task between passes.
+//
+// The cylinder takes as long to stroke as the firmware waits for it
+// (SIM_CYLINDER_EXTEND_MS / SIM_CYLINDER_RETRACT_MS). Each cylinder event
+// records how far the gantry moved during that stroke, so the overlap of
+// actuation with travel can be checked.
+
+const unsigned long SIM_TICK_US = 100;
+const unsigned long SIM_CYLINDER_EXTEND_MS = PNP_PICK_DELAY_AFTER_CYLINDER_EXTEND;
+const unsigned long SIM_CYLINDER_RETRACT_MS = PNP_PICK_DELAY_AFTER_CYLINDER_RETRACT;
+
+enum SimEventKind {
+    SIM_CYLINDER_DOWN,
+    SIM_CYLINDER_UP,
+    SIM_VACUUM_ON,
+    SIM_VACUUM_OFF,
+    SIM_GANTRY_START,   // X or Y starts moving
+    SIM_GANTRY_STOP     // Both X and Y stopped
+};
+
+struct SimEvent {
+    SimEventKind kind;
+    unsigned long timeUs;
+    long x;                 // Gantry position at the event (steps)
+    long y;
+    bool moving;            // Gantry moving at the event
+    long strokeTravel;      // Cylinder events: largest X or Y travel during the stroke (steps)
+};
+
+// Clock to 0, axes at 0 and idle, outputs off, no parts, event log empty
+void simReset();
+
+// Moves the axes, the cylinder and the conveyor forward by 'us'
+void simAdvanceUs(unsigned long us);
+unsigned long simNowUs();
+
+const std::vector<SimEvent>& simEvents();
+
+// Gantry axes, as declared by the firmware
+extern FastAccelStepper *stepperX;
+extern FastAccelStepper *stepperY_Left;
+extern FastAccelStepper *stepperY_Right;
+extern FastAccelStepper *stepperZ;
+
+// Conveyor: parts are released in call order at 'releaseMs' and each
+// reaches the cycle sensor once the previous one has been picked (vacuum on
+// with the cylinder down at the pick location)
+void simAddPart(unsigned long releaseMs);
+void simAddParts(int count, unsigned long intervalMs, unsigned long firstMs = 0); // firstMs, + interval...
+int simPartsPicked();
+bool simPartAtSensor();
+
+// PnP statistics as recorded by the firmware (PnPStats test double)
+unsigned long simPhaseTotalUs(PnPPhase phase);
+uint32_t simPhaseCount(PnPPhase phase);
+uint32_t simCompletedCycles();
+void simPhaseReset();
+
+#endif // SIMULATION_H
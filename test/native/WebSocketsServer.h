@@ -0,0 +1,13 @@
+#ifndef WEBSOCKETS_SERVER_H
+#define WEBSOCKETS_SERVER_H
+
+#include <Arduino.h>
+
+// Host stand-in: dashboard output goes through webBroadcastTXT(), which the
+// test doubles discard
+class WebSocketsServer {
+public:
+    explicit WebSocketsServer(uint16_t) {}
+};
+
+#endif // WEBSOCKETS_SERVER_H
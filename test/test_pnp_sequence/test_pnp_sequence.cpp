@@ -0,0 +1,333 @@
+#include <unity.h>
+#include <vector>
+#include "Simulation.h"
+#include "system/StateMachine.h"
+#include "system/PnPTiming.h"
+#include "storage/TrayLayouts.h"
+#include "storage/Persistence.h"
+
+//* ************************************************************************
+//* ************************* PNP TRAY SEQUENCE ****************************
+//* ************************************************************************
+// Runs PnPState through whole trays on the simulated cell (see
+// test/native/Simulation.h): the real state machine, sub-step machine,
+// placement plan and overlap timing, against simulated steppers and a
+// scripted cycle sensor.
+//
+//   pio test -e native
+
+const unsigned long TRAY_TIMEOUT_MS = 120000;
+const unsigned long SUB_STEP_SLACK_US = 1000 + SIM_TICK_US; // Deadlines are whole millis(), seen once per tick
+const float PHASE_TOLERANCE_MS = 3.0f;                      // Per cycle, simulated motion vs the profile model
+// Travel allowed during an overlapped stroke, plus one tick of travel
+const long PICK_OVERLAP_STEPS = (long)ceilf(PNP_PICK_RETRACT_OVERLAP_INCHES * STEPS_PER_INCH_XYZ) + 1;
+const long PLACE_OVERLAP_STEPS = (long)ceilf(PNP_PLACE_EXTEND_OVERLAP_INCHES * STEPS_PER_INCH_XYZ) + 1;
+
+static StateMachine* machine = nullptr;
+static const long PICK_X = (long)(PICK_LOCATION_X * STEPS_PER_INCH_XYZ);
+static const long PICK_Y = (long)(PICK_LOCATION_Y * STEPS_PER_INCH_XYZ);
+
+// One pick and place, as seen by the simulated outputs
+struct Cycle {
+    SimEvent pickExtend;
+    SimEvent pickVacuum;
+    SimEvent pickRetract;
+    SimEvent loadedStart;
+    SimEvent loadedStop;
+    SimEvent placeExtend;
+    SimEvent placeRelease;
+    SimEvent placeRetract;
+    SimEvent returnStart;
+    SimEvent returnStop;
+};
+
+void setUp() {
+    simReset();
+    persistence.clearAll();
+    trayLayouts.begin();
+    machine = new StateMachine();
+    machine->requestTransition(STATE_PNP); // Entered on the first update, from 0,0
+}
+
+void tearDown() {
+    delete machine;
+    machine = nullptr;
+}
+
+// Loop task: one state machine pass per tick until 'done' or the timeout
+template <typename Done>
+static bool runUntil(Done done, unsigned long timeoutMs) {
+    unsigned long limitUs = simNowUs() + timeoutMs * 1000UL;
+    while (simNowUs() < limitUs) {
+        machine->update();
+        if (done()) {
+            return true;
+        }
+        simAdvanceUs(SIM_TICK_US);
+    }
+    return false;
+}
+
+// PnP hands over to Homing once the tray is done
+static bool runTray() {
+    return runUntil([] { return machine->getCurrentStateId() == STATE_HOMING; }, TRAY_TIMEOUT_MS);
+}
+
+static bool runToPickLocation() {
+    return runUntil([] {
+        const std::vector<SimEvent>& events = simEvents();
+        return !events.empty() && events.back().kind == SIM_GANTRY_STOP;
+    }, TRAY_TIMEOUT_MS);
+}
+
+static size_t lastIndexOf(SimEventKind kind) {
+    const std::vector<SimEvent>& events = simEvents();
+    for (size_t i = events.size(); i-- > 0;) {
+        if (events[i].kind == kind) {
+            return i;
+        }
+    }
+    return 0;
+}
+
+static size_t findNext(SimEventKind kind, size_t from) {
+    const std::vector<SimEvent>& events = simEvents();
+    while (from < events.size() && events[from].kind != kind) {
+        from++;
+    }
+    TEST_ASSERT_LESS_THAN_MESSAGE(events.size(), from, "Expected event missing");
+    return from;
+}
+
+static size_t findPrevious(SimEventKind kind, size_t before) {
+    const std::vector<SimEvent>& events = simEvents();
+    while (before > 0 && events[before - 1].kind != kind) {
+        before--;
+    }
+    TEST_ASSERT_GREATER_THAN_MESSAGE(0, before, "Expected event missing");
+    return before - 1;
+}
+
+// Every vacuum-on starts a cycle; the other events are found around it
+static std::vector<Cycle> collectCycles() {
+    const std::vector<SimEvent>& events = simEvents();
+    std::vector<Cycle> cycles;
+    for (size_t i = 0; i < events.size(); ++i) {
+        if (events[i].kind != SIM_VACUUM_ON) {
+            continue;
+        }
+        size_t release = findNext(SIM_VACUUM_OFF, i);
+        size_t placeRetract = findNext(SIM_CYLINDER_UP, release);
+        size_t returnStart = findNext(SIM_GANTRY_START, placeRetract);
+        Cycle cycle;
+        cycle.pickExtend = events[findPrevious(SIM_CYLINDER_DOWN, i)];
+        cycle.pickVacuum = events[i];
+        cycle.pickRetract = events[findNext(SIM_CYLINDER_UP, i)];
+        cycle.loadedStart = events[findNext(SIM_GANTRY_START, i)];
+        cycle.loadedStop = events[findPrevious(SIM_GANTRY_STOP, release)];
+        cycle.placeExtend = events[findPrevious(SIM_CYLINDER_DOWN, release)];
+        cycle.placeRelease = events[release];
+        cycle.placeRetract = events[placeRetract];
+        cycle.returnStart = events[returnStart];
+        cycle.returnStop = events[findNext(SIM_GANTRY_STOP, returnStart)];
+        cycles.push_back(cycle);
+    }
+    return cycles;
+}
+
+static int plannedOrder(int* order) {
+    float travelSeconds;
+    return pnpPlanPlacementOrder(PICK_X, PICK_Y, pnpLoadedProfile(), pnpUnloadedProfile(), order, travelSeconds);
+}
+
+static PnPPlaceTiming plannedPlaceMove(int cell, bool finalPlacement) {
+    return pnpPlanPlaceMove(trayLayouts.cellXSteps(cell) - PICK_X, trayLayouts.cellYSteps(cell) - PICK_Y,
+                            pnpLoadedProfile(), finalPlacement);
+}
+
+static void assertGapUs(unsigned long from, unsigned long to, unsigned long expectedMs, const char* message) {
+    TEST_ASSERT_GREATER_OR_EQUAL_UINT32_MESSAGE(expectedMs * 1000UL - SUB_STEP_SLACK_US, to - from, message);
+    TEST_ASSERT_LESS_OR_EQUAL_UINT32_MESSAGE(expectedMs * 1000UL + SUB_STEP_SLACK_US, to - from, message);
+}
+
+// A tray with a part always waiting: every placement cell filled, in plan order
+static void assertFullTray() {
+    int order[MAX_TRAY_CELLS];
+    int count = plannedOrder(order);
+    TEST_ASSERT_GREATER_THAN(0, count);
+    simAddParts(count, 0);
+
+    TEST_ASSERT_TRUE_MESSAGE(runTray(), "Tray did not finish");
+    std::vector<Cycle> cycles = collectCycles();
+    TEST_ASSERT_EQUAL_INT(count, (int)cycles.size());
+    TEST_ASSERT_EQUAL_INT(count, simPartsPicked());
+    TEST_ASSERT_EQUAL_UINT32(count, simCompletedCycles());
+    for (int i = 0; i < count; ++i) {
+        TEST_ASSERT_EQUAL_INT32(PICK_X, cycles[i].pickVacuum.x);
+        TEST_ASSERT_EQUAL_INT32(PICK_Y, cycles[i].pickVacuum.y);
+        TEST_ASSERT_EQUAL_INT32(trayLayouts.cellXSteps(order[i]), cycles[i].placeRelease.x);
+        TEST_ASSERT_EQUAL_INT32(trayLayouts.cellYSteps(order[i]), cycles[i].placeRelease.y);
+    }
+    TEST_ASSERT_EQUAL_INT32(PICK_X, stepperX->getCurrentPosition());
+    TEST_ASSERT_EQUAL_INT32(PICK_Y, stepperY_Left->getCurrentPosition());
+    TEST_ASSERT_EQUAL_INT32(PICK_Y, stepperY_Right->getCurrentPosition());
+    TEST_ASSERT_EQUAL_HEX32(trayLayouts.active().placementMask, trayLayouts.occupiedCells());
+}
+
+void test_default_tray_fills_every_cell_in_plan_order() {
+    assertFullTray();
+}
+
+void test_custom_layout_fills_every_cell_in_plan_order() {
+    TrayLayout layout = {};
+    strncpy(layout.name, "Test 3x2", TRAY_LAYOUT_NAME_LEN - 1);
+    layout.cols = 3;
+    layout.rows = 2;
+    layout.originX = 20.0f;
+    layout.originY = 20.0f;
+    layout.pitchX = 4.0f;
+    layout.pitchY = 6.0f;
+    layout.placementMask = 0x3F;
+    TEST_ASSERT_TRUE(trayLayouts.saveLayout(1, layout));
+    TEST_ASSERT_TRUE(trayLayouts.select(1));
+    assertFullTray();
+}
+
+// Each sub-step waits out its actuator delay and no longer
+void test_sub_steps_wait_for_each_actuator() {
+    int order[MAX_TRAY_CELLS];
+    int count = plannedOrder(order);
+    simAddParts(count, 0);
+    TEST_ASSERT_TRUE(runTray());
+
+    std::vector<Cycle> cycles = collectCycles();
+    TEST_ASSERT_EQUAL_INT(count, (int)cycles.size());
+    for (int i = 0; i < count; ++i) {
+        const Cycle& cycle = cycles[i];
+        PnPPlaceTiming timing = plannedPlaceMove(order[i], i + 1 == count);
+        assertGapUs(cycle.pickExtend.timeUs, cycle.pickVacuum.timeUs, PNP_PICK_DELAY_AFTER_CYLINDER_EXTEND,
+                    "Pick extend");
+        assertGapUs(cycle.pickVacuum.timeUs, cycle.pickRetract.timeUs,
+                    PNP_PICK_DELAY_AFTER_VACUUM_ON + PNP_PICK_VACUUM_SETTLE_MS, "Pick vacuum");
+        assertGapUs(cycle.pickRetract.timeUs, cycle.loadedStart.timeUs,
+                    PNP_PICK_DELAY_AFTER_CYLINDER_RETRACT - timing.retractOverlapMs, "Pick retract");
+        assertGapUs(cycle.placeExtend.timeUs, cycle.placeRelease.timeUs, PNP_PLACE_DELAY_AFTER_CYLINDER_EXTEND,
+                    "Place extend");
+        assertGapUs(cycle.placeRelease.timeUs, cycle.placeRetract.timeUs, PNP_PLACE_DELAY_AFTER_VACUUM_OFF,
+                    "Place release");
+        assertGapUs(cycle.placeRetract.timeUs, cycle.returnStart.timeUs, PNP_PLACE_DELAY_AFTER_CYLINDER_RETRACT,
+                    "Place retract");
+        TEST_ASSERT_FALSE(cycle.pickExtend.moving);
+        TEST_ASSERT_FALSE(cycle.placeRetract.moving);
+    }
+}
+
+// The pick retract and the place extend overlap travel, but the gantry moves
+// no more than the allowed distance while the cylinder is not fully up
+void test_actuation_overlaps_travel_within_limits() {
+    TEST_ASSERT_TRUE(PNP_OVERLAP_ENABLED);
+    int order[MAX_TRAY_CELLS];
+    int count = plannedOrder(order);
+    simAddParts(count, 0);
+    TEST_ASSERT_TRUE(runTray());
+
+    std::vector<Cycle> cycles = collectCycles();
+    TEST_ASSERT_EQUAL_INT(count, (int)cycles.size());
+    for (int i = 0; i < count; ++i) {
+        const Cycle& cycle = cycles[i];
+        PnPPlaceTiming timing = plannedPlaceMove(order[i], i + 1 == count);
+        TEST_ASSERT_GREATER_THAN(0, timing.retractOverlapMs);
+        TEST_ASSERT_GREATER_THAN(0, timing.extendLeadMs);
+
+        // Travel starts while the cylinder is still retracting at pick
+        TEST_ASSERT_LESS_THAN_UINT32(cycle.pickRetract.timeUs + SIM_CYLINDER_RETRACT_MS * 1000UL, cycle.loadedStart.timeUs);
+        TEST_ASSERT_GREATER_THAN(0, cycle.pickRetract.strokeTravel);
+        TEST_ASSERT_LESS_OR_EQUAL(PICK_OVERLAP_STEPS, cycle.pickRetract.strokeTravel);
+
+        // The place extend starts before the gantry has stopped
+        TEST_ASSERT_TRUE(cycle.placeExtend.moving);
+        TEST_ASSERT_LESS_THAN_UINT32(cycle.loadedStop.timeUs, cycle.placeExtend.timeUs);
+        TEST_ASSERT_LESS_OR_EQUAL(PLACE_OVERLAP_STEPS, cycle.placeExtend.strokeTravel);
+
+        // No overlap at the other strokes
+        TEST_ASSERT_EQUAL_INT32(0, cycle.pickExtend.strokeTravel);
+        TEST_ASSERT_EQUAL_INT32(0, cycle.placeRetract.strokeTravel);
+    }
+}
+
+// The recorded phases match the benchmark's replay of the same tray
+static void assertMatchesBenchmark(unsigned long partIntervalMs) {
+    TEST_ASSERT_TRUE(runToPickLocation());
+    simPhaseReset();
+    unsigned long startUs = simNowUs();
+    int order[MAX_TRAY_CELLS];
+    int count = plannedOrder(order);
+    simAddParts(count, partIntervalMs, millis());
+    TEST_ASSERT_TRUE(runTray());
+
+    PnPBenchmarkConfig config = {pnpLoadedProfile(), pnpUnloadedProfile(), partIntervalMs};
+    PnPBenchmarkResult result;
+    pnpBenchmarkRun(config, result);
+    TEST_ASSERT_EQUAL_INT(count, result.parts);
+
+    float tolerance = count * PHASE_TOLERANCE_MS;
+    const PnPPhase phases[] = {PNP_PHASE_WAIT_SENSOR, PNP_PHASE_PICK, PNP_PHASE_LOADED_TRAVEL,
+                               PNP_PHASE_PLACE, PNP_PHASE_RETURN_TRAVEL};
+    for (PnPPhase phase : phases) {
+        TEST_ASSERT_FLOAT_WITHIN_MESSAGE(tolerance, result.phaseMs[phase], simPhaseTotalUs(phase) / 1000.0f,
+                                         pnpPhaseName(phase));
+    }
+    if (partIntervalMs > 0) {
+        TEST_ASSERT_FLOAT_WITHIN(tolerance, result.phaseMs[PNP_PHASE_ARRIVAL_LATENCY],
+                                 simPhaseTotalUs(PNP_PHASE_ARRIVAL_LATENCY) / 1000.0f);
+    }
+
+    std::vector<Cycle> cycles = collectCycles();
+    TEST_ASSERT_EQUAL_INT(count, (int)cycles.size());
+    TEST_ASSERT_FLOAT_WITHIN(tolerance, result.totalMs, (cycles.back().returnStop.timeUs - startUs) / 1000.0f);
+}
+
+void test_cycle_time_matches_benchmark_with_parts_waiting() {
+    assertMatchesBenchmark(0);
+}
+
+void test_cycle_time_matches_benchmark_with_paced_parts() {
+    assertMatchesBenchmark(3000);
+}
+
+// A part that reaches the sensor during the return move is picked as soon as
+// the gantry is back, without a wait
+void test_part_arriving_during_return_is_picked_on_arrival() {
+    simAddParts(1, 0);
+    TEST_ASSERT_TRUE(runUntil([] {
+        // Placed and moving again: the return move
+        return simPartsPicked() == 1 && simEvents().back().kind == SIM_GANTRY_START &&
+               lastIndexOf(SIM_VACUUM_OFF) > lastIndexOf(SIM_VACUUM_ON);
+    }, TRAY_TIMEOUT_MS));
+    unsigned long releaseMs = millis() + 20;
+    unsigned long arrivalUs = releaseMs * 1000UL;
+    simAddPart(releaseMs);
+    unsigned long waitBeforeUs = simPhaseTotalUs(PNP_PHASE_WAIT_SENSOR);
+    unsigned long latencyBeforeUs = simPhaseTotalUs(PNP_PHASE_ARRIVAL_LATENCY);
+
+    TEST_ASSERT_TRUE(runUntil([] { return simCompletedCycles() == 2; }, TRAY_TIMEOUT_MS));
+    std::vector<Cycle> cycles = collectCycles();
+    TEST_ASSERT_EQUAL_INT(2, (int)cycles.size());
+    TEST_ASSERT_LESS_THAN_UINT32(cycles[0].returnStop.timeUs, arrivalUs);
+    TEST_ASSERT_LESS_OR_EQUAL_UINT32(cycles[0].returnStop.timeUs + SIM_TICK_US, cycles[1].pickExtend.timeUs);
+    TEST_ASSERT_LESS_OR_EQUAL_UINT32(SIM_TICK_US, simPhaseTotalUs(PNP_PHASE_WAIT_SENSOR) - waitBeforeUs);
+    TEST_ASSERT_UINT32_WITHIN(SIM_TICK_US, cycles[0].returnStop.timeUs - arrivalUs,
+                              simPhaseTotalUs(PNP_PHASE_ARRIVAL_LATENCY) - latencyBeforeUs);
+}
+
+int main(int argc, char** argv) {
+    UNITY_BEGIN();
+    RUN_TEST(test_default_tray_fills_every_cell_in_plan_order);
+    RUN_TEST(test_custom_layout_fills_every_cell_in_plan_order);
+    RUN_TEST(test_sub_steps_wait_for_each_actuator);
+    RUN_TEST(test_actuation_overlaps_travel_within_limits);
+    RUN_TEST(test_cycle_time_matches_benchmark_with_parts_waiting);
+    RUN_TEST(test_cycle_time_matches_benchmark_with_paced_parts);
+    RUN_TEST(test_part_arriving_during_return_is_picked_on_arrival);
+    return UNITY_END();
+}